@@ -0,0 +1,117 @@
+#include <scorum/app/api_snapshot.hpp>
+
+#include <scorum/chain/database/database.hpp>
+
+#include <scorum/chain/services/budgets.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
+#include <scorum/chain/services/hardfork_property.hpp>
+#include <scorum/chain/services/registration_pool.hpp>
+#include <scorum/chain/services/reward_balancer.hpp>
+#include <scorum/chain/services/reward_funds.hpp>
+
+#include <scorum/chain/schema/budget_objects.hpp>
+#include <scorum/chain/schema/registration_objects.hpp>
+#include <scorum/chain/schema/reward_balancer_objects.hpp>
+#include <scorum/chain/schema/scorum_objects.hpp>
+
+namespace scorum {
+namespace app {
+
+using namespace scorum::chain;
+
+std::shared_ptr<const api_snapshot> make_api_snapshot(chain::database& db)
+{
+    auto snapshot = std::make_shared<api_snapshot>();
+
+    snapshot->dynamic_global_properties = make_dynamic_global_property_api_obj(db);
+    snapshot->chain_properties = make_chain_properties_api_obj(db);
+    snapshot->witness_schedule = db.get(witness_schedule_id_type());
+    snapshot->next_scheduled_hardfork = make_scheduled_hardfork_api_obj(db);
+
+    return snapshot;
+}
+
+dynamic_global_property_api_obj make_dynamic_global_property_api_obj(chain::database& db)
+{
+    dynamic_global_property_api_obj gpao;
+    gpao = db.obtain_service<dbs_dynamic_global_property>().get();
+
+    if (db.has_index<witness::reserve_ratio_index>())
+    {
+        const auto& r = db.find(witness::reserve_ratio_id_type());
+
+        if (BOOST_LIKELY(r != nullptr))
+        {
+            gpao = *r;
+        }
+    }
+
+    if (db.obtain_service<dbs_registration_pool>().is_exists())
+    {
+        gpao.registration_pool_balance = db.obtain_service<dbs_registration_pool>().get().balance;
+    }
+
+    if (db.obtain_service<dbs_fund_budget>().is_exists())
+    {
+        gpao.fund_budget_balance = db.obtain_service<dbs_fund_budget>().get().balance;
+    }
+
+    if (db.obtain_service<dbs_fund_budget>().is_exists())
+    {
+        gpao.reward_pool_balance = db.obtain_service<dbs_content_reward_scr>().get().balance;
+    }
+
+    if (db.obtain_service<dbs_content_reward_fund_scr>().is_exists())
+    {
+        gpao.content_reward_scr_balance
+            = db.obtain_service<dbs_content_reward_fund_scr>().get().activity_reward_balance;
+    }
+
+    if (db.obtain_service<dbs_content_reward_fund_scr>().is_exists())
+    {
+        gpao.content_reward_sp_balance = db.obtain_service<dbs_content_reward_fund_sp>().get().activity_reward_balance;
+    }
+
+    return gpao;
+}
+
+chain_properties_api_obj make_chain_properties_api_obj(chain::database& db)
+{
+    chain_properties_api_obj ret_val;
+
+    if (db.has_index<witness::reserve_ratio_index>())
+    {
+        const auto& r = db.find(witness::reserve_ratio_id_type());
+
+        if (BOOST_LIKELY(r != nullptr))
+        {
+            ret_val = *r;
+        }
+    }
+
+    const dynamic_global_property_object& dpo = db.obtain_service<dbs_dynamic_global_property>().get();
+
+    ret_val.head_block_id = dpo.head_block_id;
+    ret_val.head_block_number = dpo.head_block_number;
+    ret_val.last_irreversible_block_number = dpo.last_irreversible_block_num;
+    ret_val.current_aslot = dpo.current_aslot;
+    ret_val.time = dpo.time;
+    ret_val.current_witness = dpo.current_witness;
+    ret_val.majority_version = dpo.majority_version;
+    ret_val.median_chain_props = dpo.median_chain_props;
+    ret_val.chain_id = db.get_chain_id();
+    ret_val.hf_version = db.obtain_service<dbs_hardfork_property>().get().current_hardfork_version;
+
+    return ret_val;
+}
+
+scheduled_hardfork_api_obj make_scheduled_hardfork_api_obj(chain::database& db)
+{
+    scheduled_hardfork_api_obj shf;
+    const auto& hpo = db.obtain_service<dbs_hardfork_property>().get();
+    shf.hf_version = hpo.next_hardfork;
+    shf.live_time = hpo.next_hardfork_time;
+    return shf;
+}
+}
+}
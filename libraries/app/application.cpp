@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #include <scorum/app/api.hpp>
+#include <scorum/app/api_snapshot.hpp>
 #include <scorum/app/database_api.hpp>
 #include <scorum/app/chain_api.hpp>
 #include <scorum/app/advertising_api.hpp>
@@ -67,6 +68,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <set>
 
 #include <fc/log/file_appender.hpp>
@@ -283,6 +285,10 @@ public:
         : _self(self)
         , _chain_db(std::move(chain_db))
     {
+        _applied_block_connection
+            = _chain_db->applied_block.connect([&](const signed_block&) { publish_api_snapshot(); });
+        _popped_block_connection
+            = _chain_db->popped_block.connect([&](const signed_block&) { publish_api_snapshot(); });
     }
 
     ~application_impl()
@@ -348,6 +354,9 @@ public:
                 _chain_db->set_require_locking(true);
             }
 
+            _chain_db->get_comment_content_store().set_cache_size(
+                _options->at("comment-content-cache-size").as<uint32_t>());
+
             if (_options->count("shared-file-dir"))
             {
                 _shared_dir = fc::path(_options->at("shared-file-dir").as<boost::filesystem::path>());
@@ -372,6 +381,13 @@ public:
                 }
 
                 _chain_db->set_flush_interval(_options->at("flush").as<uint32_t>());
+                _chain_db->set_invariants_audit_interval(_options->at("invariants-audit-interval").as<uint32_t>());
+                _chain_db->set_shared_file_growth(
+                    fc::parse_size(_options->at("shared-file-full-threshold").as<std::string>()),
+                    fc::parse_size(_options->at("shared-file-grow-step").as<std::string>()));
+                _chain_db->set_pending_transactions_priority(
+                    fc::variant(_options->at("pending-transactions-priority").as<std::string>())
+                        .as<chain::pending_transactions_pool::priority_type>());
 
                 flat_map<uint32_t, block_id_type> loaded_checkpoints;
                 if (_options->count("checkpoint"))
@@ -386,7 +402,16 @@ public:
                 }
                 _chain_db->add_checkpoints(loaded_checkpoints);
 
-                if (_options->count("replay-blockchain") && !_options->count("resync-blockchain"))
+                if (_options->count("import-state-snapshot") && !_options->count("resync-blockchain"))
+                {
+                    ilog("Importing state snapshot on user request.");
+
+                    auto snapshot_file = _options->at("import-state-snapshot").as<boost::filesystem::path>();
+
+                    _chain_db->import_state_snapshot(snapshot_file, block_log_dir, _shared_dir, _shared_file_size,
+                                                     genesis_state);
+                }
+                else if (_options->count("replay-blockchain") && !_options->count("resync-blockchain"))
                 {
                     ilog("Replaying blockchain on user request.");
 
@@ -402,6 +427,15 @@ public:
                                     genesis_state);
                 }
 
+                if (_options->count("export-state-snapshot"))
+                {
+                    // the state is at the last irreversible block right after opening
+                    _chain_db->export_state_snapshot(
+                        _options->at("export-state-snapshot").as<boost::filesystem::path>());
+                }
+
+                _chain_db->with_read_lock([&]() { publish_api_snapshot(); });
+
                 if (_options->count("force-validate"))
                 {
                     ilog("All transaction signatures will be validated");
@@ -568,24 +602,24 @@ public:
                 if (sync_mode)
                     fc_ilog(fc::logger::get("sync"),
                             "chain pushing sync block #${block_num} ${block_hash}, head is ${head}",
-                            ("block_num", blk_msg.block.block_num())("block_hash", blk_msg.block_id)("head",
+                            ("block_num", blk_msg.block->block_num())("block_hash", blk_msg.block_id)("head",
                                                                                                      head_block_num));
                 else
                     fc_ilog(fc::logger::get("sync"), "chain pushing block #${block_num} ${block_hash}, head is ${head}",
-                            ("block_num", blk_msg.block.block_num())("block_hash", blk_msg.block_id)("head",
+                            ("block_num", blk_msg.block->block_num())("block_hash", blk_msg.block_id)("head",
                                                                                                      head_block_num));
 
-                if (sync_mode && blk_msg.block.block_num() % 10000 == 0)
+                if (sync_mode && blk_msg.block->block_num() % 10000 == 0)
                 {
                     ilog("Syncing Blockchain --- Got block: #${n} time: ${t}",
-                         ("t", blk_msg.block.timestamp)("n", blk_msg.block.block_num()));
+                         ("t", blk_msg.block->timestamp)("n", blk_msg.block->block_num()));
                 }
 
                 time_point_sec now = fc::time_point::now();
 
                 uint64_t max_accept_time = now.sec_since_epoch();
                 max_accept_time += allow_future_time;
-                FC_ASSERT(blk_msg.block.timestamp.sec_since_epoch() <= max_accept_time);
+                FC_ASSERT(blk_msg.block->timestamp.sec_since_epoch() <= max_accept_time);
 
                 try
                 {
@@ -593,21 +627,14 @@ public:
                     // you can help the network code out by throwing a block_older_than_undo_history exception.
                     // when the net code sees that, it will stop trying to push blocks from that chain, but
                     // leave that peer connected so that they can get sync blocks from us
-                    uint32_t skip_flags = (_is_block_producer | _force_validate)
-                        ? database::skip_nothing
-                        : database::skip_transaction_signatures;
-                    if (sync_mode)
-                    {
-                        skip_flags |= database::skip_validate_invariants;
-                    }
-                    bool result = _chain_db->push_block(blk_msg.block, skip_flags);
+                    bool result = _chain_db->push_block(blk_msg.block, get_push_block_skip_flags(sync_mode));
 
                     if (!sync_mode)
                     {
-                        fc::microseconds latency = fc::time_point::now() - blk_msg.block.timestamp;
+                        fc::microseconds latency = fc::time_point::now() - blk_msg.block->timestamp;
                         ilog("Got ${t} transactions on block ${b} by ${w} -- latency: ${l} ms",
-                             ("t", blk_msg.block.transactions.size())("b", blk_msg.block.block_num())(
-                                 "w", blk_msg.block.witness)("l", latency.count() / 1000));
+                             ("t", blk_msg.block->transactions.size())("b", blk_msg.block->block_num())(
+                                 "w", blk_msg.block->witness)("l", latency.count() / 1000));
                     }
 
                     return result;
@@ -634,6 +661,24 @@ public:
         FC_CAPTURE_AND_RETHROW((blk_msg)(sync_mode))
     }
 
+    virtual void prevalidate_block(const graphene::net::block_message& blk_msg) override
+    {
+        // the keys are recovered on the workers of the database, push_block finds them in the cache
+        if (_running)
+            _chain_db->prevalidate_block(blk_msg.block, get_push_block_skip_flags(true));
+    }
+
+    uint32_t get_push_block_skip_flags(bool sync_mode) const
+    {
+        uint32_t skip_flags
+            = (_is_block_producer | _force_validate) ? database::skip_nothing : database::skip_transaction_signatures;
+        if (sync_mode)
+        {
+            skip_flags |= database::skip_validate_invariants;
+        }
+        return skip_flags;
+    }
+
     virtual void handle_transaction(const graphene::net::trx_message& transaction_message) override
     {
         try
@@ -1075,6 +1120,12 @@ public:
         return ret->template as<API>();
     }
 
+    // called by the block applying thread under the write lock
+    void publish_api_snapshot()
+    {
+        std::atomic_store(&_api_snapshot, make_api_snapshot(*_chain_db));
+    }
+
     application* _self;
 
     fc::path _data_dir;
@@ -1087,6 +1138,10 @@ public:
     std::shared_ptr<fc::http::websocket_server> _websocket_server;
     std::shared_ptr<fc::http::websocket_tls_server> _websocket_tls_server;
 
+    std::shared_ptr<const api_snapshot> _api_snapshot;
+    boost::signals2::scoped_connection _applied_block_connection;
+    boost::signals2::scoped_connection _popped_block_connection;
+
     // These plugins have API that push block to DB.
     // It is not expected for read-only mode
     const plugin_names_type _plugins_locked_in_readonly_mode = { "witness", "debug_node" };
@@ -1174,6 +1229,10 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("data-dir,d", bpo::value<boost::filesystem::path>()->default_value("witness_node_data_dir"), "Directory containing databases, configuration file, etc.")
     ("shared-file-dir", bpo::value<boost::filesystem::path>(), "Location of the shared memory file. Defaults to data_dir/blockchain")
     ("shared-file-size", bpo::value<std::string>()->default_value("54G"), "Size of the shared memory file. Default: 54G")
+    ("shared-file-grow-step", bpo::value<std::string>()->default_value("4G"), "Grow the shared memory file by this size while running when it's full, unless it's opened by read only processes. 0 - never. Default: 4G")
+    ("shared-file-full-threshold", bpo::value<std::string>()->default_value("1G"), "Shared memory file is full when it has less free memory. Default: 1G")
+    ("comment-content-cache-size", bpo::value<uint32_t>()->default_value(10000), "Number of comment contents (title, body and json metadata) cached in memory. Default: 10000")
+    ("pending-transactions-priority", bpo::value<std::string>()->default_value("by_arrival"), "Order of pending transactions to include in the produced blocks: by_arrival, by_expiration or by_size. Default: by_arrival")
     ("rpc-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8090"), "Endpoint for websocket RPC to listen on")
     ("rpc-tls-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8089"), "Endpoint for TLS websocket RPC to listen on")
     ("read-forward-rpc", bpo::value<std::string>(), "Endpoint to forward write API calls to for a read node")
@@ -1184,10 +1243,13 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("enable-plugin", bpo::value< std::vector<std::string> >()->composing()->default_value(default_plugins, str_default_plugins), "Plugin(s) to enable, may be specified multiple times")
     ("max-block-age", bpo::value< int32_t >()->default_value(200), "Maximum age of head block when broadcasting tx via API")
     ("flush", bpo::value< uint32_t >()->default_value(100000), "Flush shared memory file to disk this many blocks")
+    ("invariants-audit-interval", bpo::value< uint32_t >()->default_value(SCORUM_BLOCKS_PER_HOUR), "Fully recalculate database invariants this many blocks (0 - only on startup)")
     ("genesis-json,g", bpo::value<boost::filesystem::path>(), "File to read genesis state from")
     ("replay-blockchain", "Rebuild object graph by replaying all blocks")
     ("replay-skip-witness-schedule-check", bpo::value<bool>()->default_value(true), "Skip witness schedule check wile block replaying")
     ("resync-blockchain", "Delete all blocks and re-sync with network from scratch")
+    ("import-state-snapshot", bpo::value<boost::filesystem::path>(), "Create the state from the snapshot instead of replaying (the block log must contain the snapshot head block)")
+    ("export-state-snapshot", bpo::value<boost::filesystem::path>(), "Write the state at the last irreversible block to the snapshot file on startup")
     ("force-validate", "Force validation of all transactions")
     ("read-only", "Node will not connect to p2p network and can only read from the chain state")
     ("check-locks", "Check correctness of chainbase locking")
@@ -1367,6 +1429,11 @@ std::shared_ptr<chain::database> application::chain_database() const
     return my->_chain_db;
 }
 
+std::shared_ptr<const api_snapshot> application::get_api_snapshot() const
+{
+    return std::atomic_load(&my->_api_snapshot);
+}
+
 void application::set_block_production(bool producing_blocks)
 {
     my->_is_block_producer = producing_blocks;
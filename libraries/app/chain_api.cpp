@@ -1,5 +1,6 @@
 #include <scorum/app/chain_api.hpp>
 #include <scorum/app/api_context.hpp>
+#include <scorum/app/api_snapshot.hpp>
 #include <scorum/app/application.hpp>
 #include <scorum/chain/services/budgets.hpp>
 #include <scorum/chain/services/development_committee.hpp>
@@ -20,7 +21,8 @@ namespace app {
 using namespace scorum::chain;
 
 chain_api::chain_api(const api_context& ctx)
-    : _db(*ctx.app.chain_database())
+    : _app(ctx.app)
+    , _db(*ctx.app.chain_database())
 {
 }
 
@@ -30,46 +32,18 @@ void chain_api::on_api_startup()
 
 chain_properties_api_obj chain_api::get_chain_properties() const
 {
-    return _db.with_read_lock([&]() {
-
-        chain_properties_api_obj ret_val;
-
-        if (_db.has_index<witness::reserve_ratio_index>())
-        {
-            const auto& r = _db.find(witness::reserve_ratio_id_type());
-
-            if (BOOST_LIKELY(r != nullptr))
-            {
-                ret_val = *r;
-            }
-        }
+    if (auto snapshot = _app.get_api_snapshot())
+        return snapshot->chain_properties;
 
-        const dynamic_global_property_object& dpo = _db.obtain_service<dbs_dynamic_global_property>().get();
-
-        ret_val.head_block_id = dpo.head_block_id;
-        ret_val.head_block_number = dpo.head_block_number;
-        ret_val.last_irreversible_block_number = dpo.last_irreversible_block_num;
-        ret_val.current_aslot = dpo.current_aslot;
-        ret_val.time = dpo.time;
-        ret_val.current_witness = dpo.current_witness;
-        ret_val.majority_version = dpo.majority_version;
-        ret_val.median_chain_props = dpo.median_chain_props;
-        ret_val.chain_id = _db.get_chain_id();
-        ret_val.hf_version = _db.obtain_service<dbs_hardfork_property>().get().current_hardfork_version;
-
-        return ret_val;
-    });
+    return _db.with_read_lock([&]() { return make_chain_properties_api_obj(_db); });
 }
 
 scheduled_hardfork_api_obj chain_api::get_next_scheduled_hardfork() const
 {
-    return _db.with_read_lock([&]() {
-        scheduled_hardfork_api_obj shf;
-        const auto& hpo = _db.obtain_service<dbs_hardfork_property>().get();
-        shf.hf_version = hpo.next_hardfork;
-        shf.live_time = hpo.next_hardfork_time;
-        return shf;
-    });
+    if (auto snapshot = _app.get_api_snapshot())
+        return snapshot->next_scheduled_hardfork;
+
+    return _db.with_read_lock([&]() { return make_scheduled_hardfork_api_obj(_db); });
 }
 
 reward_fund_api_obj chain_api::get_reward_fund(reward_fund_type type_of_fund) const
@@ -3,6 +3,7 @@
 #include "scorum/chain/dba/db_accessor.hpp"
 
 #include <scorum/app/api_context.hpp>
+#include <scorum/app/api_snapshot.hpp>
 #include <scorum/app/application.hpp>
 
 #include <scorum/protocol/get_config.hpp>
@@ -148,6 +149,7 @@ public:
 
     std::function<void(const fc::variant&)> _block_applied_callback;
 
+    const application& _app;
     scorum::chain::database& _db;
 
     boost::signals2::scoped_connection _block_applied_connection;
@@ -202,7 +204,8 @@ database_api::~database_api()
 }
 
 database_api_impl::database_api_impl(const scorum::app::api_context& ctx)
-    : _db(*ctx.app.chain_database())
+    : _app(ctx.app)
+    , _db(*ctx.app.chain_database())
 {
     wlog("creating database api ${x}", ("x", int64_t(this)));
 }
@@ -224,7 +227,8 @@ void database_api::on_api_startup()
 
 fc::variant_object database_api::get_config() const
 {
-    return my->_db.with_read_lock([&]() { return my->get_config(); });
+    // protocol constants don't need the database lock
+    return my->get_config();
 }
 
 fc::variant_object database_api_impl::get_config() const
@@ -234,56 +238,21 @@ fc::variant_object database_api_impl::get_config() const
 
 dynamic_global_property_api_obj database_api::get_dynamic_global_properties() const
 {
+    if (auto snapshot = my->_app.get_api_snapshot())
+        return snapshot->dynamic_global_properties;
+
     return my->_db.with_read_lock([&]() { return my->get_dynamic_global_properties(); });
 }
 
 dynamic_global_property_api_obj database_api_impl::get_dynamic_global_properties() const
 {
-    dynamic_global_property_api_obj gpao;
-    gpao = _db.obtain_service<dbs_dynamic_global_property>().get();
-
-    if (_db.has_index<witness::reserve_ratio_index>())
-    {
-        const auto& r = _db.find(witness::reserve_ratio_id_type());
-
-        if (BOOST_LIKELY(r != nullptr))
-        {
-            gpao = *r;
-        }
-    }
-
-    if (_db.obtain_service<dbs_registration_pool>().is_exists())
-    {
-        gpao.registration_pool_balance = _db.obtain_service<dbs_registration_pool>().get().balance;
-    }
-
-    if (_db.obtain_service<dbs_fund_budget>().is_exists())
-    {
-        gpao.fund_budget_balance = _db.obtain_service<dbs_fund_budget>().get().balance;
-    }
-
-    if (_db.obtain_service<dbs_fund_budget>().is_exists())
-    {
-        gpao.reward_pool_balance = _db.obtain_service<dbs_content_reward_scr>().get().balance;
-    }
-
-    if (_db.obtain_service<dbs_content_reward_fund_scr>().is_exists())
-    {
-        gpao.content_reward_scr_balance
-            = _db.obtain_service<dbs_content_reward_fund_scr>().get().activity_reward_balance;
-    }
-
-    if (_db.obtain_service<dbs_content_reward_fund_scr>().is_exists())
-    {
-        gpao.content_reward_sp_balance = _db.obtain_service<dbs_content_reward_fund_sp>().get().activity_reward_balance;
-    }
-
-    return gpao;
+    return make_dynamic_global_property_api_obj(_db);
 }
 
 chain_id_type database_api::get_chain_id() const
 {
-    return my->_db.with_read_lock([&]() { return my->get_chain_id(); });
+    // chain id is copied on the database opening
+    return my->get_chain_id();
 }
 
 chain_id_type database_api_impl::get_chain_id() const
@@ -293,6 +262,9 @@ chain_id_type database_api_impl::get_chain_id() const
 
 witness_schedule_api_obj database_api::get_witness_schedule() const
 {
+    if (auto snapshot = my->_app.get_api_snapshot())
+        return snapshot->witness_schedule;
+
     return my->_db.with_read_lock([&]() { return my->_db.get(witness_schedule_id_type()); });
 }
 
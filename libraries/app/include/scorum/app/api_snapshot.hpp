@@ -0,0 +1,38 @@
+#pragma once
+
+#include <scorum/app/scorum_api_objects.hpp>
+#include <scorum/app/schema/chain_api_objects.hpp>
+
+#include <memory>
+
+namespace scorum {
+
+namespace chain {
+class database;
+}
+
+namespace app {
+
+/**
+ * Copy of the frequently requested API objects at the last applied block.
+ *
+ * The snapshot is built by the block applying thread while it holds the write lock. API threads read the last
+ * published snapshot without the database lock, so the readers don't stall the block applying and aren't stalled by it.
+ */
+struct api_snapshot
+{
+    dynamic_global_property_api_obj dynamic_global_properties;
+    chain_properties_api_obj chain_properties;
+    witness_schedule_api_obj witness_schedule;
+    scheduled_hardfork_api_obj next_scheduled_hardfork;
+};
+
+// These functions require the database lock
+
+std::shared_ptr<const api_snapshot> make_api_snapshot(chain::database& db);
+
+dynamic_global_property_api_obj make_dynamic_global_property_api_obj(chain::database& db);
+chain_properties_api_obj make_chain_properties_api_obj(chain::database& db);
+scheduled_hardfork_api_obj make_scheduled_hardfork_api_obj(chain::database& db);
+}
+}
@@ -88,6 +88,7 @@ class plugin;
 class application;
 
 class network_broadcast_api;
+struct api_snapshot;
 class login_api;
 class database_api;
 
@@ -140,6 +141,10 @@ public:
 
     graphene::net::node_ptr p2p_node();
     std::shared_ptr<chain::database> chain_database() const;
+
+    /// @returns API objects at the last applied block that are read without the database lock (or nullptr if the
+    /// database hasn't been opened for writing)
+    std::shared_ptr<const api_snapshot> get_api_snapshot() const;
     // std::shared_ptr<graphene::db::object_database> pending_trx_database() const;
 
     void set_block_production(bool producing_blocks);
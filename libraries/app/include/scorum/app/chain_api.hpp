@@ -15,6 +15,7 @@ class database;
 namespace app {
 
 struct api_context;
+class application;
 
 enum class reward_fund_type
 {
@@ -43,6 +44,7 @@ public:
     chain_capital_api_obj get_chain_capital() const;
 
 private:
+    const application& _app;
     chain::database& _db;
 };
 }
@@ -0,0 +1,210 @@
+#include <scorum/chain/async_block_stream.hpp>
+
+#include <scorum/chain/database/database.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
+
+#include <scorum/utils/bounded_queue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace scorum {
+namespace chain {
+
+namespace detail {
+
+class async_block_stream_impl
+{
+public:
+    async_block_stream_impl(database& db,
+                            const std::string& name,
+                            async_block_stream::handler_type handler,
+                            size_t queue_size)
+        : _db(db)
+        , _name(name)
+        , _handler(std::move(handler))
+        , _queue(queue_size)
+    {
+        _pre_applied_block_conn
+            = _db.pre_applied_block.connect([this](const signed_block& b) { on_pre_applied_block(b); });
+        _post_apply_operation_conn
+            = _db.post_apply_operation.connect([this](const operation_notification& note) { on_operation(note); });
+        _applied_block_conn = _db.applied_block.connect([this](const signed_block& b) { on_applied_block(b); });
+        _popped_block_conn = _db.popped_block.connect([this](const signed_block& b) { on_popped_block(b); });
+
+        _thread = std::thread([this] { work(); });
+    }
+
+    ~async_block_stream_impl()
+    {
+        _pre_applied_block_conn.disconnect();
+        _post_apply_operation_conn.disconnect();
+        _applied_block_conn.disconnect();
+        _popped_block_conn.disconnect();
+
+        _queue.close();
+        _thread.join();
+    }
+
+    uint32_t lag() const
+    {
+        return _pushed - _handled;
+    }
+
+    void wait() const
+    {
+        std::unique_lock<std::mutex> lock(_handled_mutex);
+        _all_handled.wait(lock, [&] { return _handled == _pushed; });
+    }
+
+    database& _db;
+    const std::string _name;
+    std::atomic<uint32_t> _last_handled_block_num{ 0 };
+
+private:
+    using event_ptr = std::shared_ptr<const async_block_notification>;
+
+    void on_pre_applied_block(const signed_block&)
+    {
+        // operations of the pending transactions are notified outside of the block
+        _current = std::make_shared<async_block_notification>();
+    }
+
+    void on_operation(const operation_notification& note)
+    {
+        if (!_current)
+            return;
+
+        _current->operations.emplace_back();
+
+        auto& copy = _current->operations.back();
+        copy.trx_id = note.trx_id;
+        copy.block = note.block;
+        copy.trx_in_block = note.trx_in_block;
+        copy.op_in_trx = note.op_in_trx;
+        copy.op = note.op;
+    }
+
+    void on_applied_block(const signed_block& b)
+    {
+        if (!_current)
+            return;
+
+        const auto& dgp = _db.obtain_service<dbs_dynamic_global_property>().get();
+
+        _current->event = async_block_notification::applied_block;
+        _current->block = std::make_shared<signed_block>(b);
+        _current->block_num = b.block_num();
+        _current->current_aslot = dgp.current_aslot;
+        _current->last_irreversible_block_num = dgp.last_irreversible_block_num;
+
+        push(std::move(_current));
+    }
+
+    void on_popped_block(const signed_block& b)
+    {
+        auto event = std::make_shared<async_block_notification>();
+        event->event = async_block_notification::popped_block;
+        event->block = std::make_shared<signed_block>(b);
+        event->block_num = b.block_num();
+
+        push(std::move(event));
+    }
+
+    void push(event_ptr event)
+    {
+        ++_pushed;
+        if (!_queue.push(std::move(event)))
+            handled();
+    }
+
+    void work()
+    {
+        event_ptr event;
+        while (_queue.pop(event))
+        {
+            try
+            {
+                _handler(*event);
+            }
+            catch (const fc::exception& e)
+            {
+                elog("Caught exception in ${name} handler: ${e}", ("name", _name)("e", e.to_detail_string()));
+            }
+            catch (const std::exception& e)
+            {
+                elog("Caught exception in ${name} handler: ${e}", ("name", _name)("e", e.what()));
+            }
+
+            if (event->event == async_block_notification::applied_block)
+                _last_handled_block_num = event->block_num;
+            else
+                _last_handled_block_num = event->block_num - 1;
+
+            handled();
+        }
+    }
+
+    void handled()
+    {
+        std::lock_guard<std::mutex> lock(_handled_mutex);
+        ++_handled;
+        _all_handled.notify_all();
+    }
+
+    async_block_stream::handler_type _handler;
+
+    std::shared_ptr<async_block_notification> _current;
+
+    utils::bounded_queue<event_ptr> _queue;
+    std::thread _thread;
+
+    std::atomic<uint32_t> _pushed{ 0 };
+    std::atomic<uint32_t> _handled{ 0 };
+    mutable std::mutex _handled_mutex;
+    mutable std::condition_variable _all_handled;
+
+    boost::signals2::connection _pre_applied_block_conn;
+    boost::signals2::connection _post_apply_operation_conn;
+    boost::signals2::connection _applied_block_conn;
+    boost::signals2::connection _popped_block_conn;
+};
+}
+
+async_block_stream::async_block_stream(database& db,
+                                       const std::string& name,
+                                       handler_type handler,
+                                       size_t queue_size)
+    : _impl(new detail::async_block_stream_impl(db, name, std::move(handler), queue_size))
+{
+    db.register_async_stream(*this);
+}
+
+async_block_stream::~async_block_stream()
+{
+    _impl->_db.unregister_async_stream(*this);
+}
+
+const std::string& async_block_stream::name() const
+{
+    return _impl->_name;
+}
+
+uint32_t async_block_stream::lag() const
+{
+    return _impl->lag();
+}
+
+uint32_t async_block_stream::last_handled_block_num() const
+{
+    return _impl->_last_handled_block_num;
+}
+
+void async_block_stream::wait() const
+{
+    _impl->wait();
+}
+}
+}
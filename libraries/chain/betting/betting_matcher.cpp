@@ -320,8 +320,6 @@ std::vector<std::reference_wrapper<const pending_bet_object>> betting_matcher::m
 {
     try
     {
-        auto key = std::make_tuple(bet2.game_uuid, create_opposite(bet2.get_wincase()));
-
         if (_bets_matching_fix.find(bet2.data.uuid) != _bets_matching_fix.end())
         {
             dlog("fix matching in block ${0}", ("0", _dprop_dba.get().head_block_number));
@@ -339,7 +337,11 @@ std::vector<std::reference_wrapper<const pending_bet_object>> betting_matcher::m
         }
         else
         {
-            auto bets = _pending_bet_dba.get_range_by<by_game_uuid_wincase_asc>(key);
+            // order book lookup: only opposite bets on the same price level in FIFO order
+            auto key = std::make_tuple(bet2.game_uuid, create_opposite(bet2.get_wincase()),
+                                       bet2.data.odds.simplified_key());
+
+            auto bets = _pending_bet_dba.get_range_by<by_game_uuid_wincase_odds>(key);
             return _impl->match(bet2, bets);
         }
     }
@@ -1,7 +1,12 @@
 #include <scorum/chain/block_log.hpp>
+#include <cstring>
 #include <fstream>
+#include <mutex>
 #include <fc/io/raw.hpp>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #define LOG_READ (std::ios::in | std::ios::binary)
 #define LOG_WRITE (std::ios::out | std::ios::binary | std::ios::app)
 
@@ -9,6 +14,69 @@ namespace scorum {
 namespace chain {
 
 namespace detail {
+
+namespace bip = boost::interprocess;
+
+/// Read-only mapping of the block log and index files limited to the blocks flushed at the time of mapping
+struct block_log_mapping
+{
+    block_log_mapping(const fc::path& block_file, const fc::path& index_file, uint32_t blocks, uint64_t size)
+        : block_count(blocks)
+        , data_size(size)
+    {
+        map(block_file, block_region);
+        map(index_file, index_region);
+
+        FC_ASSERT(block_region.get_size() >= data_size, "Block log is shorter than was written.",
+                  ("size", block_region.get_size())("expected", data_size));
+        FC_ASSERT(index_region.get_size() >= sizeof(uint64_t) * block_count, "Index is shorter than was written.",
+                  ("size", index_region.get_size())("expected", sizeof(uint64_t) * block_count));
+
+        data = static_cast<const char*>(block_region.get_address());
+    }
+
+    static void map(const fc::path& file, bip::mapped_region& region)
+    {
+        // empty file can't be mapped
+        if (!fc::exists(file) || fc::file_size(file) == 0)
+            return;
+
+        bip::file_mapping mapping(file.generic_string().c_str(), bip::read_only);
+        bip::mapped_region(mapping, bip::read_only).swap(region);
+    }
+
+    uint64_t read_pos(const char* at) const
+    {
+        uint64_t pos;
+        memcpy(&pos, at, sizeof(pos));
+        return pos;
+    }
+
+    uint64_t block_pos(uint32_t block_num) const
+    {
+        return read_pos(static_cast<const char*>(index_region.get_address()) + sizeof(uint64_t) * (block_num - 1));
+    }
+
+    uint64_t head_pos() const
+    {
+        FC_ASSERT(data_size >= sizeof(uint64_t), "Block log is empty.");
+        return read_pos(data + data_size - sizeof(uint64_t));
+    }
+
+    /// end of the block data (the position of its trailer)
+    uint64_t block_end(uint32_t block_num) const
+    {
+        return (block_num < block_count ? block_pos(block_num + 1) : data_size) - sizeof(uint64_t);
+    }
+
+    bip::mapped_region block_region;
+    bip::mapped_region index_region;
+
+    const uint32_t block_count;
+    const uint64_t data_size;
+    const char* data = nullptr;
+};
+
 class block_log_impl
 {
 public:
@@ -21,6 +89,36 @@ public:
     bool block_write;
     bool index_write;
 
+    // blocks and size of the block log flushed to the files and so visible for the mapping
+    uint32_t readable_blocks = 0;
+    uint64_t readable_size = 0;
+
+    std::shared_ptr<const block_log_mapping> mapping;
+    std::mutex mapping_mutex;
+
+    void set_readable(uint32_t blocks, uint64_t size)
+    {
+        std::lock_guard<std::mutex> lock(mapping_mutex);
+        readable_blocks = blocks;
+        readable_size = size;
+    }
+
+    void reset_mapping()
+    {
+        std::lock_guard<std::mutex> lock(mapping_mutex);
+        mapping.reset();
+    }
+
+    std::shared_ptr<const block_log_mapping> get_mapping()
+    {
+        std::lock_guard<std::mutex> lock(mapping_mutex);
+        if (!mapping || mapping->block_count < readable_blocks || mapping->data_size < readable_size)
+        {
+            mapping = std::make_shared<block_log_mapping>(block_file, index_file, readable_blocks, readable_size);
+        }
+        return mapping;
+    }
+
     inline void check_block_read()
     {
         try
@@ -79,6 +177,29 @@ public:
 };
 }
 
+packed_block_view::packed_block_view(std::shared_ptr<const void> mapping, const char* data, size_t size)
+    : _mapping(std::move(mapping))
+    , _data(data)
+    , _size(size)
+{
+}
+
+signed_block_header packed_block_view::header() const
+{
+    fc::datastream<const char*> ds(_data, _size);
+    signed_block_header result;
+    fc::raw::unpack(ds, result);
+    return result;
+}
+
+signed_block packed_block_view::unpack() const
+{
+    fc::datastream<const char*> ds(_data, _size);
+    signed_block result;
+    fc::raw::unpack(ds, result);
+    return result;
+}
+
 block_log::block_log()
     : my(new detail::block_log_impl())
 {
@@ -127,6 +248,9 @@ void block_log::open(const fc::path& file)
     auto log_size = fc::file_size(my->block_file);
     auto index_size = fc::file_size(my->index_file);
 
+    my->set_readable(0, log_size);
+    my->reset_mapping();
+
     if (log_size)
     {
         ilog("Log is nonempty");
@@ -172,6 +296,11 @@ void block_log::open(const fc::path& file)
         my->index_stream.open(my->index_file.generic_string().c_str(), LOG_WRITE);
         my->index_write = true;
     }
+
+    flush();
+
+    my->set_readable(my->head ? my->head->block_num() : 0, log_size);
+    my->reset_mapping();
 }
 
 void block_log::close()
@@ -190,6 +319,16 @@ fc::path block_log::block_log_index_path(const fc::path& file)
 }
 
 uint64_t block_log::append(const signed_block& b)
+{
+    return append(b, b.id());
+}
+
+uint64_t block_log::append(const immutable_block& b)
+{
+    return append(b, b.id());
+}
+
+uint64_t block_log::append(const signed_block& b, const block_id_type& id)
 {
     try
     {
@@ -207,7 +346,11 @@ uint64_t block_log::append(const signed_block& b)
         my->block_stream.write((char*)&pos, sizeof(pos));
         my->index_stream.write((char*)&pos, sizeof(pos));
         my->head = b;
-        my->head_id = b.id();
+        my->head_id = id;
+
+        // make the block visible for the mapped readers
+        flush();
+        my->set_readable(b.block_num(), pos + data.size() + sizeof(pos));
 
         return pos;
     }
@@ -224,12 +367,14 @@ std::pair<signed_block, uint64_t> block_log::read_block(uint64_t pos) const
 {
     try
     {
-        my->check_block_read();
+        auto mapping = my->get_mapping();
+        FC_ASSERT(pos < mapping->data_size, "Position is out of the block log.",
+                  ("position", pos)("size", mapping->data_size));
 
-        my->block_stream.seekg(pos);
+        fc::datastream<const char*> ds(mapping->data + pos, mapping->data_size - pos);
         std::pair<signed_block, uint64_t> result;
-        fc::raw::unpack(my->block_stream, result.first);
-        result.second = uint64_t(my->block_stream.tellg()) + 8;
+        fc::raw::unpack(ds, result.first);
+        result.second = mapping->data_size - ds.remaining() + sizeof(uint64_t);
         return result;
     }
     FC_LOG_AND_RETHROW()
@@ -240,10 +385,10 @@ optional<signed_block> block_log::read_block_by_num(uint32_t block_num) const
     try
     {
         optional<signed_block> b;
-        uint64_t pos = get_block_pos(block_num);
-        if (pos != npos)
+        auto packed = read_packed_block_by_num(block_num);
+        if (packed.valid())
         {
-            b = read_block(pos).first;
+            b = packed->unpack();
             FC_ASSERT(b->block_num() == block_num, "Wrong block was read from block log.",
                       ("returned", b->block_num())("expected", block_num));
         }
@@ -252,18 +397,35 @@ optional<signed_block> block_log::read_block_by_num(uint32_t block_num) const
     FC_LOG_AND_RETHROW()
 }
 
-uint64_t block_log::get_block_pos(uint32_t block_num) const
+optional<packed_block_view> block_log::read_packed_block_by_num(uint32_t block_num) const
 {
     try
     {
-        my->check_index_read();
+        optional<packed_block_view> result;
+
+        auto mapping = my->get_mapping();
+        if (block_num == 0 || block_num > mapping->block_count)
+            return result;
+
+        uint64_t pos = mapping->block_pos(block_num);
+        uint64_t end = mapping->block_end(block_num);
+        FC_ASSERT(pos < end && end + sizeof(uint64_t) <= mapping->data_size, "Block log index is corrupted.",
+                  ("block_num", block_num)("position", pos)("end", end));
+
+        result = packed_block_view(mapping, mapping->data + pos, end - pos);
+        return result;
+    }
+    FC_LOG_AND_RETHROW()
+}
 
-        if (!(my->head.valid() && block_num <= protocol::block_header::num_from_id(my->head_id) && block_num > 0))
+uint64_t block_log::get_block_pos(uint32_t block_num) const
+{
+    try
+    {
+        auto mapping = my->get_mapping();
+        if (block_num == 0 || block_num > mapping->block_count)
             return npos;
-        my->index_stream.seekg(sizeof(uint64_t) * (block_num - 1));
-        uint64_t pos;
-        my->index_stream.read((char*)&pos, sizeof(pos));
-        return pos;
+        return mapping->block_pos(block_num);
     }
     FC_LOG_AND_RETHROW()
 }
@@ -272,12 +434,7 @@ signed_block block_log::read_head() const
 {
     try
     {
-        my->check_block_read();
-
-        uint64_t pos;
-        my->block_stream.seekg(-sizeof(pos), std::ios::end);
-        my->block_stream.read((char*)&pos, sizeof(pos));
-        return read_block(pos).first;
+        return read_block(my->get_mapping()->head_pos()).first;
     }
     FC_LOG_AND_RETHROW()
 }
@@ -0,0 +1,261 @@
+#include <scorum/chain/block_replay_pipeline.hpp>
+
+#include <scorum/utils/bounded_queue.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <thread>
+
+namespace scorum {
+namespace chain {
+
+namespace detail {
+
+struct stage_counters
+{
+    std::atomic<uint64_t> items{ 0 };
+    std::atomic<int64_t> busy_us{ 0 };
+    std::atomic<int64_t> wait_us{ 0 };
+
+    replay_stage_stats get(const std::string& name) const
+    {
+        replay_stage_stats s;
+        s.name = name;
+        s.items = items;
+        s.busy_time = fc::microseconds(busy_us);
+        s.wait_time = fc::microseconds(wait_us);
+        return s;
+    }
+};
+
+struct block_slot
+{
+    block_slot()
+        : ready(digested.get_future().share())
+    {
+    }
+
+    std::shared_ptr<replayed_block> data = std::make_shared<replayed_block>();
+    std::promise<void> digested;
+    std::shared_future<void> ready;
+};
+
+using block_slot_ptr = std::shared_ptr<block_slot>;
+
+class block_replay_pipeline_impl
+{
+public:
+    block_replay_pipeline_impl(const fc::path& block_log_file,
+                               uint32_t last_block_num,
+                               uint32_t digest_threads,
+                               size_t queue_size)
+        : _block_log_file(block_log_file)
+        , _last_block_num(last_block_num)
+        , _digest_threads(digest_threads)
+        , _ordered(queue_size)
+        , _to_digest(queue_size)
+    {
+        if (_digest_threads == 0)
+        {
+            // the reader and the caller (apply) threads are busy too
+            uint32_t cores = std::thread::hardware_concurrency();
+            _digest_threads = std::max(cores > 2 ? cores - 2 : 1u, 1u);
+        }
+    }
+
+    ~block_replay_pipeline_impl()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        FC_ASSERT(_threads.empty(), "Pipeline is already started");
+
+        _threads.emplace_back([this] { read(); });
+        for (uint32_t i = 0; i < _digest_threads; ++i)
+            _threads.emplace_back([this] { digest(); });
+    }
+
+    void stop()
+    {
+        _stopped = true;
+
+        _ordered.close();
+        _to_digest.close();
+
+        for (auto& t : _threads)
+        {
+            if (t.joinable())
+                t.join();
+        }
+        _threads.clear();
+    }
+
+    std::shared_ptr<const replayed_block> next()
+    {
+        auto entered = fc::time_point::now();
+        if (_last_returned != fc::time_point())
+            _apply.busy_us += (entered - _last_returned).count();
+
+        std::shared_ptr<const replayed_block> result;
+
+        block_slot_ptr slot;
+        if (_ordered.pop(slot))
+        {
+            slot->ready.get(); // rethrows read or digest error
+            result = slot->data;
+            ++_apply.items;
+        }
+
+        _last_returned = fc::time_point::now();
+        _apply.wait_us += (_last_returned - entered).count();
+
+        return result;
+    }
+
+    std::vector<replay_stage_stats> stats() const
+    {
+        return { _read.get("read"), _digest.get("digest"), _apply.get("apply") };
+    }
+
+private:
+    void read()
+    {
+        try
+        {
+            std::vector<char> buffer(1024 * 1024);
+            std::ifstream stream;
+            stream.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+            stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+            stream.open(_block_log_file.generic_string().c_str(), std::ios::in | std::ios::binary);
+
+            for (uint32_t block_num = 1; block_num <= _last_block_num && !_stopped; ++block_num)
+            {
+                auto started = fc::time_point::now();
+
+                auto slot = std::make_shared<block_slot>();
+                fc::raw::unpack(stream, slot->data->block);
+                stream.seekg(sizeof(uint64_t), std::ios::cur); // skip position of the block
+
+                FC_ASSERT(slot->data->block.block_num() == block_num, "Wrong block was read from block log.",
+                          ("returned", slot->data->block.block_num())("expected", block_num));
+
+                auto unpacked = fc::time_point::now();
+                _read.busy_us += (unpacked - started).count();
+                ++_read.items;
+
+                // block goes to the apply queue first to keep the order, digest queue can't be longer than it
+                if (!_ordered.push(slot) || !_to_digest.push(slot))
+                    break;
+
+                _read.wait_us += (fc::time_point::now() - unpacked).count();
+            }
+        }
+        catch (...)
+        {
+            auto slot = std::make_shared<block_slot>();
+            slot->digested.set_exception(std::current_exception());
+            _ordered.push(slot);
+        }
+
+        _to_digest.close();
+        _ordered.close();
+    }
+
+    void digest()
+    {
+        block_slot_ptr slot;
+        while (true)
+        {
+            auto waiting = fc::time_point::now();
+            if (!_to_digest.pop(slot) || _stopped)
+                break;
+
+            auto started = fc::time_point::now();
+            _digest.wait_us += (started - waiting).count();
+
+            std::exception_ptr error;
+            try
+            {
+                auto& data = *slot->data;
+
+                data.block_id = data.block.id();
+
+                data.transaction_ids.reserve(data.block.transactions.size());
+                for (const auto& trx : data.block.transactions)
+                    data.transaction_ids.push_back(trx.id());
+
+                data.merkle_root = data.block.calculate_merkle_root();
+                data.block_size = fc::raw::pack_size(data.block);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            // counters are updated before the block is handed over to be consistent for the apply stage
+            _digest.busy_us += (fc::time_point::now() - started).count();
+            ++_digest.items;
+
+            if (error)
+                slot->digested.set_exception(error);
+            else
+                slot->digested.set_value();
+        }
+    }
+
+    const fc::path _block_log_file;
+    const uint32_t _last_block_num;
+    uint32_t _digest_threads;
+
+    utils::bounded_queue<block_slot_ptr> _ordered;
+    utils::bounded_queue<block_slot_ptr> _to_digest;
+
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _stopped{ false };
+
+    stage_counters _read;
+    stage_counters _digest;
+    stage_counters _apply;
+
+    fc::time_point _last_returned;
+};
+}
+
+block_replay_pipeline::block_replay_pipeline(const fc::path& block_log_file,
+                                             uint32_t last_block_num,
+                                             uint32_t digest_threads,
+                                             size_t queue_size)
+    : _impl(new detail::block_replay_pipeline_impl(block_log_file, last_block_num, digest_threads, queue_size))
+{
+}
+
+block_replay_pipeline::~block_replay_pipeline()
+{
+}
+
+void block_replay_pipeline::start()
+{
+    _impl->start();
+}
+
+void block_replay_pipeline::stop()
+{
+    _impl->stop();
+}
+
+std::shared_ptr<const replayed_block> block_replay_pipeline::next()
+{
+    return _impl->next();
+}
+
+std::vector<replay_stage_stats> block_replay_pipeline::stats() const
+{
+    return _impl->stats();
+}
+}
+}
@@ -0,0 +1,175 @@
+#include <scorum/chain/comment_content_store.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+comment_content_store::comment_content_store(size_t cache_size, size_t appended_index_size)
+    : _cache(cache_size)
+    , _appended(appended_index_size)
+{
+}
+
+void comment_content_store::open(const fc::path& file, bool read_only)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file.is_open())
+        _file.close();
+
+    _path = file;
+    _read_only = read_only;
+    _cache.clear();
+    _appended.clear();
+
+    if (!fc::exists(file))
+    {
+        FC_ASSERT(!read_only, "Comment content store ${f} does not exist", ("f", file.generic_string()));
+        std::ofstream(file.generic_string().c_str(), std::ios::out | std::ios::binary);
+    }
+
+    auto mode = std::ios::in | std::ios::binary;
+    if (!read_only)
+        mode |= std::ios::out;
+
+    _file.exceptions(std::fstream::failbit | std::fstream::badbit);
+    _file.open(file.generic_string().c_str(), mode);
+
+    _file.seekg(0, std::ios::end);
+    _end = (uint64_t)_file.tellg();
+}
+
+void comment_content_store::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file.is_open())
+    {
+        _file.flush();
+        _file.close();
+    }
+
+    _cache.clear();
+    _appended.clear();
+}
+
+void comment_content_store::flush()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_file.is_open() && !_read_only)
+        _file.flush();
+}
+
+void comment_content_store::wipe(const fc::path& file)
+{
+    fc::remove_all(file);
+}
+
+void comment_content_store::copy(const fc::path& file) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    FC_ASSERT(_file.is_open(), "Comment content store is not opened");
+
+    _file.flush();
+
+    fc::remove_all(file);
+    fc::copy(_path, file);
+}
+
+comment_content_ref comment_content_store::append(const comment_content& content)
+{
+    comment_content_ref ref;
+
+    if (content.title.empty() && content.body.empty() && content.json_metadata.empty())
+        return ref;
+
+    auto data = fc::raw::pack(content);
+    FC_ASSERT(data.size() <= std::numeric_limits<uint32_t>::max(), "Comment content is too big");
+
+    const auto hash = fc::ripemd160::hash(data.data(), data.size());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    FC_ASSERT(_file.is_open() && !_read_only, "Comment content store is not opened for writing");
+
+    // the same operation is applied again on pending, block and fork switch, its content is already stored
+    if (const comment_content_ref* appended = _appended.find(hash))
+    {
+        if (appended->size == data.size())
+            return *appended;
+    }
+
+    ref.position = _end;
+    ref.size = (uint32_t)data.size();
+    ref.hash = hash;
+
+    _file.seekp(_end);
+    _file.write(data.data(), data.size());
+
+    _end += data.size();
+
+    _cache.insert(ref.position, content);
+    _appended.insert(hash, ref);
+
+    return ref;
+}
+
+uint64_t comment_content_store::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _end;
+}
+
+comment_content comment_content_store::read(const comment_content_ref& ref) const
+{
+    if (ref.size == 0)
+        return comment_content();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (const comment_content* cached = _cache.find(ref.position))
+        return *cached;
+
+    FC_ASSERT(_file.is_open(), "Comment content store is not opened");
+
+    if (_read_only && ref.position + ref.size > _end)
+    {
+        // the file is appended by the other process
+        _file.seekg(0, std::ios::end);
+        _end = (uint64_t)_file.tellg();
+    }
+
+    FC_ASSERT(ref.position + ref.size <= _end, "Comment content is beyond the end of ${f}. Reindex blockchain.",
+              ("f", _path.generic_string()));
+
+    std::vector<char> data(ref.size);
+
+    _file.seekg(ref.position);
+    _file.read(data.data(), data.size());
+
+    FC_ASSERT(fc::ripemd160::hash(data.data(), data.size()) == ref.hash,
+              "Comment content at ${p} does not match its hash in ${f}",
+              ("p", ref.position)("f", _path.generic_string()));
+
+    comment_content content = fc::raw::unpack<comment_content>(data);
+
+    _cache.insert(ref.position, content);
+
+    return content;
+}
+
+void comment_content_store::set_cache_size(size_t cache_size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _cache.set_capacity(cache_size);
+}
+}
+}
@@ -0,0 +1,522 @@
+#include <scorum/chain/compressed_block_log.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+#include <zlib.h>
+
+namespace scorum {
+namespace chain {
+namespace detail {
+
+struct compressed_log_header
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t codec = 0;
+    uint32_t blocks_per_chunk = 0;
+};
+
+struct compressed_chunk_header
+{
+    uint32_t raw_size = 0;
+    uint32_t compressed_size = 0;
+    uint32_t block_count = 0;
+};
+}
+}
+}
+
+FC_REFLECT(scorum::chain::detail::compressed_log_header, (magic)(version)(codec)(blocks_per_chunk))
+FC_REFLECT(scorum::chain::detail::compressed_chunk_header, (raw_size)(compressed_size)(block_count))
+
+namespace scorum {
+namespace chain {
+namespace detail {
+
+static const uint32_t compressed_log_magic = 0x5a4c4253; // "SBLZ"
+static const uint32_t compressed_log_version = 1;
+
+/// Decompressed chunk: packed blocks and their offsets
+struct block_chunk
+{
+    std::vector<uint32_t> offsets;
+    std::vector<char> blocks;
+
+    uint32_t size() const
+    {
+        return (uint32_t)offsets.size();
+    }
+
+    std::pair<const char*, size_t> block(uint32_t i) const
+    {
+        size_t begin = offsets[i];
+        size_t end = i + 1 < offsets.size() ? offsets[i + 1] : blocks.size();
+        return { blocks.data() + begin, end - begin };
+    }
+};
+
+std::vector<char> compress_chunk(const block_chunk& chunk, compressed_chunk_header& header)
+{
+    const size_t offsets_size = sizeof(uint32_t) * chunk.offsets.size();
+
+    std::vector<char> raw(offsets_size + chunk.blocks.size());
+    memcpy(raw.data(), chunk.offsets.data(), offsets_size);
+    memcpy(raw.data() + offsets_size, chunk.blocks.data(), chunk.blocks.size());
+
+    uLongf compressed_size = compressBound(raw.size());
+    std::vector<char> compressed(compressed_size);
+
+    int rc = compress2((Bytef*)compressed.data(), &compressed_size, (const Bytef*)raw.data(), raw.size(),
+                       Z_DEFAULT_COMPRESSION);
+    FC_ASSERT(rc == Z_OK, "Failed to compress chunk.", ("error", rc));
+    compressed.resize(compressed_size);
+
+    header.raw_size = (uint32_t)raw.size();
+    header.compressed_size = (uint32_t)compressed.size();
+    header.block_count = chunk.size();
+
+    return compressed;
+}
+
+block_chunk decompress_chunk(const compressed_chunk_header& header, const std::vector<char>& compressed)
+{
+    std::vector<char> raw(header.raw_size);
+    uLongf raw_size = raw.size();
+
+    int rc = uncompress((Bytef*)raw.data(), &raw_size, (const Bytef*)compressed.data(), compressed.size());
+    FC_ASSERT(rc == Z_OK && raw_size == header.raw_size, "Failed to decompress chunk.",
+              ("error", rc)("size", (uint64_t)raw_size)("expected", header.raw_size));
+
+    const size_t offsets_size = sizeof(uint32_t) * header.block_count;
+    FC_ASSERT(header.block_count > 0 && offsets_size <= raw.size(), "Chunk is corrupted.");
+
+    block_chunk chunk;
+    chunk.offsets.resize(header.block_count);
+    memcpy(chunk.offsets.data(), raw.data(), offsets_size);
+    chunk.blocks.assign(raw.begin() + offsets_size, raw.end());
+
+    for (uint32_t i = 0; i < chunk.size(); ++i)
+    {
+        FC_ASSERT(chunk.offsets[i] <= chunk.blocks.size() && (i == 0 || chunk.offsets[i - 1] <= chunk.offsets[i]),
+                  "Chunk is corrupted.");
+    }
+
+    return chunk;
+}
+
+class compressed_block_log_impl
+{
+public:
+    fc::path block_file;
+    fc::path index_file;
+    compressed_log_header header;
+
+    // positions of the full chunks
+    std::vector<uint64_t> chunk_positions;
+
+    // last chunk that isn't full
+    block_chunk tail;
+    uint64_t tail_pos = 0;
+    bool tail_written = false;
+    bool tail_changed = false;
+
+    std::ifstream block_stream;
+
+    uint64_t cached_chunk_num = std::numeric_limits<uint64_t>::max();
+    block_chunk cached_chunk;
+
+    std::mutex mutex;
+
+    uint32_t head_block_num() const
+    {
+        return (uint32_t)(chunk_positions.size() * header.blocks_per_chunk + tail.size());
+    }
+
+    void open(const fc::path& file, uint32_t blocks_per_chunk)
+    {
+        block_file = file;
+        index_file = compressed_block_log::block_log_index_path(file);
+
+        if (!fc::exists(block_file) || fc::file_size(block_file) == 0)
+        {
+            FC_ASSERT(blocks_per_chunk > 0, "Chunk must contain blocks.");
+
+            header.magic = compressed_log_magic;
+            header.version = compressed_log_version;
+            header.codec = compressed_block_log::zlib_codec;
+            header.blocks_per_chunk = blocks_per_chunk;
+
+            auto data = fc::raw::pack(header);
+            std::ofstream out(block_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write(data.data(), data.size());
+
+            std::ofstream(index_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+            tail_pos = data.size();
+        }
+
+        block_stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        block_stream.open(block_file.generic_string().c_str(), std::ios::in | std::ios::binary);
+
+        block_stream.seekg(0);
+        fc::raw::unpack(block_stream, header);
+
+        FC_ASSERT(header.magic == compressed_log_magic, "File is not a compressed block log.", ("file", block_file));
+        FC_ASSERT(header.version == compressed_log_version, "Unsupported compressed block log version.",
+                  ("version", header.version));
+        FC_ASSERT(header.codec == compressed_block_log::zlib_codec, "Unsupported compression codec.",
+                  ("codec", header.codec));
+        FC_ASSERT(header.blocks_per_chunk > 0, "Compressed block log header is corrupted.");
+
+        load_index();
+    }
+
+    void load_index()
+    {
+        const uint64_t data_size = fc::file_size(block_file);
+        const uint64_t first_chunk_pos = fc::raw::pack_size(header);
+
+        std::vector<uint64_t> positions;
+        if (!read_index(positions, data_size, first_chunk_pos))
+        {
+            ilog("Reconstructing Compressed Block Log Index...");
+            positions = scan_chunks(data_size, first_chunk_pos);
+
+            std::ofstream out(index_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write((const char*)positions.data(), sizeof(uint64_t) * positions.size());
+        }
+
+        tail_pos = first_chunk_pos;
+        if (!positions.empty())
+        {
+            auto last = read_chunk_header(positions.back());
+            if (last.block_count < header.blocks_per_chunk)
+            {
+                // continue the last chunk in memory, it will be rewritten
+                tail = read_chunk(positions.back());
+                tail_pos = positions.back();
+                tail_written = true;
+                positions.pop_back();
+            }
+            else
+            {
+                tail_pos = chunk_end(positions.back(), last);
+            }
+        }
+
+        chunk_positions = std::move(positions);
+    }
+
+    bool read_index(std::vector<uint64_t>& positions, uint64_t data_size, uint64_t first_chunk_pos)
+    {
+        if (!fc::exists(index_file) || fc::file_size(index_file) % sizeof(uint64_t) != 0)
+            return false;
+
+        positions.resize(fc::file_size(index_file) / sizeof(uint64_t));
+
+        std::ifstream in(index_file.generic_string().c_str(), std::ios::in | std::ios::binary);
+        in.read((char*)positions.data(), sizeof(uint64_t) * positions.size());
+        if (!in)
+            return false;
+
+        if (positions.empty())
+            return data_size == first_chunk_pos;
+
+        if (positions.front() != first_chunk_pos || positions.back() >= data_size)
+            return false;
+
+        try
+        {
+            return chunk_end(positions.back(), read_chunk_header(positions.back())) == data_size;
+        }
+        catch (...)
+        {
+            block_stream.clear();
+            return false;
+        }
+    }
+
+    std::vector<uint64_t> scan_chunks(uint64_t data_size, uint64_t first_chunk_pos)
+    {
+        const uint64_t header_size = fc::raw::pack_size(compressed_chunk_header());
+
+        std::vector<uint64_t> positions;
+        uint64_t pos = first_chunk_pos;
+        while (pos + header_size <= data_size)
+        {
+            auto chunk_header = read_chunk_header(pos);
+            uint64_t end = chunk_end(pos, chunk_header);
+            if (end > data_size)
+                break;
+
+            FC_ASSERT(positions.empty() || read_chunk_header(positions.back()).block_count == header.blocks_per_chunk,
+                      "Only the last chunk can be incomplete.", ("position", positions.back()));
+
+            positions.push_back(pos);
+            pos = end;
+        }
+
+        if (pos != data_size)
+        {
+            wlog("Compressed block log ends with incomplete chunk, truncating it from ${p}", ("p", pos));
+            fc::resize_file(block_file, pos);
+        }
+
+        return positions;
+    }
+
+    uint64_t chunk_end(uint64_t pos, const compressed_chunk_header& chunk_header) const
+    {
+        return pos + fc::raw::pack_size(chunk_header) + chunk_header.compressed_size;
+    }
+
+    compressed_chunk_header read_chunk_header(uint64_t pos)
+    {
+        compressed_chunk_header chunk_header;
+        block_stream.seekg(pos);
+        fc::raw::unpack(block_stream, chunk_header);
+        return chunk_header;
+    }
+
+    block_chunk read_chunk(uint64_t pos)
+    {
+        auto chunk_header = read_chunk_header(pos);
+
+        std::vector<char> compressed(chunk_header.compressed_size);
+        block_stream.read(compressed.data(), compressed.size());
+
+        return decompress_chunk(chunk_header, compressed);
+    }
+
+    const block_chunk& get_chunk(uint64_t chunk_num)
+    {
+        if (chunk_num == chunk_positions.size())
+            return tail;
+
+        if (cached_chunk_num != chunk_num)
+        {
+            cached_chunk = read_chunk(chunk_positions[chunk_num]);
+            cached_chunk_num = chunk_num;
+        }
+
+        return cached_chunk;
+    }
+
+    void append(uint32_t block_num, const char* data, size_t size)
+    {
+        FC_ASSERT(block_num == head_block_num() + 1, "Append to compressed block log occuring at wrong block.",
+                  ("block_num", block_num)("expected", head_block_num() + 1));
+
+        tail.offsets.push_back((uint32_t)tail.blocks.size());
+        tail.blocks.insert(tail.blocks.end(), data, data + size);
+        tail_changed = true;
+
+        if (tail.size() == header.blocks_per_chunk)
+        {
+            uint64_t end = write_tail();
+
+            chunk_positions.push_back(tail_pos);
+            tail_pos = end;
+            tail = block_chunk();
+            tail_written = false;
+            tail_changed = false;
+        }
+    }
+
+    void flush()
+    {
+        if (tail_changed && tail.size() > 0)
+        {
+            write_tail();
+            tail_written = true;
+        }
+        tail_changed = false;
+    }
+
+    /// @returns end of the written chunk
+    uint64_t write_tail()
+    {
+        if (tail_written)
+        {
+            fc::resize_file(block_file, tail_pos);
+            fc::resize_file(index_file, sizeof(uint64_t) * chunk_positions.size());
+            tail_written = false;
+        }
+
+        compressed_chunk_header chunk_header;
+        auto compressed = compress_chunk(tail, chunk_header);
+        auto packed_header = fc::raw::pack(chunk_header);
+
+        {
+            std::ofstream out;
+            out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            out.open(block_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app);
+            out.write(packed_header.data(), packed_header.size());
+            out.write(compressed.data(), compressed.size());
+        }
+        {
+            std::ofstream out;
+            out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            out.open(index_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app);
+            out.write((const char*)&tail_pos, sizeof(tail_pos));
+        }
+
+        return chunk_end(tail_pos, chunk_header);
+    }
+};
+}
+
+compressed_block_log::compressed_block_log()
+    : my(new detail::compressed_block_log_impl())
+{
+}
+
+compressed_block_log::~compressed_block_log()
+{
+    try
+    {
+        if (is_open())
+            flush();
+    }
+    catch (const fc::exception& e)
+    {
+        elog("Failed to flush compressed block log: ${e}", ("e", e.to_detail_string()));
+    }
+    catch (const std::exception& e)
+    {
+        elog("Failed to flush compressed block log: ${e}", ("e", e.what()));
+    }
+    catch (...)
+    {
+        elog("Failed to flush compressed block log");
+    }
+}
+
+void compressed_block_log::open(const fc::path& file, uint32_t blocks_per_chunk)
+{
+    try
+    {
+        close();
+
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->open(file, blocks_per_chunk);
+    }
+    FC_CAPTURE_AND_RETHROW((file)(blocks_per_chunk))
+}
+
+void compressed_block_log::close()
+{
+    if (is_open())
+        flush();
+
+    my.reset(new detail::compressed_block_log_impl());
+}
+
+bool compressed_block_log::is_open() const
+{
+    return my->block_stream.is_open();
+}
+
+fc::path compressed_block_log::block_log_index_path(const fc::path& file)
+{
+    return fc::path(file.generic_string() + ".index");
+}
+
+void compressed_block_log::append(const signed_block& b)
+{
+    auto data = fc::raw::pack(b);
+    append(b.block_num(), data.data(), data.size());
+}
+
+void compressed_block_log::append(uint32_t block_num, const char* data, size_t size)
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->append(block_num, data, size);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+void compressed_block_log::flush()
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->flush();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+optional<signed_block> compressed_block_log::read_block_by_num(uint32_t block_num) const
+{
+    try
+    {
+        optional<signed_block> b;
+
+        std::lock_guard<std::mutex> lock(my->mutex);
+        if (block_num == 0 || block_num > my->head_block_num())
+            return b;
+
+        const auto& chunk = my->get_chunk((block_num - 1) / my->header.blocks_per_chunk);
+        auto packed = chunk.block((block_num - 1) % my->header.blocks_per_chunk);
+
+        fc::datastream<const char*> ds(packed.first, packed.second);
+        b = signed_block();
+        fc::raw::unpack(ds, *b);
+
+        FC_ASSERT(b->block_num() == block_num, "Wrong block was read from compressed block log.",
+                  ("returned", b->block_num())("expected", block_num));
+        return b;
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+uint32_t compressed_block_log::head_block_num() const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+    return my->head_block_num();
+}
+
+uint32_t compressed_block_log::blocks_per_chunk() const
+{
+    return my->header.blocks_per_chunk;
+}
+
+uint32_t compressed_block_log::convert(const fc::path& legacy_block_log,
+                                       const fc::path& file,
+                                       uint32_t blocks_per_chunk)
+{
+    try
+    {
+        FC_ASSERT(!fc::exists(file), "Compressed block log already exists.");
+
+        block_log source;
+        source.open(legacy_block_log);
+
+        compressed_block_log target;
+        target.open(file, blocks_per_chunk);
+
+        uint32_t last_block_num = source.head() ? source.head()->block_num() : 0;
+        for (uint32_t block_num = 1; block_num <= last_block_num; ++block_num)
+        {
+            // packed blocks are moved as they are, without unpacking
+            auto packed = source.read_packed_block_by_num(block_num);
+            FC_ASSERT(packed.valid(), "Block is missing in block log.", ("block_num", block_num));
+
+            target.append(block_num, packed->data(), packed->size());
+        }
+
+        target.close();
+
+        return last_block_num;
+    }
+    FC_CAPTURE_AND_RETHROW((legacy_block_log)(file)(blocks_per_chunk))
+}
+}
+} // scorum::chain
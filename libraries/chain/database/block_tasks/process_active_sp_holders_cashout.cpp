@@ -17,6 +17,8 @@ void process_active_sp_holders_cashout::on_apply(block_task_context& ctx)
     account_service_i::account_refs_type accounts = account_service.get_by_cashout_time(dgp_service.head_block_time());
     for (const account_object& account : accounts)
     {
+        account_service.settle_active_sp_holders_reward(account);
+
         auto reward_scr = account.active_sp_holders_pending_scr_reward;
         if (reward_scr.amount > 0)
         {
@@ -62,6 +62,8 @@ void process_funds::on_apply(block_task_context& ctx)
 
     debug_log(ctx.get_block_info(), "process_funds BEGIN");
 
+    expire_active_sp_holders();
+
     // We don't have inflation.
     // We just get per block reward from original reward fund(4.8M SP)
     // and expect that after initial supply is handed out(fund budget is over) reward budgets will be created by our
@@ -186,10 +188,76 @@ void process_funds::distribute_witness_reward(const asset& witness_reward)
         _virt_op_emitter.push_virtual_operation(producer_reward_operation(witness.name, witness_reward));
 }
 
+void process_funds::expire_active_sp_holders()
+{
+    const auto& accumulator = _dprops_service.get().active_sp_holders_reward;
+    if (!accumulator.enabled)
+        return;
+
+    auto head_time = _dprops_service.head_block_time();
+
+    // voting power of these accounts has been restored since the previous pass
+    auto expired = _account_service.get_by_voting_power_restoring_time(accumulator.last_expiration_time, head_time);
+    for (const account_object& account : expired)
+    {
+        _account_service.leave_active_sp_holders_reward_pool(account);
+    }
+
+    // everybody has been settled, return rounding remainder to the activity fund
+    if (accumulator.total_weight == 0)
+    {
+        pay_activity_reward(accumulator.scr_pool);
+        pay_activity_reward(accumulator.sp_pool);
+    }
+
+    _dprops_service.update([&](dynamic_global_property_object& p) {
+        if (p.active_sp_holders_reward.total_weight == 0)
+        {
+            p.active_sp_holders_reward.scr_pool.amount = 0;
+            p.active_sp_holders_reward.sp_pool.amount = 0;
+        }
+        p.active_sp_holders_reward.last_expiration_time = head_time;
+    });
+}
+
+void process_funds::accumulate_active_sp_holders_reward(const asset& total_reward)
+{
+    const auto& accumulator = _dprops_service.get().active_sp_holders_reward;
+
+    if (accumulator.total_weight <= 0)
+    {
+        // put undistributed money in special fund
+        pay_activity_reward(total_reward);
+        return;
+    }
+
+    fc::uint128_t reward_per_share = fc::uint128_t(total_reward.amount.value)
+        * fc::uint128_t(SCORUM_ACTIVE_SP_HOLDERS_REWARD_PRECISION) / fc::uint128_t(accumulator.total_weight.value);
+
+    _dprops_service.update([&](dynamic_global_property_object& p) {
+        if (total_reward.symbol() == SCORUM_SYMBOL)
+        {
+            p.active_sp_holders_reward.scr_reward_per_share += reward_per_share;
+            p.active_sp_holders_reward.scr_pool += total_reward;
+        }
+        else
+        {
+            p.active_sp_holders_reward.sp_reward_per_share += reward_per_share;
+            p.active_sp_holders_reward.sp_pool += total_reward;
+        }
+    });
+}
+
 void process_funds::distribute_active_sp_holders_reward(const asset& reward)
 {
     asset total_reward = get_activity_reward(reward);
 
+    if (_dprops_service.get().active_sp_holders_reward.enabled)
+    {
+        accumulate_active_sp_holders_reward(total_reward);
+        return;
+    }
+
     asset distributed_reward = asset(0, reward.symbol());
 
     auto active_sp_holders_array = _account_service.get_active_sp_holders();
@@ -20,9 +20,12 @@
 #include <scorum/chain/util/asset.hpp>
 
 #include <scorum/chain/shared_db_merkle.hpp>
+#include <scorum/chain/block_replay_pipeline.hpp>
+#include <scorum/chain/async_block_stream.hpp>
 #include <scorum/chain/operation_notification.hpp>
 
 #include <scorum/chain/database/database.hpp>
+#include <scorum/chain/database/invariants_tracker.hpp>
 #include <scorum/chain/database_exceptions.hpp>
 #include <scorum/chain/db_with.hpp>
 
@@ -46,6 +49,7 @@
 #include <scorum/chain/schema/bet_objects.hpp>
 #include <scorum/chain/schema/game_object.hpp>
 #include <scorum/chain/schema/nft_object.hpp>
+#include <scorum/chain/schema/invariant_totals_object.hpp>
 
 #include <scorum/chain/services/account.hpp>
 #include <scorum/chain/services/atomicswap.hpp>
@@ -108,6 +112,8 @@
 #include <scorum/chain/betting/betting_matcher.hpp>
 #include <scorum/chain/betting/betting_resolver.hpp>
 
+#include <scorum/utils/thread_pool.hpp>
+
 namespace scorum {
 namespace chain {
 
@@ -119,6 +125,10 @@ public:
     database& _self;
     evaluator_registry<operation> _evaluator_registry;
     genesis_persistent_state_type _genesis_persistent_state;
+    invariants_tracker _invariants_tracker;
+
+    signature_keys_cache _signature_keys_cache;
+    utils::thread_pool _signature_workers;
 
     betting_service_i& get_betting_service()
     {
@@ -144,6 +154,7 @@ private:
 database_impl::database_impl(database& self)
     : _self(self)
     , _evaluator_registry(self)
+    , _invariants_tracker(static_cast<dba::db_index&>(self))
     // TODO: using boost::di to avoid these explicit calls
     , _betting_service(_self.account_service(),
                        static_cast<database_virtual_operations_emmiter_i&>(_self),
@@ -172,6 +183,8 @@ database::database(uint32_t options)
     , db_accessor_factory(static_cast<dba::db_index&>(*this))
     , _my(new database_impl(*this))
     , _options(options)
+    , _pre_apply_operation_signals(operation::count())
+    , _post_apply_operation_signals(operation::count())
 {
 }
 
@@ -185,6 +198,16 @@ fc::path database::block_log_path(const fc::path& data_dir)
     return data_dir / "block_log";
 }
 
+fc::path database::comment_content_path(const fc::path& data_dir)
+{
+    return data_dir / "comment_content";
+}
+
+fc::path database::comment_content_snapshot_path(const fc::path& snapshot_file)
+{
+    return fc::path(snapshot_file.generic_string() + ".content");
+}
+
 uint32_t database::get_reindex_skip_flags() const
 {
     uint32_t skip_flags = database::skip_witness_signature;
@@ -205,6 +228,16 @@ void database::open(const fc::path& data_dir,
                     uint64_t shared_file_size,
                     uint32_t chainbase_flags,
                     const genesis_state_type& genesis_state)
+{
+    _open(data_dir, shared_mem_dir, shared_file_size, chainbase_flags, genesis_state, optional<fc::path>());
+}
+
+void database::_open(const fc::path& data_dir,
+                     const fc::path& shared_mem_dir,
+                     uint64_t shared_file_size,
+                     uint32_t chainbase_flags,
+                     const genesis_state_type& genesis_state,
+                     const optional<fc::path>& snapshot_file)
 {
     try
     {
@@ -220,7 +253,9 @@ void database::open(const fc::path& data_dir,
 
         if (chainbase_flags & chainbase::database::read_write)
         {
-            if (!find<dynamic_global_property_object>())
+            if (snapshot_file.valid())
+                with_write_lock([&]() { load_state_snapshot(*snapshot_file, genesis_state); });
+            else if (!find<dynamic_global_property_object>())
                 with_write_lock([&]() { init_genesis(genesis_state); });
 
             if (!fc::exists(data_dir))
@@ -229,6 +264,7 @@ void database::open(const fc::path& data_dir,
             }
 
             _block_log.open(block_log_path(data_dir));
+            _comment_content_store.open(comment_content_path(data_dir));
 
             auto log_head = _block_log.head();
 
@@ -242,6 +278,11 @@ void database::open(const fc::path& data_dir,
                               ("rev", item.revision())("head_block", head_block_num()));
                 });
 
+                // totals are counted by a full scan here on the first open of a new state (after init_genesis) or
+                // of a state created by older versions, they are tracked from this block on
+                if (!_my->_invariants_tracker.is_tracking())
+                    _my->_invariants_tracker.reset();
+
                 validate_invariants();
             });
 
@@ -252,15 +293,20 @@ void database::open(const fc::path& data_dir,
                 FC_ASSERT(head_block.valid() && head_block->id() == head_block_id(),
                           "Chain state does not match block log. Reindex blockchain.");
 
-                _fork_db.start_block(*head_block);
+                _fork_db.start_block(make_immutable_block(std::move(*head_block)));
             }
         }
+        else if (fc::exists(comment_content_path(data_dir)))
+        {
+            _comment_content_store.open(comment_content_path(data_dir), true);
+        }
 
         try
         {
             const auto& chain_id = get<chain_property_object>().chain_id;
             FC_ASSERT(genesis_state.initial_chain_id == chain_id,
                       "Current chain id is not equal initial chain id = ${id}", ("id", chain_id));
+            _chain_id = chain_id;
         }
         catch (fc::exception& err)
         {
@@ -281,6 +327,118 @@ void database::open(const fc::path& data_dir,
     FC_CAPTURE_LOG_AND_RETHROW((data_dir)(shared_mem_dir)(shared_file_size))
 }
 
+void database::import_state_snapshot(const fc::path& snapshot_file,
+                                     const fc::path& data_dir,
+                                     const fc::path& shared_mem_dir,
+                                     uint64_t shared_file_size,
+                                     const genesis_state_type& genesis_state)
+{
+    try
+    {
+        ilog("Importing state snapshot ${f}", ("f", snapshot_file));
+
+        auto start = fc::time_point::now();
+
+        wipe(data_dir, shared_mem_dir, false);
+
+        // comments refer to the content store of the exporting node
+        const auto content_file = comment_content_snapshot_path(snapshot_file);
+        FC_ASSERT(fc::exists(content_file), "Comment content ${f} of the state snapshot does not exist",
+                  ("f", content_file));
+
+        fc::create_directories(data_dir);
+        fc::copy(content_file, comment_content_path(data_dir));
+
+        _open(data_dir, shared_mem_dir, shared_file_size, chainbase::database::read_write, genesis_state,
+              snapshot_file);
+
+        auto end = fc::time_point::now();
+        ilog("Done importing state snapshot at block ${n}, elapsed time: ${t} sec",
+             ("n", head_block_num())("t", double((end - start).count()) / 1000000.0));
+    }
+    FC_CAPTURE_AND_RETHROW((snapshot_file)(data_dir)(shared_mem_dir)(shared_file_size))
+}
+
+void database::load_state_snapshot(const fc::path& snapshot_file, const genesis_state_type& genesis_state)
+{
+    FC_ASSERT(!find<dynamic_global_property_object>(), "State snapshot can be loaded to the empty database only");
+
+    state_snapshot_reader reader(snapshot_file);
+
+    const auto header = reader.read_header();
+
+    FC_ASSERT(header.magic == state_snapshot_magic, "${f} is not a state snapshot", ("f", snapshot_file));
+    FC_ASSERT(header.version == state_snapshot_version, "Unsupported version ${v} of the state snapshot",
+              ("v", header.version));
+    FC_ASSERT(header.chain_id == genesis_state.initial_chain_id, "State snapshot is made for other chain ${id}",
+              ("id", header.chain_id));
+
+    std::map<uint16_t, const index_snapshot_handler*> handlers;
+    for (const auto& handler : _index_snapshot_handlers)
+        handlers[handler.type_id] = &handler;
+
+    FC_ASSERT(header.indices_count == handlers.size(),
+              "State snapshot has ${n} indices, but ${m} are registered. "
+              "Enable the same plugins as the exporting node.",
+              ("n", header.indices_count)("m", handlers.size()));
+
+    for (uint32_t i = 0; i < header.indices_count; ++i)
+    {
+        const auto index_header = reader.begin_index();
+
+        auto it = handlers.find(index_header.type_id);
+        FC_ASSERT(it != handlers.end() && it->second->type_name == index_header.type_name,
+                  "Index of ${t} is not registered. Enable the same plugins as the exporting node.",
+                  ("t", index_header.type_name));
+
+        it->second->read(reader, index_header);
+        handlers.erase(it);
+
+        ilog("Loaded ${n} objects of ${t}", ("n", index_header.objects_count)("t", index_header.type_name));
+    }
+
+    FC_ASSERT(head_block_num() == header.head_block_num && head_block_id() == header.head_block_id,
+              "State snapshot head block does not match the loaded state");
+
+    // there is no undo history, all indices are at the snapshot head block
+    for_each_index([&](chainbase::abstract_generic_index_i& item) { item.set_revision(header.head_block_num); });
+}
+
+void database::export_state_snapshot(const fc::path& snapshot_file)
+{
+    try
+    {
+        with_read_lock([&]() {
+            ilog("Exporting state snapshot at block ${n} to ${f}", ("n", head_block_num())("f", snapshot_file));
+
+            auto start = fc::time_point::now();
+
+            state_snapshot_header header;
+            header.magic = state_snapshot_magic;
+            header.version = state_snapshot_version;
+            header.chain_id = get_chain_id();
+            header.head_block_num = head_block_num();
+            header.head_block_id = head_block_id();
+            header.indices_count = (uint32_t)_index_snapshot_handlers.size();
+
+            state_snapshot_writer writer(snapshot_file);
+
+            writer.write_header(header);
+            for (const auto& handler : _index_snapshot_handlers)
+                handler.write(writer);
+
+            writer.close();
+
+            _comment_content_store.copy(comment_content_snapshot_path(snapshot_file));
+
+            auto end = fc::time_point::now();
+            ilog("Done exporting state snapshot, elapsed time: ${t} sec",
+                 ("t", double((end - start).count()) / 1000000.0));
+        });
+    }
+    FC_CAPTURE_AND_RETHROW((snapshot_file))
+}
+
 void database::reindex(const fc::path& data_dir,
                        const fc::path& shared_mem_dir,
                        uint64_t shared_file_size,
@@ -304,21 +462,22 @@ void database::reindex(const fc::path& data_dir,
         ilog("Replaying ${n} blocks...", ("n", last_block_num));
 
         with_write_lock([&]() {
-            auto itr = _block_log.read_block(0);
-            while (itr.first.block_num() <= last_block_num)
+            // blocks are read and digested ahead in other threads, only applying is left for this one
+            block_replay_pipeline pipeline(block_log_path(data_dir), last_block_num);
+            pipeline.start();
+
+            while (auto replayed = pipeline.next())
             {
-                auto cur_block_num = itr.first.block_num();
+                auto cur_block_num = replayed->block.block_num();
                 if (cur_block_num % log_interval_sz == 0 || cur_block_num == last_block_num)
                 {
                     double percent = (cur_block_num * double(100)) / last_block_num;
                     ilog("${p}% applied. ${m}M free.",
                          ("p", (boost::format("%5.2f") % percent).str())("m", get_free_memory() / (1024 * 1024)));
+                    ilog("Replay stages: ${s}", ("s", pipeline.stats()));
                 }
-                apply_block(itr.first, skip_flags);
-                if (cur_block_num != last_block_num)
-                    itr = _block_log.read_block(itr.second);
-                else
-                    break;
+                apply_replayed_block(*replayed, skip_flags);
+                maybe_grow_shared_file();
             }
 
             for_each_index([&](chainbase::abstract_generic_index_i& item) { item.set_revision(head_block_num()); });
@@ -326,7 +485,7 @@ void database::reindex(const fc::path& data_dir,
 
         if (_block_log.head()->block_num())
         {
-            _fork_db.start_block(*_block_log.head());
+            _fork_db.start_block(make_immutable_block(*_block_log.head()));
         }
 
         auto end = fc::time_point::now();
@@ -339,6 +498,7 @@ void database::wipe(const fc::path& data_dir, const fc::path& shared_mem_dir, bo
 {
     close();
     chainbase::database::wipe(shared_mem_dir);
+    comment_content_store::wipe(comment_content_path(data_dir));
     if (include_blocks)
     {
         fc::path block_log_file = block_log_path(data_dir);
@@ -358,6 +518,8 @@ void database::close()
 
         try
         {
+            // the shared memory must not refer to the content that hasn't been written
+            _comment_content_store.flush();
             chainbase::database::flush();
         }
         catch (...)
@@ -366,7 +528,11 @@ void database::close()
 
         chainbase::database::close();
 
+        // indices are added again on the next open
+        _index_snapshot_handlers.clear();
+
         _block_log.close();
+        _comment_content_store.close();
 
         _fork_db.reset();
     }
@@ -493,6 +659,11 @@ optional<signed_block> database::read_block_by_number(uint32_t block_num) const
     return _block_log.read_block_by_num(block_num);
 }
 
+optional<packed_block_view> database::read_packed_block_by_number(uint32_t block_num) const
+{
+    return _block_log.read_packed_block_by_num(block_num);
+}
+
 const signed_transaction database::get_recent_transaction(const transaction_id_type& trx_id) const
 {
     try
@@ -540,6 +711,16 @@ const node_property_object& database::get_node_properties() const
     return _node_property_object;
 }
 
+comment_content_store& database::get_comment_content_store()
+{
+    return _comment_content_store;
+}
+
+const comment_content_store& database::get_comment_content_store() const
+{
+    return _comment_content_store;
+}
+
 const time_point_sec database::calculate_discussion_payout_time(const comment_object& comment) const
 {
     return comment.cashout_time;
@@ -571,21 +752,36 @@ bool database::before_last_checkpoint() const
  * @return true if we switched forks as a result of this push.
  */
 bool database::push_block(const signed_block& new_block, uint32_t skip)
+{
+    return push_block(make_immutable_block(new_block), skip);
+}
+
+bool database::push_block(const immutable_block_ptr& new_block, uint32_t skip)
 {
     // fc::time_point begin_time = fc::time_point::now();
 
-    block_info ctx(new_block);
+    block_info ctx(*new_block);
 
     debug_log(ctx, "push_block skip=${s}", ("s", skip));
 
+    recover_signature_keys(*new_block, skip);
+
     bool result;
     detail::with_skip_flags(*this, skip, [&]() {
         with_write_lock([&]() {
-            detail::without_pending_transactions(*this, std::move(_pending_tx), [&]() {
+            // the expired transactions would be only applied again to fail on the new head block
+            size_t expired_tx_count = _pending_tx.remove_expired(new_block->timestamp);
+            if (expired_tx_count > 0)
+                dlog("Dropping ${n} expired pending transactions", ("n", expired_tx_count));
+
+            detail::without_pending_transactions(*this, _pending_tx.release(), [&]() {
                 try
                 {
                     result = _push_block(new_block);
                     debug_log(ctx, "push_block resut=${r}", ("r", result));
+
+                    // pending transactions and their session are cleared here
+                    maybe_grow_shared_file();
                 }
                 FC_CAPTURE_AND_RETHROW(((std::string)ctx))
             });
@@ -599,6 +795,81 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
     return result;
 }
 
+void database::recover_signature_keys(const signed_block& b, uint32_t skip)
+{
+    const bool check_witness_signature = !(skip & skip_witness_signature);
+    const bool check_transaction_signatures = !(skip & (skip_transaction_signatures | skip_authority_check));
+
+    auto& keys_cache = _my->_signature_keys_cache;
+    auto& workers = _my->_signature_workers;
+
+    std::vector<std::future<void>> recovered;
+
+    if (check_witness_signature)
+    {
+        recovered.push_back(workers.post([&]() { b.signee(keys_cache); }));
+    }
+
+    if (check_transaction_signatures)
+    {
+        const auto chain_id = _chain_id;
+        for (const auto& trx : b.transactions)
+        {
+            recovered.push_back(workers.post([&, chain_id]() { trx.get_signature_keys(chain_id, keys_cache); }));
+        }
+    }
+
+    // errors are ignored here, they are reported by the checks under the write lock
+    for (auto& r : recovered)
+        r.wait();
+}
+
+void database::prevalidate_block(const immutable_block_ptr& b, uint32_t skip)
+{
+    const bool check_witness_signature = !(skip & skip_witness_signature);
+    const bool check_transaction_signatures = !(skip & (skip_transaction_signatures | skip_authority_check));
+
+    if (!check_witness_signature && !check_transaction_signatures)
+        return;
+
+    auto& keys_cache = _my->_signature_keys_cache;
+    const auto chain_id = _chain_id;
+
+    // one task per block, blocks of the run are recovered in parallel
+    _my->_signature_workers.post([=, &keys_cache]() {
+        try
+        {
+            if (check_witness_signature)
+                b->signee(keys_cache);
+
+            if (check_transaction_signatures)
+            {
+                for (const auto& trx : b->transactions)
+                    trx.get_signature_keys(chain_id, keys_cache);
+            }
+        }
+        catch (...)
+        {
+            // reported by push_block
+        }
+    });
+}
+
+void database::recover_signature_keys(const signed_transaction& trx, uint32_t skip)
+{
+    if (skip & (skip_transaction_signatures | skip_authority_check))
+        return;
+
+    try
+    {
+        trx.get_signature_keys(_chain_id, _my->_signature_keys_cache);
+    }
+    catch (...)
+    {
+        // reported by verify_authority under the write lock
+    }
+}
+
 void database::_maybe_warn_multiple_production(uint32_t height) const
 {
     auto blocks = _fork_db.fetch_block_by_number(height);
@@ -617,8 +888,10 @@ void database::_maybe_warn_multiple_production(uint32_t height) const
     return;
 }
 
-bool database::_push_block(const signed_block& new_block)
+bool database::_push_block(const immutable_block_ptr& new_block_ptr)
 {
+    const immutable_block& new_block = *new_block_ptr;
+
     block_info ctx(new_block);
 
     debug_log(ctx, "_push_block");
@@ -630,7 +903,7 @@ bool database::_push_block(const signed_block& new_block)
 
         if (!(skip & skip_fork_db))
         {
-            std::shared_ptr<fork_item> new_head = _fork_db.push_block(new_block);
+            std::shared_ptr<fork_item> new_head = _fork_db.push_block(new_block_ptr);
 
             debug_log(ctx, "new_head_block=${b}", ("b", (std::string)block_info(new_head->data)));
 
@@ -758,8 +1031,15 @@ void database::push_transaction(const signed_transaction& trx, uint32_t skip)
             FC_ASSERT(
                 trx_size
                 <= (obtain_service<dbs_dynamic_global_property>().get().median_chain_props.maximum_block_size - 256));
+            recover_signature_keys(trx, skip);
+
             set_producing(true);
-            detail::with_skip_flags(*this, skip, [&]() { with_write_lock([&]() { _push_transaction(trx); }); });
+            detail::with_skip_flags(*this, skip, [&]() {
+                with_write_lock([&]() {
+                    apply_pending_transaction(trx, trx_size);
+                    notify_on_pending_transaction(trx);
+                });
+            });
             set_producing(false);
         }
         catch (...)
@@ -772,6 +1052,14 @@ void database::push_transaction(const signed_transaction& trx, uint32_t skip)
 }
 
 void database::_push_transaction(const signed_transaction& trx)
+{
+    apply_pending_transaction(trx, fc::raw::pack_size(trx));
+
+    // notify anyone listening to pending transactions
+    notify_on_pending_transaction(trx);
+}
+
+void database::apply_pending_transaction(const signed_transaction& trx, size_t trx_size)
 {
     // If this is the first transaction pushed after applying a block, start a new undo session.
     // This allows us to quickly rewind to the clean state of the head block, in case a new block arrives.
@@ -787,14 +1075,30 @@ void database::_push_transaction(const signed_transaction& trx)
 
     auto temp_session = start_undo_session();
     _apply_transaction(trx);
-    _pending_tx.push_back(trx);
+    _pending_tx.push(trx, trx_size);
 
     // The transaction applied successfully. Merge its changes into the pending block session.
     for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
     temp_session->push();
+}
 
-    // notify anyone listening to pending transactions
-    notify_on_pending_transaction(trx);
+void database::rebuild_pending_state()
+{
+    auto pending = _pending_tx.release();
+
+    _pending_tx_session.reset();
+
+    for (const signed_transaction& tx : pending)
+    {
+        try
+        {
+            apply_pending_transaction(tx, fc::raw::pack_size(tx));
+        }
+        catch (const fc::exception&)
+        {
+            // Do nothing, transaction will not be re-applied
+        }
+    }
 }
 
 signed_block database::generate_block(fc::time_point_sec when,
@@ -847,74 +1151,41 @@ signed_block database::_generate_block(fc::time_point_sec when,
     auto maximum_block_size = obtain_service<dbs_dynamic_global_property>()
                                   .get()
                                   .median_chain_props.maximum_block_size; // SCORUM_MAX_BLOCK_SIZE;
-    size_t total_block_size = max_block_header_size;
 
     signed_block pending_block;
 
     with_write_lock([&]() {
         //
-        // The following code throws away existing pending_tx_session and
-        // rebuilds it by re-applying pending transactions.
+        // The pending state is the result of applying pending transactions in order on the head block. The block
+        // time doesn't change their semantics (they are evaluated with the head block time), so the prefix of
+        // the pool is taken as is. The pending state is rebuilt only when some transaction has expired by the time
+        // of the block or the pending session has been lost.
         //
-        // This rebuild is necessary because pending transactions' validity
-        // and semantics may have changed since they were received, because
-        // time-based semantics are evaluated based on the current block
-        // time.  These changes can only be reflected in the database when
-        // the value of the "when" variable is known, which means we need to
-        // re-apply pending transactions in this method.
-        //
-        _pending_tx_session.reset();
-        _pending_tx_session = start_undo_session();
-
-        uint64_t postponed_tx_count = 0;
-        // pop pending state (reset to head block state)
-        for (const signed_transaction& tx : _pending_tx)
+        size_t expired_tx_count = _pending_tx.remove_expired(when);
+        if (expired_tx_count > 0 || (!_pending_tx.empty() && !_pending_tx_session.valid()))
         {
-            // Only include transactions that have not expired yet for currently generating block,
-            // this should clear problem transactions and allow block production to continue
-
-            if (tx.expiration < when)
-            {
-                continue;
-            }
+            dlog("Rebuilding pending state without ${n} expired transactions", ("n", expired_tx_count));
+            rebuild_pending_state();
+        }
 
-            uint64_t new_total_size = total_block_size + fc::raw::pack_size(tx);
+        size_t included_tx_count = _pending_tx.get_prefix_size(max_block_header_size, maximum_block_size);
 
-            // postpone transaction if it would make block too big
-            if (new_total_size >= maximum_block_size)
-            {
-                postponed_tx_count++;
-                continue;
-            }
-
-            try
-            {
-                auto temp_session = start_undo_session();
-                _apply_transaction(tx);
-                for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
-                temp_session->push();
+        const auto& entries = _pending_tx.entries();
+        pending_block.transactions.reserve(included_tx_count);
+        for (size_t i = 0; i < included_tx_count; ++i)
+            pending_block.transactions.push_back(entries[i].trx);
 
-                total_block_size += fc::raw::pack_size(tx);
-                pending_block.transactions.push_back(tx);
-            }
-            catch (const fc::exception& e)
-            {
-                // Do nothing, transaction will not be re-applied
-                // wlog( "Transaction was not processed while generating block due to ${e}", ("e", e) );
-                // wlog( "The transaction was ${t}", ("t", tx) );
-            }
-        }
-        if (postponed_tx_count > 0)
+        if (included_tx_count < entries.size())
         {
-            wlog("Postponed ${n} transactions due to block size limit", ("n", postponed_tx_count));
+            wlog("Postponed ${n} transactions due to block size limit", ("n", entries.size() - included_tx_count));
         }
 
+        // pop pending state (reset to head block state)
         _pending_tx_session.reset();
     });
 
     // We have temporarily broken the invariant that
-    // _pending_tx_session is the result of applying _pending_tx, as
-    // _pending_tx now consists of the set of postponed transactions.
+    // _pending_tx_session is the result of applying _pending_tx.
     // However, the push_block() call below will re-create the
     // _pending_tx_session.
 
@@ -1000,6 +1271,8 @@ void database::pop_block()
 
         _popped_tx.insert(_popped_tx.begin(), head_block->transactions.begin(), head_block->transactions.end());
 
+        notify_popped_block(*head_block);
+
         debug_log(ctx, "pop_block result");
     }
     FC_CAPTURE_AND_RETHROW(((std::string)ctx))
@@ -1019,11 +1292,46 @@ void database::clear_pending()
 void database::notify_pre_apply_operation(const operation_notification& note)
 {
     SCORUM_TRY_NOTIFY(pre_apply_operation, note);
+    notify_operation_signal(_pre_apply_operation_signals, note);
 }
 
 void database::notify_post_apply_operation(const operation_notification& note)
 {
     SCORUM_TRY_NOTIFY(post_apply_operation, note);
+    notify_operation_signal(_post_apply_operation_signals, note);
+}
+
+database::operation_signal_type& database::get_operation_signal(operation_signals_type& signals, int which)
+{
+    FC_ASSERT(which >= 0 && (size_t)which < signals.size(), "Unknown operation tag ${w}", ("w", which));
+
+    auto& signal = signals[which];
+    if (!signal)
+        signal.reset(new operation_signal_type());
+
+    return *signal;
+}
+
+void database::notify_operation_signal(const operation_signals_type& signals, const operation_notification& note)
+{
+    const auto& signal = signals[note.op.which()];
+    if (signal)
+    {
+        SCORUM_TRY_NOTIFY((*signal), note);
+    }
+}
+
+bool database::is_observed(const operation_signals_type& signals, int which)
+{
+    const auto& signal = signals[which];
+    return signal && !signal->empty();
+}
+
+bool database::is_operation_observed(const operation& op) const
+{
+    return !pre_apply_operation.empty() || !post_apply_operation.empty()
+        || is_observed(_pre_apply_operation_signals, op.which())
+        || is_observed(_post_apply_operation_signals, op.which());
 }
 
 operation_notification database::create_notification(const operation& op) const
@@ -1037,6 +1345,9 @@ inline void database::push_virtual_operation(const operation& op)
     {
         FC_ASSERT(is_virtual_operation(op));
 
+        if (!is_operation_observed(op))
+            return;
+
         auto note = create_notification(op);
 
         operation_info ctx(op);
@@ -1053,6 +1364,9 @@ inline void database::push_hf_operation(const operation& op)
 {
     FC_ASSERT(is_virtual_operation(op));
 
+    if (!is_operation_observed(op))
+        return;
+
     auto note = create_notification(op);
     notify_pre_apply_operation(note);
     notify_post_apply_operation(note);
@@ -1068,6 +1382,34 @@ void database::notify_applied_block(const signed_block& block)
     SCORUM_TRY_NOTIFY(applied_block, block)
 }
 
+void database::notify_popped_block(const signed_block& block)
+{
+    SCORUM_TRY_NOTIFY(popped_block, block)
+}
+
+std::map<std::string, uint32_t> database::get_async_streams_lag() const
+{
+    std::map<std::string, uint32_t> result;
+
+    std::lock_guard<std::mutex> lock(_async_streams_mutex);
+    for (const auto* stream : _async_streams)
+        result[stream->name()] = stream->lag();
+
+    return result;
+}
+
+void database::register_async_stream(const async_block_stream& stream)
+{
+    std::lock_guard<std::mutex> lock(_async_streams_mutex);
+    _async_streams.insert(&stream);
+}
+
+void database::unregister_async_stream(const async_block_stream& stream)
+{
+    std::lock_guard<std::mutex> lock(_async_streams_mutex);
+    _async_streams.erase(&stream);
+}
+
 void database::notify_on_pending_transaction(const signed_transaction& tx)
 {
     SCORUM_TRY_NOTIFY(on_pending_transaction, tx)
@@ -1394,6 +1736,8 @@ void database::initialize_indexes()
     add_index<nft_index>();
     add_index<game_round_index>();
 
+    add_index<invariant_totals_index>();
+
     _plugin_index_signal();
 }
 
@@ -1411,11 +1755,93 @@ void database::set_flush_interval(uint32_t flush_blocks)
     _next_flush_block = 0;
 }
 
+void database::set_invariants_audit_interval(uint32_t audit_blocks)
+{
+    _invariants_audit_blocks = audit_blocks;
+}
+
+void database::set_shared_file_growth(uint64_t free_threshold, uint64_t grow_step)
+{
+    _shared_file_free_threshold = free_threshold;
+    _shared_file_grow_step = grow_step;
+}
+
+void database::set_pending_transactions_priority(pending_transactions_pool::priority_type priority)
+{
+    _pending_tx.set_priority(priority);
+}
+
 //////////////////// private methods ////////////////////
 
+void database::apply_replayed_block(const replayed_block& replayed, uint32_t skip)
+{
+    _replayed_block = &replayed;
+    try
+    {
+        apply_block(replayed.block, skip);
+    }
+    catch (...)
+    {
+        _replayed_block = nullptr;
+        throw;
+    }
+    _replayed_block = nullptr;
+}
+
+void database::apply_block(const immutable_block& next_block, uint32_t skip)
+{
+    _immutable_block = &next_block;
+    try
+    {
+        apply_block(static_cast<const signed_block&>(next_block), skip);
+    }
+    catch (...)
+    {
+        _immutable_block = nullptr;
+        throw;
+    }
+    _immutable_block = nullptr;
+}
+
+block_id_type database::get_block_id(const signed_block& b) const
+{
+    if (_replayed_block && &_replayed_block->block == &b)
+        return _replayed_block->block_id;
+
+    if (_immutable_block && _immutable_block == &b)
+        return _immutable_block->id();
+
+    return b.id();
+}
+
+uint32_t database::get_block_size(const signed_block& b) const
+{
+    if (_replayed_block && &_replayed_block->block == &b)
+        return _replayed_block->block_size;
+
+    if (_immutable_block && _immutable_block == &b)
+        return _immutable_block->packed_size();
+
+    return fc::raw::pack_size(b);
+}
+
+transaction_id_type database::get_transaction_id(const signed_transaction& trx) const
+{
+    if (_replayed_block && _current_trx_in_block < _replayed_block->transaction_ids.size()
+        && &_replayed_block->block.transactions[_current_trx_in_block] == &trx)
+        return _replayed_block->transaction_ids[_current_trx_in_block];
+
+    return trx.id();
+}
+
+block_info database::get_block_info(const signed_block& b) const
+{
+    return block_info(b.block_num(), get_block_id(b).str(), b.timestamp, b.witness);
+}
+
 void database::apply_block(const signed_block& next_block, uint32_t skip)
 {
-    block_info ctx(next_block);
+    block_info ctx = get_block_info(next_block);
 
     debug_log(ctx, "apply_block skip=${s}", ("s", skip));
 
@@ -1428,8 +1854,8 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
         {
             auto itr = _checkpoints.find(block_num);
             if (itr != _checkpoints.end())
-                FC_ASSERT(next_block.id() == itr->second, "Block did not match checkpoint",
-                          ("checkpoint", *itr)("block_id", next_block.id()));
+                FC_ASSERT(get_block_id(next_block) == itr->second, "Block did not match checkpoint",
+                          ("checkpoint", *itr)("block_id", get_block_id(next_block)));
 
             if (_checkpoints.rbegin()->first >= block_num)
                 skip = skip_witness_signature | skip_transaction_signatures | skip_transaction_dupe_check | skip_fork_db
@@ -1447,7 +1873,10 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
         {
             try
             {
-                validate_invariants();
+                if (_invariants_audit_blocks != 0 && block_num % _invariants_audit_blocks == 0)
+                    validate_invariants();
+                else
+                    validate_tracked_invariants();
             }
 #ifdef DEBUG
             FC_CAPTURE_AND_RETHROW(((std::string)ctx));
@@ -1481,6 +1910,7 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
             {
                 _next_flush_block = 0;
                 // ilog( "Flushing database shared memory at block ${b}", ("b", block_num) );
+                _comment_content_store.flush();
                 chainbase::database::flush();
             }
         }
@@ -1512,9 +1942,38 @@ void database::show_free_memory(bool force)
     }
 }
 
+void database::maybe_grow_shared_file()
+{
+    if (_shared_file_grow_step == 0)
+        return;
+
+    const auto free_memory = get_free_memory();
+    if (free_memory >= _shared_file_free_threshold)
+        return;
+
+    auto start = fc::time_point::now();
+
+    if (!grow(_shared_file_grow_step))
+    {
+        if (head_block_num() % 10 == 0)
+        {
+            wlog("Shared memory file can't be grown while it's opened by read only processes, free memory is ${f}M",
+                 ("f", free_memory / (1024 * 1024)));
+        }
+        return;
+    }
+
+    ilog("Shared memory file has been grown by ${s}M to ${t}M (${c} times since open) in ${e} ms, free memory was "
+         "${f}M",
+         ("s", _shared_file_grow_step / (1024 * 1024))("t", get_size() / (1024 * 1024))("c", grow_count())(
+             "e", (fc::time_point::now() - start).count() / 1000)("f", free_memory / (1024 * 1024)));
+
+    show_free_memory(true);
+}
+
 void database::_apply_block(const signed_block& next_block)
 {
-    block_info ctx(next_block);
+    block_info ctx = get_block_info(next_block);
 
     debug_log(ctx, "_apply_block");
 
@@ -1527,9 +1986,11 @@ void database::_apply_block(const signed_block& next_block)
 
         uint32_t skip = get_node_properties().skip_flags;
 
+        const bool is_replayed = _replayed_block && &_replayed_block->block == &next_block;
+
         if (!(skip & skip_merkle_check))
         {
-            auto merkle_root = next_block.calculate_merkle_root();
+            auto merkle_root = is_replayed ? _replayed_block->merkle_root : next_block.calculate_merkle_root();
 
             try
             {
@@ -1559,7 +2020,7 @@ void database::_apply_block(const signed_block& next_block)
         _current_trx_in_block = 0;
 
         const auto& gprops = obtain_service<dbs_dynamic_global_property>().get();
-        auto block_size = fc::raw::pack_size(next_block);
+        auto block_size = get_block_size(next_block);
         FC_ASSERT(block_size <= gprops.median_chain_props.maximum_block_size, "Block Size is too Big",
                   ("next_block_num", next_block_num)("block_size",
                                                      block_size)("max", gprops.median_chain_props.maximum_block_size));
@@ -1712,7 +2173,7 @@ void database::_apply_transaction(const signed_transaction& trx)
 {
     try
     {
-        _current_trx_id = trx.id();
+        _current_trx_id = get_transaction_id(trx);
         uint32_t skip = get_node_properties().skip_flags;
 
         if (!(skip & skip_validate)) /* issue #505 explains why this skip_flag is disabled */
@@ -1721,7 +2182,7 @@ void database::_apply_transaction(const signed_transaction& trx)
         }
 
         auto& trx_idx = get_index<transaction_index>();
-        auto trx_id = trx.id();
+        auto trx_id = _current_trx_id;
         // idump((trx_id)(skip&skip_transaction_dupe_check));
         FC_ASSERT((skip & skip_transaction_dupe_check)
                       || trx_idx.indices().get<by_trx_id>().find(trx_id) == trx_idx.indices().get<by_trx_id>().end(),
@@ -1741,7 +2202,8 @@ void database::_apply_transaction(const signed_transaction& trx)
 
             try
             {
-                trx.verify_authority(get_chain_id(), get_active, get_owner, get_posting, SCORUM_MAX_SIG_CHECK_DEPTH);
+                trx.verify_authority(get_chain_id(), _my->_signature_keys_cache, get_active, get_owner, get_posting,
+                                     SCORUM_MAX_SIG_CHECK_DEPTH);
             }
             catch (protocol::tx_missing_active_auth& e)
             {
@@ -1807,10 +2269,18 @@ void database::_apply_transaction(const signed_transaction& trx)
 
 void database::apply_operation(const operation& op)
 {
+    auto& evaluator = _my->_evaluator_registry.get_evaluator(op);
+
+    if (!is_operation_observed(op))
+    {
+        evaluator.apply(op);
+        return;
+    }
+
     auto note = create_notification(op);
 
     notify_pre_apply_operation(note);
-    _my->_evaluator_registry.get_evaluator(op).apply(op);
+    evaluator.apply(op);
     notify_post_apply_operation(note);
 }
 
@@ -1828,7 +2298,7 @@ const witness_object& database::validate_block_header(uint32_t skip, const signe
 
         if (!(skip & skip_witness_signature))
         {
-            FC_ASSERT(next_block.validate_signee(witness.signing_key));
+            FC_ASSERT(next_block.validate_signee(witness.signing_key, _my->_signature_keys_cache));
         }
 
         if (!(skip & skip_witness_schedule_check))
@@ -1857,7 +2327,7 @@ void database::create_block_summary(const signed_block& next_block)
     try
     {
         block_summary_id_type sid(next_block.block_num() & (uint32_t)SCORUM_BLOCKID_POOL_SIZE);
-        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = next_block.id(); });
+        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = get_block_id(next_block); });
     }
     FC_CAPTURE_AND_RETHROW()
 }
@@ -1917,7 +2387,7 @@ void database::update_global_dynamic_data(const signed_block& b)
             }
 
             dgp.head_block_number = b.block_num();
-            dgp.head_block_id = b.id();
+            dgp.head_block_id = get_block_id(b);
             dgp.time = b.timestamp;
             dgp.current_aslot += missed_blocks + 1;
         });
@@ -2103,6 +2573,10 @@ void database::init_hardforks(time_point_sec genesis_time)
     _hardfork_times[SCORUM_HARDFORK_0_7] = fc::time_point_sec(SCORUM_HARDFORK_0_7_TIME);
     _hardfork_versions[SCORUM_HARDFORK_0_7] = SCORUM_HARDFORK_0_7_VERSION;
 
+    FC_ASSERT(SCORUM_HARDFORK_0_8 == 8, "Invalid hardfork #8 configuration");
+    _hardfork_times[SCORUM_HARDFORK_0_8] = fc::time_point_sec(SCORUM_HARDFORK_0_8_TIME);
+    _hardfork_versions[SCORUM_HARDFORK_0_8] = SCORUM_HARDFORK_0_8_VERSION;
+
     const auto& hardforks = obtain_service<dbs_hardfork_property>().get();
     FC_ASSERT(hardforks.last_hardfork <= SCORUM_NUM_HARDFORKS, "Chain knows of more hardforks than configuration",
               ("hardforks.last_hardfork", hardforks.last_hardfork)("SCORUM_NUM_HARDFORKS", SCORUM_NUM_HARDFORKS));
@@ -2166,6 +2640,9 @@ void database::apply_hardfork(uint32_t hardfork)
 
     switch (hardfork)
     {
+    case SCORUM_HARDFORK_0_8:
+        account_service().enable_active_sp_holders_reward_pool();
+        break;
     default:
         break;
     }
@@ -2191,139 +2668,129 @@ void database::validate_invariants() const
 {
     try
     {
-        asset total_supply = asset(0, SCORUM_SYMBOL);
-
-        const auto& account_svc = account_service();
-        const auto& gpo = obtain_service<dbs_dynamic_global_property>().get();
-
-        const auto accounts_circulating = account_svc.accounts_circulating_capital();
-
-        total_supply += accounts_circulating.scr;
-        // following two field do not represented in global properties
-        total_supply += accounts_circulating.pending_scr;
-        total_supply += asset(accounts_circulating.pending_sp.amount, SCORUM_SYMBOL);
+        const auto totals = _my->_invariants_tracker.calculate();
 
-        /// verify no witness has too many votes
-        const auto& witness_idx = get_index<witness_index>().indices();
-        for (auto itr = witness_idx.begin(); itr != witness_idx.end(); ++itr)
+        if (_my->_invariants_tracker.is_tracking())
         {
-            FC_ASSERT(itr->votes <= gpo.total_scorumpower.amount, "${vs} > ${tvs}",
-                      ("vs", itr->votes)("tvs", gpo.total_scorumpower.amount));
+            FC_ASSERT(_my->_invariants_tracker.totals() == totals, "Tracked invariant totals do not match the state",
+                      ("tracked", _my->_invariants_tracker.totals())("calculated", totals));
         }
 
-        const auto& escrow_idx = get_index<escrow_index>().indices().get<by_id>();
-        for (auto itr = escrow_idx.begin(); itr != escrow_idx.end(); ++itr)
-        {
-            total_supply += itr->scorum_balance;
-            total_supply += itr->pending_fee;
-        }
-
-        total_supply += obtain_service<dbs_content_reward_fund_scr>().get().activity_reward_balance;
-        total_supply
-            += asset(obtain_service<dbs_content_reward_fund_sp>().get().activity_reward_balance.amount, SCORUM_SYMBOL);
-
-        auto& fifa_2018_reward_service = obtain_service<dbs_content_fifa_world_cup_2018_bounty_reward_fund>();
-        if (fifa_2018_reward_service.is_exists())
-        {
-            total_supply += asset(fifa_2018_reward_service.get().activity_reward_balance.amount, SCORUM_SYMBOL);
-        }
-
-        total_supply += asset(gpo.total_scorumpower.amount, SCORUM_SYMBOL);
-        total_supply += gpo.total_burned_scr;
-        total_supply += obtain_service<dbs_content_reward_scr>().get().balance;
-        total_supply += obtain_service<dbs_voters_reward_scr>().get().balance;
-        total_supply += obtain_service<dbs_voters_reward_sp>().get().balance.amount;
+        validate_invariants(totals);
+    }
+    FC_CAPTURE_LOG_AND_RETHROW((head_block_num()));
+}
 
-        for (const post_budget_object& budget : obtain_service<dbs_post_budget>().get_budgets())
-        {
-            total_supply += budget.balance;
-            total_supply += budget.owner_pending_income;
-            total_supply += budget.budget_pending_outgo;
-        }
+void database::validate_tracked_invariants() const
+{
+    try
+    {
+        validate_invariants(_my->_invariants_tracker.totals());
+    }
+    FC_CAPTURE_LOG_AND_RETHROW((head_block_num()));
+}
 
-        for (const banner_budget_object& budget : obtain_service<dbs_banner_budget>().get_budgets())
-        {
-            total_supply += budget.balance;
-            total_supply += budget.owner_pending_income;
-            total_supply += budget.budget_pending_outgo;
-        }
+void database::validate_invariants(const invariant_totals& totals) const
+{
+    asset total_supply = asset(0, SCORUM_SYMBOL);
 
-        if (obtain_service<dbs_fund_budget>().is_exists())
-        {
-            total_supply += obtain_service<dbs_fund_budget>().get().balance.amount;
-        }
+    const auto& gpo = obtain_service<dbs_dynamic_global_property>().get();
 
-        if (obtain_service<dbs_registration_pool>().is_exists())
-        {
-            auto& pool = obtain_service<dbs_registration_pool>().get();
-            total_supply += pool.balance;
-            total_supply += asset(pool.delegated.amount, SCORUM_SYMBOL);
-        }
+    total_supply += totals.accounts_scr;
+    // following two field do not represented in global properties
+    total_supply += totals.accounts_pending_scr;
+    total_supply += asset(totals.accounts_pending_sp.amount, SCORUM_SYMBOL);
 
-        total_supply += asset(obtain_service<dbs_dev_pool>().get().sp_balance.amount, SCORUM_SYMBOL);
-        total_supply += obtain_service<dbs_dev_pool>().get().scr_balance;
+    /// verify no witness has too many votes
+    const auto& witness_idx = get_index<witness_index, by_vote_name>();
+    if (!witness_idx.empty())
+    {
+        const auto& top_witness = *witness_idx.begin();
+        FC_ASSERT(top_witness.votes <= gpo.total_scorumpower.amount, "${vs} > ${tvs}",
+                  ("vs", top_witness.votes)("tvs", gpo.total_scorumpower.amount));
+    }
 
-        if (obtain_service<dbs_witness_reward_in_sp_migration>().is_exists())
-        {
-            total_supply += asset(obtain_service<dbs_witness_reward_in_sp_migration>().get().balance, SCORUM_SYMBOL);
-        }
+    total_supply += totals.escrows_balance;
 
-        const auto& atomicswap_contract_idx = get_index<atomicswap_contract_index, by_id>();
-        for (auto itr = atomicswap_contract_idx.begin(); itr != atomicswap_contract_idx.end(); ++itr)
-        {
-            total_supply += itr->amount;
-        }
+    total_supply += obtain_service<dbs_content_reward_fund_scr>().get().activity_reward_balance;
+    total_supply
+        += asset(obtain_service<dbs_content_reward_fund_sp>().get().activity_reward_balance.amount, SCORUM_SYMBOL);
 
-        // clang-format off
-        const auto& matched_bets = get_index<matched_bet_index, by_id>();
-        for (auto itr = matched_bets.begin(); itr != matched_bets.end(); ++itr)
-        {
-            total_supply += itr->bet1_data.stake;
-            total_supply += itr->bet2_data.stake;
-        }
+    auto& fifa_2018_reward_service = obtain_service<dbs_content_fifa_world_cup_2018_bounty_reward_fund>();
+    if (fifa_2018_reward_service.is_exists())
+    {
+        total_supply += asset(fifa_2018_reward_service.get().activity_reward_balance.amount, SCORUM_SYMBOL);
+    }
 
-        const auto& pending_bets = get_index<pending_bet_index, by_id>();
-        for (auto itr = pending_bets.begin(); itr != pending_bets.end(); ++itr)
-        {
-            total_supply += itr->data.stake;
-        }
+    total_supply += asset(gpo.total_scorumpower.amount, SCORUM_SYMBOL);
+    total_supply += gpo.total_burned_scr;
+    total_supply += gpo.active_sp_holders_reward.scr_pool;
+    total_supply += asset(gpo.active_sp_holders_reward.sp_pool.amount, SCORUM_SYMBOL);
+    total_supply += obtain_service<dbs_content_reward_scr>().get().balance;
+    total_supply += obtain_service<dbs_voters_reward_scr>().get().balance;
+    total_supply += obtain_service<dbs_voters_reward_sp>().get().balance.amount;
 
-        FC_ASSERT(total_supply <= asset::maximum(SCORUM_SYMBOL), "Assets SCR overflow");
-        FC_ASSERT(accounts_circulating.sp <= asset::maximum(SP_SYMBOL), "Assets SP overflow");
+    total_supply += totals.adv_budgets_balance;
 
-        FC_ASSERT(gpo.total_supply == total_supply, "",
-                  ("gpo.total_supply", gpo.total_supply)
-                  ("total_supply", total_supply));
+    if (obtain_service<dbs_fund_budget>().is_exists())
+    {
+        total_supply += obtain_service<dbs_fund_budget>().get().balance.amount;
+    }
 
-        FC_ASSERT(gpo.total_scorumpower == accounts_circulating.sp, "",
-                  ("gpo.total_supply", gpo.total_supply)
-                  ("gpo.total_scorumpower", gpo.total_scorumpower)
-                  ("gpo.circulating_capital", gpo.circulating_capital)
-                  ("accounts_circulating.sp", accounts_circulating.sp)
-                  ("accounts_circulating.scr", accounts_circulating.scr));
+    if (obtain_service<dbs_registration_pool>().is_exists())
+    {
+        auto& pool = obtain_service<dbs_registration_pool>().get();
+        total_supply += pool.balance;
+        total_supply += asset(pool.delegated.amount, SCORUM_SYMBOL);
+    }
 
-        FC_ASSERT(gpo.circulating_capital.amount - gpo.total_scorumpower.amount == accounts_circulating.scr.amount, "",
-                  ("gpo.total_supply", gpo.total_supply)
-                  ("gpo.total_scorumpower", gpo.total_scorumpower)
-                  ("gpo.circulating_capital", gpo.circulating_capital)
-                  ("accounts_circulating.sp", accounts_circulating.sp)
-                  ("accounts_circulating.scr", accounts_circulating.scr));
+    total_supply += asset(obtain_service<dbs_dev_pool>().get().sp_balance.amount, SCORUM_SYMBOL);
+    total_supply += obtain_service<dbs_dev_pool>().get().scr_balance;
 
-        FC_ASSERT(gpo.total_scorumpower.amount == accounts_circulating.vsf_votes, "",
-                  ("total_scorumpower", gpo.total_scorumpower)
-                  ("accounts_circulating.total_vsf_votes", accounts_circulating.vsf_votes));
+    if (obtain_service<dbs_witness_reward_in_sp_migration>().is_exists())
+    {
+        total_supply += asset(obtain_service<dbs_witness_reward_in_sp_migration>().get().balance, SCORUM_SYMBOL);
+    }
 
-        FC_ASSERT(gpo.total_pending_scr == accounts_circulating.pending_scr, "",
-                  ("total_pending_scr", gpo.total_pending_scr)
-                  ("accounts_circulating.pending_scr", accounts_circulating.pending_scr));
+    total_supply += totals.atomicswap_contracts_balance;
 
-        FC_ASSERT(gpo.total_pending_sp == accounts_circulating.pending_sp, "",
-                  ("total_pending_sp", gpo.total_pending_sp)
-                  ("accounts_circulating.pending_sp", accounts_circulating.pending_sp));
+    total_supply += totals.matched_bets_stake;
+    total_supply += totals.pending_bets_stake;
 
-        // clang-format on
-    }
-    FC_CAPTURE_LOG_AND_RETHROW((head_block_num()));
+    // clang-format off
+    FC_ASSERT(total_supply <= asset::maximum(SCORUM_SYMBOL), "Assets SCR overflow");
+    FC_ASSERT(totals.accounts_sp <= asset::maximum(SP_SYMBOL), "Assets SP overflow");
+
+    FC_ASSERT(gpo.total_supply == total_supply, "",
+              ("gpo.total_supply", gpo.total_supply)
+              ("total_supply", total_supply));
+
+    FC_ASSERT(gpo.total_scorumpower == totals.accounts_sp, "",
+              ("gpo.total_supply", gpo.total_supply)
+              ("gpo.total_scorumpower", gpo.total_scorumpower)
+              ("gpo.circulating_capital", gpo.circulating_capital)
+              ("accounts_circulating.sp", totals.accounts_sp)
+              ("accounts_circulating.scr", totals.accounts_scr));
+
+    FC_ASSERT(gpo.circulating_capital.amount - gpo.total_scorumpower.amount == totals.accounts_scr.amount, "",
+              ("gpo.total_supply", gpo.total_supply)
+              ("gpo.total_scorumpower", gpo.total_scorumpower)
+              ("gpo.circulating_capital", gpo.circulating_capital)
+              ("accounts_circulating.sp", totals.accounts_sp)
+              ("accounts_circulating.scr", totals.accounts_scr));
+
+    FC_ASSERT(gpo.total_scorumpower.amount == totals.accounts_vsf_votes, "",
+              ("total_scorumpower", gpo.total_scorumpower)
+              ("accounts_circulating.total_vsf_votes", totals.accounts_vsf_votes));
+
+    FC_ASSERT(gpo.total_pending_scr == totals.accounts_pending_scr, "",
+              ("total_pending_scr", gpo.total_pending_scr)
+              ("accounts_circulating.pending_scr", totals.accounts_pending_scr));
+
+    FC_ASSERT(gpo.total_pending_sp == totals.accounts_pending_sp, "",
+              ("total_pending_sp", gpo.total_pending_sp)
+              ("accounts_circulating.pending_sp", totals.accounts_pending_sp));
+    // clang-format on
 }
 
 } // namespace chain
@@ -22,7 +22,7 @@ void fork_database::pop_block()
     _head = prev;
 }
 
-void fork_database::start_block(signed_block b)
+void fork_database::start_block(immutable_block_ptr b)
 {
     auto item = std::make_shared<fork_item>(std::move(b));
     _index.insert(item);
@@ -33,7 +33,7 @@ void fork_database::start_block(signed_block b)
  * Pushes the block into the fork database and caches it if it doesn't link
  *
  */
-std::shared_ptr<fork_item> fork_database::push_block(const signed_block& b)
+std::shared_ptr<fork_item> fork_database::push_block(const immutable_block_ptr& b)
 {
     auto item = std::make_shared<fork_item>(b);
     try
@@ -42,7 +42,7 @@ std::shared_ptr<fork_item> fork_database::push_block(const signed_block& b)
     }
     catch (const unlinkable_block_exception&)
     {
-        wlog("Pushing block to fork database that failed to link: ${id}, ${num}", ("id", b.id())("num", b.block_num()));
+        wlog("Pushing block to fork database that failed to link: ${id}, ${num}", ("id", item->id)("num", item->num));
         wlog("Head: ${num}, ${id}", ("num", _head->data.block_num())("id", _head->data.id()));
         throw;
         _unlinked_index.insert(item);
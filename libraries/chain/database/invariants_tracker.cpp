@@ -0,0 +1,182 @@
+#include <scorum/chain/database/invariants_tracker.hpp>
+
+#include <chainbase/database_index.hpp>
+#include <chainbase/segment_manager.hpp>
+
+#include <scorum/chain/schema/account_objects.hpp>
+#include <scorum/chain/schema/atomicswap_objects.hpp>
+#include <scorum/chain/schema/bet_objects.hpp>
+#include <scorum/chain/schema/budget_objects.hpp>
+#include <scorum/chain/schema/scorum_objects.hpp>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+// Op is called with (total, value) for each value the object adds to the totals
+
+template <typename Op> void accumulate(invariant_totals& t, const account_object& o, Op&& op)
+{
+    op(t.accounts_scr, o.balance);
+    op(t.accounts_sp, o.scorumpower);
+    op(t.accounts_pending_scr, o.active_sp_holders_pending_scr_reward);
+    op(t.accounts_pending_sp, o.active_sp_holders_pending_sp_reward);
+    op(t.accounts_vsf_votes, o.circulating_vsf_votes());
+}
+
+template <typename Op> void accumulate(invariant_totals& t, const escrow_object& o, Op&& op)
+{
+    op(t.escrows_balance, o.scorum_balance);
+    op(t.escrows_balance, o.pending_fee);
+}
+
+template <typename Op> void accumulate(invariant_totals& t, const atomicswap_contract_object& o, Op&& op)
+{
+    op(t.atomicswap_contracts_balance, o.amount);
+}
+
+template <budget_type budget_type_v, typename Op>
+void accumulate(invariant_totals& t, const adv_budget_object<budget_type_v>& o, Op&& op)
+{
+    op(t.adv_budgets_balance, o.balance);
+    op(t.adv_budgets_balance, o.owner_pending_income);
+    op(t.adv_budgets_balance, o.budget_pending_outgo);
+}
+
+template <typename Op> void accumulate(invariant_totals& t, const pending_bet_object& o, Op&& op)
+{
+    op(t.pending_bets_stake, o.data.stake);
+}
+
+template <typename Op> void accumulate(invariant_totals& t, const matched_bet_object& o, Op&& op)
+{
+    op(t.matched_bets_stake, o.bet1_data.stake);
+    op(t.matched_bets_stake, o.bet2_data.stake);
+}
+
+template <typename TObject> void add(invariant_totals& t, const TObject& o)
+{
+    accumulate(t, o, [](auto& total, const auto& value) { total += value; });
+}
+
+template <typename TObject> void subtract(invariant_totals& t, const TObject& o)
+{
+    accumulate(t, o, [](auto& total, const auto& value) { total -= value; });
+}
+
+template <typename TObject> void add_all(invariant_totals& t, const dba::db_index& db)
+{
+    const auto& idx = db.get_index<typename chainbase::get_index_type<TObject>::type, by_id>();
+    for (const TObject& o : idx)
+        add(t, o);
+}
+
+template <typename TObject> class totals_observer : public chainbase::object_observer<TObject>
+{
+public:
+    explicit totals_observer(dba::db_index& db)
+        : _db(db)
+    {
+    }
+
+    void on_create(const TObject& obj) override
+    {
+        update([&](invariant_totals& t) { add(t, obj); });
+    }
+
+    void on_modify(const TObject& old_obj, const TObject& obj) override
+    {
+        update([&](invariant_totals& t) {
+            subtract(t, old_obj);
+            add(t, obj);
+        });
+    }
+
+    void on_remove(const TObject& obj) override
+    {
+        update([&](invariant_totals& t) { subtract(t, obj); });
+    }
+
+private:
+    template <typename Modifier> void update(Modifier&& m)
+    {
+        const auto* totals_obj = _db.find<invariant_totals_object>();
+        if (!totals_obj)
+            return; // totals will be calculated from scratch by invariants_tracker::reset
+
+        _db.modify(*totals_obj, [&](invariant_totals_object& o) { m(o.totals); });
+    }
+
+    dba::db_index& _db;
+};
+}
+
+invariants_tracker::invariants_tracker(dba::db_index& db)
+    : _db(db)
+{
+    observe<account_object>();
+    observe<escrow_object>();
+    observe<atomicswap_contract_object>();
+    observe<post_budget_object>();
+    observe<banner_budget_object>();
+    observe<pending_bet_object>();
+    observe<matched_bet_object>();
+}
+
+invariants_tracker::~invariants_tracker()
+{
+    _db.set_observer<account_object>(nullptr);
+    _db.set_observer<escrow_object>(nullptr);
+    _db.set_observer<atomicswap_contract_object>(nullptr);
+    _db.set_observer<post_budget_object>(nullptr);
+    _db.set_observer<banner_budget_object>(nullptr);
+    _db.set_observer<pending_bet_object>(nullptr);
+    _db.set_observer<matched_bet_object>(nullptr);
+}
+
+template <typename TObject> void invariants_tracker::observe()
+{
+    _db.set_observer<TObject>(std::make_shared<totals_observer<TObject>>(_db));
+}
+
+invariant_totals invariants_tracker::calculate() const
+{
+    invariant_totals t;
+
+    add_all<account_object>(t, _db);
+    add_all<escrow_object>(t, _db);
+    add_all<atomicswap_contract_object>(t, _db);
+    add_all<post_budget_object>(t, _db);
+    add_all<banner_budget_object>(t, _db);
+    add_all<pending_bet_object>(t, _db);
+    add_all<matched_bet_object>(t, _db);
+
+    return t;
+}
+
+void invariants_tracker::reset()
+{
+    const auto t = calculate();
+
+    if (const auto* totals_obj = _db.find<invariant_totals_object>())
+    {
+        _db.modify(*totals_obj, [&](invariant_totals_object& o) { o.totals = t; });
+    }
+    else
+    {
+        _db.create<invariant_totals_object>([&](invariant_totals_object& o) { o.totals = t; });
+    }
+}
+
+bool invariants_tracker::is_tracking() const
+{
+    return _db.find<invariant_totals_object>() != nullptr;
+}
+
+const invariant_totals& invariants_tracker::totals() const
+{
+    return _db.get<invariant_totals_object>().totals;
+}
+}
+}
@@ -0,0 +1,104 @@
+#include <scorum/chain/database/pending_transactions_pool.hpp>
+
+#include <algorithm>
+
+namespace scorum {
+namespace chain {
+
+pending_transactions_pool::pending_transactions_pool(priority_type priority)
+    : _priority(priority)
+{
+}
+
+void pending_transactions_pool::set_priority(priority_type priority)
+{
+    _priority = priority;
+}
+
+pending_transactions_pool::priority_type pending_transactions_pool::priority() const
+{
+    return _priority;
+}
+
+void pending_transactions_pool::push(const signed_transaction& trx, size_t packed_size)
+{
+    entry e;
+    e.trx = trx;
+    e.packed_size = packed_size;
+
+    _entries.push_back(std::move(e));
+}
+
+size_t pending_transactions_pool::get_prefix_size(size_t header_size, size_t total_size) const
+{
+    size_t block_size = header_size;
+    size_t n = 0;
+    for (; n < _entries.size(); ++n)
+    {
+        // the rest are postponed, the next transactions have been applied after this one
+        if (block_size + _entries[n].packed_size >= total_size)
+            break;
+
+        block_size += _entries[n].packed_size;
+    }
+    return n;
+}
+
+size_t pending_transactions_pool::remove_expired(const fc::time_point_sec& when)
+{
+    auto it = std::remove_if(_entries.begin(), _entries.end(), [&](const entry& e) { return e.trx.expiration <= when; });
+
+    size_t removed = std::distance(it, _entries.end());
+    _entries.erase(it, _entries.end());
+
+    return removed;
+}
+
+std::vector<signed_transaction> pending_transactions_pool::release()
+{
+    // stable sort keeps the order of arrival for the transactions with the same priority
+    switch (_priority)
+    {
+    case by_expiration:
+        std::stable_sort(_entries.begin(), _entries.end(),
+                         [](const entry& l, const entry& r) { return l.trx.expiration < r.trx.expiration; });
+        break;
+    case by_size:
+        std::stable_sort(_entries.begin(), _entries.end(),
+                         [](const entry& l, const entry& r) { return l.packed_size < r.packed_size; });
+        break;
+    case by_arrival:
+        break;
+    }
+
+    std::vector<signed_transaction> result;
+    result.reserve(_entries.size());
+    for (auto& e : _entries)
+        result.push_back(std::move(e.trx));
+
+    _entries.clear();
+
+    return result;
+}
+
+void pending_transactions_pool::clear()
+{
+    _entries.clear();
+}
+
+const std::vector<pending_transactions_pool::entry>& pending_transactions_pool::entries() const
+{
+    return _entries;
+}
+
+size_t pending_transactions_pool::size() const
+{
+    return _entries.size();
+}
+
+bool pending_transactions_pool::empty() const
+{
+    return _entries.empty();
+}
+}
+}
@@ -0,0 +1,109 @@
+#include <scorum/chain/database/state_snapshot.hpp>
+
+#include <limits>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+template <typename T> void write_value(std::ofstream& stream, const T& value)
+{
+    auto data = fc::raw::pack(value);
+    stream.write(data.data(), data.size());
+}
+
+template <typename T> void read_value(std::ifstream& stream, T& value)
+{
+    fc::raw::unpack(stream, value);
+}
+}
+
+state_snapshot_writer::state_snapshot_writer(const fc::path& file)
+{
+    _stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    _stream.open(file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+}
+
+void state_snapshot_writer::write_header(const state_snapshot_header& header)
+{
+    write_value(_stream, header);
+}
+
+void state_snapshot_writer::begin_index(const index_snapshot_header& header)
+{
+    write_value(_stream, header);
+
+    _checksum.reset();
+}
+
+void state_snapshot_writer::write_object_bytes()
+{
+    FC_ASSERT(_buffer.size() <= std::numeric_limits<uint32_t>::max(), "Object is too big");
+
+    uint32_t size = (uint32_t)_buffer.size();
+
+    _stream.write((const char*)&size, sizeof(size));
+    _stream.write(_buffer.data(), _buffer.size());
+
+    _checksum.write(_buffer.data(), _buffer.size());
+}
+
+void state_snapshot_writer::end_index()
+{
+    write_value(_stream, _checksum.result());
+}
+
+void state_snapshot_writer::close()
+{
+    _stream.flush();
+    _stream.close();
+}
+
+state_snapshot_reader::state_snapshot_reader(const fc::path& file)
+    : _file(file.generic_string())
+{
+    FC_ASSERT(fc::exists(file), "State snapshot ${f} does not exist", ("f", _file));
+
+    _stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    _stream.open(_file.c_str(), std::ios::in | std::ios::binary);
+}
+
+state_snapshot_header state_snapshot_reader::read_header()
+{
+    state_snapshot_header header;
+    read_value(_stream, header);
+    return header;
+}
+
+index_snapshot_header state_snapshot_reader::begin_index()
+{
+    read_value(_stream, _index);
+
+    _checksum.reset();
+
+    return _index;
+}
+
+void state_snapshot_reader::read_object_bytes()
+{
+    uint32_t size = 0;
+
+    _stream.read((char*)&size, sizeof(size));
+
+    _buffer.resize(size);
+    _stream.read(_buffer.data(), size);
+
+    _checksum.write(_buffer.data(), _buffer.size());
+}
+
+void state_snapshot_reader::end_index()
+{
+    fc::sha256 expected;
+    read_value(_stream, expected);
+
+    FC_ASSERT(_checksum.result() == expected, "Checksum mismatch of ${t} in the state snapshot ${f}",
+              ("t", _index.type_name)("f", _file));
+}
+}
+}
@@ -421,13 +421,16 @@ void comment_evaluator::do_apply(const comment_operation& o)
                 com.cashout_time = com.created + SCORUM_CASHOUT_WINDOW_SECONDS;
 
 #ifndef IS_LOW_MEM
-                fc::from_string(com.title, o.title);
+                comment_content content;
+                content.title = o.title;
                 if (o.body.size() < 1024 * 1024 * 128)
                 {
-                    fc::from_string(com.body, o.body);
+                    content.body = o.body;
                 }
 
-                fc::from_string(com.json_metadata, o.json_metadata);
+                content.json_metadata = o.json_metadata;
+
+                com.content = comment_service.store_content(content);
 #endif
             });
 
@@ -487,11 +490,16 @@ void comment_evaluator::do_apply(const comment_operation& o)
                 }
 
 #ifndef IS_LOW_MEM
+                if (o.title.empty() && o.json_metadata.empty() && o.body.empty())
+                    return;
+
+                comment_content content = comment_service.get_content(com);
+
                 if (o.title.size())
-                    fc::from_string(com.title, o.title);
+                    content.title = o.title;
                 if (!o.json_metadata.empty())
                 {
-                    fc::from_string(com.json_metadata, o.json_metadata);
+                    content.json_metadata = o.json_metadata;
                 }
 
                 if (!o.body.empty())
@@ -502,28 +510,30 @@ void comment_evaluator::do_apply(const comment_operation& o)
                         auto patch = dmp.patch_fromText(utf8_to_wstring(o.body));
                         if (patch.size())
                         {
-                            auto result = dmp.patch_apply(patch, utf8_to_wstring(fc::to_string(com.body)));
+                            auto result = dmp.patch_apply(patch, utf8_to_wstring(content.body));
                             auto patched_body = wstring_to_utf8(result.first);
                             if (!fc::is_utf8(patched_body))
                             {
                                 idump(("invalid utf8")(patched_body));
-                                fc::from_string(com.body, fc::prune_invalid_utf8(patched_body));
+                                content.body = fc::prune_invalid_utf8(patched_body);
                             }
                             else
                             {
-                                fc::from_string(com.body, patched_body);
+                                content.body = patched_body;
                             }
                         }
                         else
                         { // replace
-                            fc::from_string(com.body, o.body);
+                            content.body = o.body;
                         }
                     }
                     catch (...)
                     {
-                        fc::from_string(com.body, o.body);
+                        content.body = o.body;
                     }
                 }
+
+                com.content = comment_service.store_content(content);
 #endif
             });
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <scorum/protocol/block.hpp>
+#include <scorum/protocol/operations.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+using namespace scorum::protocol;
+
+class database;
+
+/// Copy of operation_notification that outlives the operation applying
+struct async_operation_notification
+{
+    transaction_id_type trx_id;
+    uint32_t block = 0;
+    uint32_t trx_in_block = 0;
+    uint16_t op_in_trx = 0;
+    operation op;
+};
+
+struct async_block_notification
+{
+    enum event_type
+    {
+        applied_block,
+        /// block is removed from the head by the fork switch, its operations are undone in the database
+        popped_block
+    };
+
+    event_type event = applied_block;
+
+    std::shared_ptr<const signed_block> block;
+    uint32_t block_num = 0;
+
+    /// dynamic global properties after the block has been applied (applied_block only)
+    uint64_t current_aslot = 0;
+    uint32_t last_irreversible_block_num = 0;
+
+    /// all operations of the block (including virtual ones) in the order they were applied (applied_block only)
+    std::vector<async_operation_notification> operations;
+};
+
+namespace detail {
+class async_block_stream_impl;
+}
+
+/**
+ * Delivers applied and popped blocks with their operations to the handler on a worker thread.
+ *
+ * Events are collected from the database signals while the block is applied and are queued when it has been applied.
+ * Handler receives them in the order of the database changes. If the queue is full, the block applying waits for
+ * the handler (backpressure), so the handler must not take database locks.
+ *
+ * The stream is registered in the database to report its lag (see database::get_async_streams_lag).
+ */
+class async_block_stream
+{
+public:
+    using handler_type = std::function<void(const async_block_notification&)>;
+
+    static const size_t default_queue_size = 1024;
+
+    async_block_stream(database& db,
+                       const std::string& name,
+                       handler_type handler,
+                       size_t queue_size = default_queue_size);
+
+    /// Waits for the queued events to be handled
+    ~async_block_stream();
+
+    const std::string& name() const;
+
+    /// @returns number of the queued and being handled events
+    uint32_t lag() const;
+
+    /// @returns number of the last block that was handled
+    uint32_t last_handled_block_num() const;
+
+    /// Waits until all queued events are handled
+    void wait() const;
+
+private:
+    std::unique_ptr<detail::async_block_stream_impl> _impl;
+};
+}
+}
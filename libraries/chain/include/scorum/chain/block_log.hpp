@@ -11,6 +11,37 @@ namespace detail {
 class block_log_impl;
 }
 
+/**
+ * Packed bytes of a block in the memory-mapped block log.
+ *
+ * The view keeps the mapping alive, so it stays valid after the block log is appended, remapped or closed.
+ */
+class packed_block_view
+{
+public:
+    packed_block_view(std::shared_ptr<const void> mapping, const char* data, size_t size);
+
+    const char* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /// Unpacks the block header only (the header is the prefix of the packed block)
+    signed_block_header header() const;
+
+    signed_block unpack() const;
+
+private:
+    std::shared_ptr<const void> _mapping;
+    const char* _data = nullptr;
+    size_t _size = 0;
+};
+
 /* The block log is an external append only log of the blocks. Blocks should only be written
  * to the log after they irreverisble as the log is append only. The log is a doubly linked
  * list of blocks. There is a secondary index file of only block positions that enables O(1)
@@ -34,6 +65,10 @@ class block_log_impl;
  *
  * The main file is the only file that needs to persist. The index file can be reconstructed during a
  * linear scan of the main file.
+ *
+ * Blocks are written through the file streams and read from the memory-mapped files, so reading doesn't
+ * touch the streams and can be done concurrently from any thread. Appended blocks become readable
+ * after append() returns, the mapping is extended by the first reader that needs them.
  */
 
 class block_log
@@ -49,10 +84,15 @@ public:
     static fc::path block_log_index_path(const fc::path& block_log_file);
 
     uint64_t append(const signed_block& b);
+    /// uses the id calculated by the immutable block
+    uint64_t append(const immutable_block& b);
     void flush();
     std::pair<signed_block, uint64_t> read_block(uint64_t file_pos) const;
     optional<signed_block> read_block_by_num(uint32_t block_num) const;
 
+    /// @returns the packed block without copying it from the mapped block log
+    optional<packed_block_view> read_packed_block_by_num(uint32_t block_num) const;
+
     /**
      * Return offset of block in file, or block_log::npos if it does not exist.
      */
@@ -63,6 +103,7 @@ public:
     static const uint64_t npos = std::numeric_limits<uint64_t>::max();
 
 private:
+    uint64_t append(const signed_block& b, const block_id_type& id);
     void construct_index();
 
     std::unique_ptr<detail::block_log_impl> my;
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <scorum/protocol/block.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+using namespace scorum::protocol;
+
+/// Block read from the block log with values that database would otherwise calculate while applying it
+struct replayed_block
+{
+    signed_block block;
+    block_id_type block_id;
+    std::vector<transaction_id_type> transaction_ids;
+    checksum_type merkle_root;
+    uint32_t block_size = 0;
+};
+
+struct replay_stage_stats
+{
+    std::string name;
+    /// items processed by the stage
+    uint64_t items = 0;
+    /// time spent doing work (summed over the stage threads)
+    fc::microseconds busy_time;
+    /// time spent waiting for the input or for the room in the output queue
+    fc::microseconds wait_time;
+};
+
+namespace detail {
+class block_replay_pipeline_impl;
+}
+
+/**
+ * Replays the block log in three stages connected by bounded queues:
+ *
+ *   read   - one thread reading and unpacking blocks sequentially from the block log file;
+ *   digest - worker threads calculating block and transaction ids, merkle root and packed size;
+ *   apply  - the caller thread taking blocks in the block log order by next().
+ *
+ * The pipeline reads the file through its own stream, so the database block_log can be used concurrently.
+ */
+class block_replay_pipeline
+{
+public:
+    /**
+     * @param block_log_file  block log to read blocks from (starting from the first one)
+     * @param last_block_num  last block to read
+     * @param digest_threads  number of digest stage threads, 0 - by hardware concurrency
+     * @param queue_size      capacity of each inter-stage queue (blocks)
+     */
+    block_replay_pipeline(const fc::path& block_log_file,
+                          uint32_t last_block_num,
+                          uint32_t digest_threads = 0,
+                          size_t queue_size = 1024);
+    ~block_replay_pipeline();
+
+    /// Starts read and digest stages threads
+    void start();
+
+    /// Stops stages and joins their threads. Called by destructor
+    void stop();
+
+    /**
+     * Waits for the next block in the block log order.
+     * @returns nullptr after last_block_num has been returned
+     * @throws the exception of the read or digest stage
+     */
+    std::shared_ptr<const replayed_block> next();
+
+    std::vector<replay_stage_stats> stats() const;
+
+private:
+    std::unique_ptr<detail::block_replay_pipeline_impl> _impl;
+};
+}
+}
+
+FC_REFLECT(scorum::chain::replay_stage_stats, (name)(items)(busy_time)(wait_time))
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <fc/crypto/ripemd160.hpp>
+#include <fc/filesystem.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <scorum/utils/lru_cache.hpp>
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace scorum {
+namespace chain {
+
+/// Text fields of the comment that are kept outside of the shared memory
+struct comment_content
+{
+    std::string title;
+    std::string body;
+    std::string json_metadata;
+};
+
+/// Location of the packed comment_content in the comment_content_store. Default value refers to the empty content
+struct comment_content_ref
+{
+    uint64_t position = 0;
+    uint32_t size = 0;
+    fc::ripemd160 hash;
+};
+
+/* The comment content store is an external append only file of the comment texts. Comment objects keep
+ * references to their latest content, the previous versions stay in the file.
+ *
+ * +-----------+-----------+-----+-----------+
+ * | Content 1 | Content 2 | ... | Content N |
+ * +-----------+-----------+-----+-----------+
+ *
+ * Undone comments just keep references to the older contents, so the file doesn't depend on the undo state.
+ * Recently read contents are kept in the LRU cache. Recently appended contents are indexed by their hash, so
+ * applying the same operation again refers to the stored content instead of appending a copy.
+ * The store is thread safe.
+ */
+class comment_content_store
+{
+public:
+    explicit comment_content_store(size_t cache_size = 1024, size_t appended_index_size = 65536);
+
+    void open(const fc::path& file, bool read_only = false);
+
+    void close();
+
+    void flush();
+
+    static void wipe(const fc::path& file);
+
+    /// Flushes and copies the file, it can be opened by another store
+    void copy(const fc::path& file) const;
+
+    /// Appends the content unless the same content has been appended recently
+    comment_content_ref append(const comment_content& content);
+
+    /// @returns size of the file in bytes
+    uint64_t size() const;
+
+    /// @throws if the content is beyond the end of the file or it has been modified
+    comment_content read(const comment_content_ref& ref) const;
+
+    /// Size of the LRU cache of the contents (0 - no cache)
+    void set_cache_size(size_t cache_size);
+
+private:
+    mutable std::mutex _mutex;
+    mutable std::fstream _file;
+    fc::path _path;
+    bool _read_only = false;
+    mutable uint64_t _end = 0;
+
+    mutable utils::lru_cache<uint64_t, comment_content> _cache;
+    utils::lru_cache<fc::ripemd160, comment_content_ref> _appended;
+};
+}
+}
+
+FC_REFLECT(scorum::chain::comment_content, (title)(body)(json_metadata))
+FC_REFLECT(scorum::chain::comment_content_ref, (position)(size)(hash))
@@ -0,0 +1,70 @@
+#pragma once
+#include <scorum/chain/block_log.hpp>
+
+namespace scorum {
+namespace chain {
+
+namespace detail {
+class compressed_block_log_impl;
+}
+
+/* The compressed block log is an append only log of the blocks grouped into chunks of blocks_per_chunk
+ * blocks. Each chunk is compressed independently, so any block can be read by decompressing a single chunk.
+ *
+ * +--------+---------+---------+-----+------------+
+ * | Header | Chunk 1 | Chunk 2 | ... | Last Chunk |
+ * +--------+---------+---------+-----+------------+
+ *
+ * +-------------------------------------------+---------------------------------------------------+
+ * | Raw Size | Compressed Size | Blocks Count | Compressed (Blocks Offsets, Block 1, Block 2, ...) |
+ * +-------------------------------------------+---------------------------------------------------+
+ *
+ * The index file contains positions of the chunks in the main file. Block N is in the chunk
+ * (N - 1) / blocks_per_chunk, so the lookup by block number is O(1).
+ *
+ * All chunks except the last one are full. Blocks of the last chunk are kept in memory and the chunk is
+ * (re)written by flush() or when it becomes full. The index file can be reconstructed by walking the chunk headers.
+ */
+class compressed_block_log
+{
+public:
+    enum codec_type : uint32_t
+    {
+        zlib_codec = 1
+    };
+
+    static const uint32_t default_blocks_per_chunk = 256;
+
+    compressed_block_log();
+    ~compressed_block_log();
+
+    /// @param blocks_per_chunk  is used for the new file only, existing file keeps its own
+    void open(const fc::path& file, uint32_t blocks_per_chunk = default_blocks_per_chunk);
+    void close();
+    bool is_open() const;
+
+    static fc::path block_log_index_path(const fc::path& file);
+
+    void append(const signed_block& b);
+    void flush();
+
+    optional<signed_block> read_block_by_num(uint32_t block_num) const;
+
+    uint32_t head_block_num() const;
+    uint32_t blocks_per_chunk() const;
+
+    /**
+     * Writes blocks of the legacy block log to the new compressed block log.
+     * @returns number of converted blocks
+     */
+    static uint32_t convert(const fc::path& legacy_block_log,
+                            const fc::path& file,
+                            uint32_t blocks_per_chunk = default_blocks_per_chunk);
+
+private:
+    void append(uint32_t block_num, const char* data, size_t size);
+
+    std::unique_ptr<detail::compressed_block_log_impl> my;
+};
+}
+}
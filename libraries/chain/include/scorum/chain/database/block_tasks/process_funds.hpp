@@ -38,6 +38,8 @@ public:
 private:
     void distribute_reward(const asset& reward);
     void distribute_active_sp_holders_reward(const asset& reward);
+    void accumulate_active_sp_holders_reward(const asset& total_reward);
+    void expire_active_sp_holders();
     void distribute_witness_reward(const asset& reward);
     void pay_account_reward(const account_object&, const asset& reward);
     void pay_account_pending_reward(const account_object&, const asset& reward);
@@ -8,6 +8,7 @@
 #include <scorum/chain/node_property_object.hpp>
 #include <scorum/chain/database/fork_database.hpp>
 #include <scorum/chain/block_log.hpp>
+#include <scorum/chain/comment_content_store.hpp>
 #include <scorum/chain/operation_notification.hpp>
 
 #include <scorum/protocol/protocol.hpp>
@@ -19,12 +20,16 @@
 #include <scorum/chain/database/database_virtual_operations.hpp>
 
 #include <scorum/chain/database/debug_log.hpp>
+#include <scorum/chain/database/state_snapshot.hpp>
+#include <scorum/chain/database/pending_transactions_pool.hpp>
 #include <fc/signals.hpp>
 #include <fc/shared_string.hpp>
 #include <fc/log/logger.hpp>
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 
 namespace scorum {
 namespace chain {
@@ -39,6 +44,9 @@ class database_impl;
 
 struct genesis_state_type;
 struct genesis_persistent_state_type;
+struct invariant_totals;
+struct replayed_block;
+class async_block_stream;
 
 /**
  *   @class database
@@ -93,6 +101,8 @@ public:
     };
 
     static fc::path block_log_path(const fc::path& data_dir);
+    static fc::path comment_content_path(const fc::path& data_dir);
+    static fc::path comment_content_snapshot_path(const fc::path& snapshot_file);
 
     uint32_t get_reindex_skip_flags() const;
 
@@ -122,6 +132,27 @@ public:
                  uint32_t skip_flags,
                  const genesis_state_type& genesis_state);
 
+    /**
+     * @brief Create the state from the state snapshot and open database
+     *
+     * This method may be called instead of @ref database::reindex. The block log must contain the head block of
+     * the snapshot, the enabled plugins must be the same as the ones of the node that has exported the snapshot.
+     * When this method exits successfully, the database will be open.
+     */
+    void import_state_snapshot(const fc::path& snapshot_file,
+                               const fc::path& data_dir,
+                               const fc::path& shared_mem_dir,
+                               uint64_t shared_file_size,
+                               const genesis_state_type& genesis_state);
+
+    /**
+     * @brief Write all indices (including plugin ones) to the state snapshot
+     *
+     * The state must not have reversible changes, that is the case right after @ref database::open, which undoes
+     * them to the last irreversible block. The comment content store is copied next to the snapshot.
+     */
+    void export_state_snapshot(const fc::path& snapshot_file);
+
     /**
      * @brief wipe Delete database from disk, and potentially the raw chain as well.
      * @param include_blocks If true, delete the raw chain as well as the database.
@@ -147,6 +178,8 @@ public:
     optional<signed_block> fetch_block_by_id(const block_id_type& id) const;
     optional<signed_block> fetch_block_by_number(uint32_t num) const;
     optional<signed_block> read_block_by_number(uint32_t num) const;
+    /// @returns irreversible block packed in the block log, can be called without the database lock
+    optional<packed_block_view> read_packed_block_by_number(uint32_t num) const;
 
     const signed_transaction get_recent_transaction(const transaction_id_type& trx_id) const;
     std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
@@ -155,6 +188,10 @@ public:
 
     const node_property_object& get_node_properties() const;
 
+    /// Store of the comment texts, it's thread safe and can be used without the database lock
+    comment_content_store& get_comment_content_store();
+    const comment_content_store& get_comment_content_store() const;
+
     const time_point_sec calculate_discussion_payout_time(const comment_object& comment) const;
 
     /**
@@ -171,6 +208,10 @@ public:
     bool before_last_checkpoint() const;
 
     bool push_block(const signed_block& b, uint32_t skip = skip_nothing);
+    /// the block is shared with the fork database, it's not copied
+    bool push_block(const immutable_block_ptr& b, uint32_t skip = skip_nothing);
+    /// Starts recovering signature keys of the block that is going to be pushed soon, doesn't wait. Thread safe
+    void prevalidate_block(const immutable_block_ptr& b, uint32_t skip = skip_nothing);
     void push_transaction(const signed_transaction& trx, uint32_t skip = skip_nothing);
 
     void _push_transaction(const signed_transaction& trx);
@@ -199,6 +240,7 @@ public:
 
     void notify_pre_applied_block(const signed_block& block);
     void notify_applied_block(const signed_block& block);
+    void notify_popped_block(const signed_block& block);
     void notify_on_pending_transaction(const signed_transaction& tx);
     void notify_on_pre_apply_transaction(const signed_transaction& tx);
     void notify_on_applied_transaction(const signed_transaction& tx);
@@ -208,6 +250,27 @@ public:
      */
     fc::signal<void(const operation_notification&)> pre_apply_operation;
     fc::signal<void(const operation_notification&)> post_apply_operation;
+
+    using operation_signal_type = fc::signal<void(const operation_notification&)>;
+
+    /**
+     *  These signals are emitted for the operations of the given type only (after pre_apply_operation and
+     *  post_apply_operation). Plugins that need a few operations should subscribe to them, so the operations
+     *  nobody observes are applied without the notification.
+     */
+    template <typename OperationType> operation_signal_type& pre_apply_operation_of()
+    {
+        return get_operation_signal(_pre_apply_operation_signals, operation::tag<OperationType>::value);
+    }
+
+    template <typename OperationType> operation_signal_type& post_apply_operation_of()
+    {
+        return get_operation_signal(_post_apply_operation_signals, operation::tag<OperationType>::value);
+    }
+
+    /// @returns true if somebody is subscribed to the notification of the operation
+    bool is_operation_observed(const operation& op) const;
+
     fc::signal<void(const signed_block&)> pre_applied_block;
 
     /**
@@ -220,6 +283,17 @@ public:
      */
     fc::signal<void(const signed_block&)> applied_block;
 
+    /**
+     *  This signal is emitted after the head block has been removed and its changes have been undone.
+     */
+    fc::signal<void(const signed_block&)> popped_block;
+
+    /// @returns number of the events that are not handled yet by each asynchronous stream (by stream name)
+    std::map<std::string, uint32_t> get_async_streams_lag() const;
+
+    void register_async_stream(const async_block_stream& stream);
+    void unregister_async_stream(const async_block_stream& stream);
+
     /**
      * This signal is emitted any time a new transaction is added to the pending
      * block state.
@@ -316,9 +390,23 @@ public:
        with id N, applies all hardforks with id <= N */
     void set_hardfork(uint32_t hardfork, bool process_now = true);
 
+    /// Full audit: recalculates totals by scanning all objects and checks them against the tracked ones
     void validate_invariants() const;
 
+    /// Checks invariants using totals tracked by invariants_tracker, doesn't depend on the number of objects
+    void validate_tracked_invariants() const;
+
     void set_flush_interval(uint32_t flush_blocks);
+
+    /// Run full validate_invariants every audit_blocks blocks (instead of validate_tracked_invariants), 0 - never
+    void set_invariants_audit_interval(uint32_t audit_blocks);
+
+    /// Grow the shared memory file by grow_step bytes between blocks when free memory is below free_threshold
+    /// (grow_step 0 - never)
+    void set_shared_file_growth(uint64_t free_threshold, uint64_t grow_step);
+
+    /// Order of pending transactions to be included in the generated block after the head block is changed
+    void set_pending_transactions_priority(pending_transactions_pool::priority_type priority);
     void show_free_memory(bool force);
 
     // index
@@ -328,6 +416,16 @@ public:
         _plugin_index_signal.connect([this]() { this->add_index<MultiIndexType>(); });
     }
 
+    /// Adds the index and registers it for the state snapshot
+    template <typename MultiIndexType> const chainbase::generic_index<MultiIndexType>& add_index()
+    {
+        const auto& idx = chainbase::database::add_index<MultiIndexType>();
+
+        _index_snapshot_handlers.push_back(make_index_snapshot_handler<MultiIndexType>(*this));
+
+        return idx;
+    }
+
     const genesis_persistent_state_type& genesis_persistent_state() const;
 
 private:
@@ -339,7 +437,34 @@ private:
     void _update_witness_hardfork_version_votes();
 
     void _maybe_warn_multiple_production(uint32_t height) const;
-    bool _push_block(const signed_block& b);
+
+    /// Recovers signature keys into the cache in parallel, so checks under the write lock just look them up
+    void recover_signature_keys(const signed_block& b, uint32_t skip);
+    void recover_signature_keys(const signed_transaction& trx, uint32_t skip);
+
+    /// ids and sizes are taken from the replayed or immutable block (if it is being applied) to not calculate them twice
+    block_id_type get_block_id(const signed_block& b) const;
+    uint32_t get_block_size(const signed_block& b) const;
+    transaction_id_type get_transaction_id(const signed_transaction& trx) const;
+    block_info get_block_info(const signed_block& b) const;
+
+    void validate_invariants(const invariant_totals& totals) const;
+    bool _push_block(const immutable_block_ptr& b);
+
+    /// Opens database, the new state is created from the snapshot if it is set or from the genesis otherwise
+    void _open(const fc::path& data_dir,
+               const fc::path& shared_mem_dir,
+               uint64_t shared_file_size,
+               uint32_t chainbase_flags,
+               const genesis_state_type& genesis_state,
+               const optional<fc::path>& snapshot_file);
+
+    void load_state_snapshot(const fc::path& snapshot_file, const genesis_state_type& genesis_state);
+
+    /// Applies the transaction to the pending state and adds it to the pending transactions pool
+    void apply_pending_transaction(const signed_transaction& trx, size_t trx_size);
+    /// Re-applies pending transactions on the head block, the ones that are no longer valid are dropped
+    void rebuild_pending_state();
 
     signed_block _generate_block(const fc::time_point_sec when,
                                  const account_name_type& witness_owner,
@@ -352,11 +477,16 @@ protected:
     }
 
     void apply_block(const signed_block& next_block, uint32_t skip = skip_nothing);
+    void apply_block(const immutable_block& next_block, uint32_t skip = skip_nothing);
+    void apply_replayed_block(const replayed_block& replayed, uint32_t skip);
     void apply_transaction(const signed_transaction& trx, uint32_t skip = skip_nothing);
     void _apply_block(const signed_block& next_block);
     void _apply_transaction(const signed_transaction& trx);
     void apply_operation(const operation& op);
 
+    /// Grows the shared memory file if it's needed. Called between blocks, when there are no undo sessions
+    void maybe_grow_shared_file();
+
     /// Steps involved in applying a new block
     ///@{
 
@@ -383,15 +513,31 @@ private:
 
     optional<chainbase::abstract_undo_session_ptr> _pending_tx_session;
 
-    std::vector<signed_transaction> _pending_tx;
+    pending_transactions_pool _pending_tx;
     fork_database _fork_db;
     fc::time_point_sec _hardfork_times[SCORUM_NUM_HARDFORKS + 1];
     protocol::hardfork_version _hardfork_versions[SCORUM_NUM_HARDFORKS + 1];
 
     block_log _block_log;
+    comment_content_store _comment_content_store;
 
     fc::signal<void()> _plugin_index_signal;
 
+    std::vector<index_snapshot_handler> _index_snapshot_handlers;
+
+    using operation_signals_type = std::vector<std::unique_ptr<operation_signal_type>>;
+
+    static operation_signal_type& get_operation_signal(operation_signals_type& signals, int which);
+    static void notify_operation_signal(const operation_signals_type& signals, const operation_notification& note);
+    static bool is_observed(const operation_signals_type& signals, int which);
+
+    /// signals by operation tag, created on the first subscription
+    operation_signals_type _pre_apply_operation_signals;
+    operation_signals_type _post_apply_operation_signals;
+
+    std::set<const async_block_stream*> _async_streams;
+    mutable std::mutex _async_streams_mutex;
+
     transaction_id_type _current_trx_id;
     uint32_t _current_block_num = 0;
     uint16_t _current_trx_in_block = 0;
@@ -404,8 +550,19 @@ private:
     uint32_t _flush_blocks = 0;
     uint32_t _next_flush_block = 0;
 
+    uint32_t _invariants_audit_blocks = SCORUM_BLOCKS_PER_HOUR;
+
+    const replayed_block* _replayed_block = nullptr;
+    const immutable_block* _immutable_block = nullptr;
+
+    /// copy of chain_property_object::chain_id to be used without lock
+    chain_id_type _chain_id;
+
     uint32_t _last_free_gb_printed = 0;
 
+    uint64_t _shared_file_free_threshold = 0;
+    uint64_t _shared_file_grow_step = 0;
+
     fc::time_point_sec _const_genesis_time; // should be const
 };
 } // namespace chain
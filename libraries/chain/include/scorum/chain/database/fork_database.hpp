@@ -13,14 +13,17 @@ using boost::multi_index_container;
 using namespace boost::multi_index;
 
 using scorum::protocol::signed_block;
+using scorum::protocol::immutable_block;
+using scorum::protocol::immutable_block_ptr;
 using scorum::protocol::block_id_type;
 
 struct fork_item
 {
-    fork_item(signed_block d)
-        : num(d.block_num())
-        , id(d.id())
-        , data(std::move(d))
+    fork_item(immutable_block_ptr b)
+        : num(b->block_num())
+        , id(b->id())
+        , block(std::move(b))
+        , data(*block)
     {
     }
 
@@ -37,7 +40,9 @@ struct fork_item
      */
     bool invalid = false;
     block_id_type id;
-    signed_block data;
+    /// the block is shared with the network and the database, it isn't copied
+    immutable_block_ptr block;
+    const immutable_block& data;
 };
 typedef std::shared_ptr<fork_item> item_ptr;
 
@@ -61,7 +66,7 @@ public:
     fork_database();
     void reset();
 
-    void start_block(signed_block b);
+    void start_block(immutable_block_ptr b);
     void remove(block_id_type b);
     void set_head(std::shared_ptr<fork_item> h);
     bool is_known_block(const block_id_type& id) const;
@@ -71,7 +76,7 @@ public:
     /**
      *  @return the new head block ( the longest fork )
      */
-    std::shared_ptr<fork_item> push_block(const signed_block& b);
+    std::shared_ptr<fork_item> push_block(const immutable_block_ptr& b);
     std::shared_ptr<fork_item> head() const
     {
         return _head;
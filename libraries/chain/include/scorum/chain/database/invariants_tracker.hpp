@@ -0,0 +1,39 @@
+#pragma once
+
+#include <scorum/chain/dba/dba.hpp>
+#include <scorum/chain/schema/invariant_totals_object.hpp>
+
+namespace scorum {
+namespace chain {
+
+/**
+ * Keeps invariant_totals_object up to date by observing changes of accounts, escrows, atomicswap contracts,
+ * advertising budgets and bets, so database::validate_invariants does not need to scan them on each block.
+ *
+ * Totals are not tracked until invariant_totals_object is created by reset() (after genesis or when an old
+ * shared memory file is opened).
+ */
+class invariants_tracker
+{
+public:
+    explicit invariants_tracker(dba::db_index& db);
+    ~invariants_tracker();
+
+    /// Calculates totals by full scan of the tracked objects
+    invariant_totals calculate() const;
+
+    /// Creates (or overwrites) invariant_totals_object with calculated totals
+    void reset();
+
+    bool is_tracking() const;
+
+    /// Running totals. Requires is_tracking()
+    const invariant_totals& totals() const;
+
+private:
+    template <typename TObject> void observe();
+
+    dba::db_index& _db;
+};
+}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <scorum/protocol/transaction.hpp>
+
+#include <fc/reflect/reflect.hpp>
+
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+using scorum::protocol::signed_transaction;
+
+/**
+ * Transactions applied to the pending state on top of the head block, in the order of applying.
+ *
+ * The pending state is the result of applying all of them, so any prefix of the pool is a valid sequence of
+ * transactions for the next block and can be taken without re-applying. The pool is reordered by the priority
+ * only when it's released to be applied again on the new head block.
+ */
+class pending_transactions_pool
+{
+public:
+    enum priority_type
+    {
+        /// first received, first included
+        by_arrival,
+        /// transactions that expire sooner are included first
+        by_expiration,
+        /// smaller transactions are included first, so more of them fit in the block
+        by_size
+    };
+
+    struct entry
+    {
+        signed_transaction trx;
+        size_t packed_size = 0;
+    };
+
+    explicit pending_transactions_pool(priority_type priority = by_arrival);
+
+    void set_priority(priority_type priority);
+    priority_type priority() const;
+
+    /// Adds the transaction that has been applied to the pending state
+    void push(const signed_transaction& trx, size_t packed_size);
+
+    /// @returns number of the first transactions fitting in total_size with the size of the block header
+    size_t get_prefix_size(size_t header_size, size_t total_size) const;
+
+    /// Removes the transactions not valid in a block of the time when, @returns number of removed transactions
+    size_t remove_expired(const fc::time_point_sec& when);
+
+    /// @returns transactions ordered by the priority to be applied again, the pool is cleared
+    std::vector<signed_transaction> release();
+
+    void clear();
+
+    const std::vector<entry>& entries() const;
+    size_t size() const;
+    bool empty() const;
+
+private:
+    priority_type _priority;
+    std::vector<entry> _entries;
+};
+}
+}
+
+FC_REFLECT_ENUM(scorum::chain::pending_transactions_pool::priority_type, (by_arrival)(by_expiration)(by_size))
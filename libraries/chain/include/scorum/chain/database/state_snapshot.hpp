@@ -0,0 +1,176 @@
+#pragma once
+
+#include <scorum/protocol/types.hpp>
+
+#include <chainbase/generic_index.hpp>
+
+#include <fc/crypto/sha256.hpp>
+#include <fc/filesystem.hpp>
+#include <fc/io/raw.hpp>
+
+#include <boost/core/demangle.hpp>
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+using scorum::protocol::block_id_type;
+using scorum::protocol::chain_id_type;
+
+static const uint32_t state_snapshot_magic = 0x54534353; // "SCST"
+static const uint32_t state_snapshot_version = 1;
+
+struct state_snapshot_header
+{
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    chain_id_type chain_id;
+    uint32_t head_block_num = 0;
+    block_id_type head_block_id;
+    uint32_t indices_count = 0;
+};
+
+struct index_snapshot_header
+{
+    uint16_t type_id = 0;
+    std::string type_name;
+    int64_t next_id = 0;
+    uint64_t objects_count = 0;
+};
+
+/* The state snapshot is a portable copy of the chainbase state. Objects are serialized with fc::raw, so unlike
+ * the shared memory file it does not depend on the compiler, boost version and memory layout.
+ *
+ * +--------+---------+---------+-----+------------+
+ * | Header | Index 1 | Index 2 | ... | Last Index |
+ * +--------+---------+---------+-----+------------+
+ *
+ * +--------------+---------------+----------+---------------+----------+-----+-------------------------+
+ * | Index Header | Object 1 Size | Object 1 | Object 2 Size | Object 2 | ... | SHA256 of objects bytes |
+ * +--------------+---------------+----------+---------------+----------+-----+-------------------------+
+ *
+ * Indices are written and read one object at a time, so the snapshot never has to fit in memory.
+ */
+class state_snapshot_writer
+{
+public:
+    explicit state_snapshot_writer(const fc::path& file);
+
+    void write_header(const state_snapshot_header& header);
+
+    void begin_index(const index_snapshot_header& header);
+
+    template <typename ObjectType> void write_object(const ObjectType& obj)
+    {
+        _buffer.resize(fc::raw::pack_size(obj));
+
+        fc::datastream<char*> ds(_buffer.data(), _buffer.size());
+        fc::raw::pack(ds, obj);
+
+        write_object_bytes();
+    }
+
+    void end_index();
+
+    void close();
+
+private:
+    void write_object_bytes();
+
+    std::ofstream _stream;
+    std::vector<char> _buffer;
+    fc::sha256::encoder _checksum;
+};
+
+class state_snapshot_reader
+{
+public:
+    explicit state_snapshot_reader(const fc::path& file);
+
+    state_snapshot_header read_header();
+
+    index_snapshot_header begin_index();
+
+    template <typename ObjectType> void read_object(ObjectType& obj)
+    {
+        read_object_bytes();
+
+        fc::datastream<const char*> ds(_buffer.data(), _buffer.size());
+        fc::raw::unpack(ds, obj);
+    }
+
+    /// Checks the checksum of the objects that have been read
+    void end_index();
+
+private:
+    void read_object_bytes();
+
+    std::string _file;
+    std::ifstream _stream;
+    std::vector<char> _buffer;
+    fc::sha256::encoder _checksum;
+    index_snapshot_header _index;
+};
+
+/// Type erased snapshot reading and writing of the registered index
+struct index_snapshot_handler
+{
+    uint16_t type_id = 0;
+    std::string type_name;
+
+    std::function<void(state_snapshot_writer&)> write;
+    std::function<void(state_snapshot_reader&, const index_snapshot_header&)> read;
+};
+
+/// Indices are looked up on each call, so the handler requires the lock of the database
+template <typename MultiIndexType, typename DatabaseType>
+index_snapshot_handler make_index_snapshot_handler(DatabaseType& db)
+{
+    using value_type = typename MultiIndexType::value_type;
+
+    index_snapshot_handler handler;
+    handler.type_id = value_type::type_id;
+    handler.type_name = boost::core::demangle(typeid(value_type).name());
+
+    handler.write = [&db, type_name = handler.type_name](state_snapshot_writer& w) {
+        const auto& idx = db.template get_index<MultiIndexType>();
+
+        FC_ASSERT(!idx.has_undo_history(), "${t} has reversible changes", ("t", type_name));
+
+        index_snapshot_header header;
+        header.type_id = value_type::type_id;
+        header.type_name = type_name;
+        header.next_id = idx.next_id()._id;
+        header.objects_count = idx.indices().size();
+
+        w.begin_index(header);
+        for (const value_type& obj : idx.indices())
+            w.write_object(obj);
+        w.end_index();
+    };
+
+    handler.read = [&db, type_name = handler.type_name](state_snapshot_reader& r, const index_snapshot_header& header) {
+        auto& idx = db.template get_mutable_index<MultiIndexType>();
+
+        FC_ASSERT(idx.indices().empty(), "${t} is not empty", ("t", type_name));
+
+        for (uint64_t i = 0; i < header.objects_count; ++i)
+            idx.load([&](value_type& obj) { r.read_object(obj); });
+
+        idx.set_next_id(header.next_id);
+        r.end_index();
+    };
+
+    return handler;
+}
+}
+}
+
+FC_REFLECT(scorum::chain::state_snapshot_header,
+           (magic)(version)(chain_id)(head_block_num)(head_block_id)(indices_count))
+FC_REFLECT(scorum::chain::index_snapshot_header, (type_id)(type_name)(next_id)(objects_count))
@@ -1,6 +1,7 @@
 #pragma once
 #include <fc/fixed_string.hpp>
 #include <fc/shared_string.hpp>
+#include <fc/uint128.hpp>
 
 #include <scorum/protocol/authority.hpp>
 #include <scorum/protocol/scorum_operations.hpp>
@@ -75,6 +76,12 @@ public:
     asset active_sp_holders_pending_scr_reward = asset(0, SCORUM_SYMBOL);
     asset active_sp_holders_pending_sp_reward = asset(0, SP_SYMBOL);
 
+    ///weight in active SP holders reward pool (accumulator mode), zero if account is out of the pool
+    share_type active_sp_holders_reward_weight = 0;
+    ///reward-per-share indices at the time of the last settlement
+    fc::uint128_t active_sp_holders_scr_reward_per_share;
+    fc::uint128_t active_sp_holders_sp_reward_per_share;
+
     /// This function should be used only when the account votes for a witness directly
     share_type witness_vote_weight() const
     {
@@ -85,6 +92,15 @@ public:
         return std::accumulate(proxied_vsf_votes.begin(), proxied_vsf_votes.end(), share_type());
     }
 
+    /// Votes this account adds to the total of all witness votes (total_scorumpower)
+    share_type circulating_vsf_votes() const
+    {
+        return proxy == SCORUM_PROXY_TO_SELF_ACCOUNT
+            ? witness_vote_weight()
+            : (SCORUM_MAX_PROXY_RECURSION_DEPTH > 0 ? proxied_vsf_votes[SCORUM_MAX_PROXY_RECURSION_DEPTH - 1]
+                                                    : scorumpower.amount);
+    }
+
     asset effective_scorumpower() const
     {
         return scorumpower - delegated_scorumpower + received_scorumpower;
@@ -579,6 +595,9 @@ FC_REFLECT( scorum::chain::account_object,
              (active_sp_holders_cashout_time)
              (active_sp_holders_pending_scr_reward)
              (active_sp_holders_pending_sp_reward)
+             (active_sp_holders_reward_weight)
+             (active_sp_holders_scr_reward_per_share)
+             (active_sp_holders_sp_reward_per_share)
           )
 CHAINBASE_SET_INDEX_TYPE( scorum::chain::account_object, scorum::chain::account_index )
 
@@ -12,6 +12,7 @@ namespace chain {
 
 using scorum::protocol::asset;
 using scorum::protocol::odds;
+using scorum::protocol::odds_key_type;
 using scorum::protocol::wincase_type;
 using scorum::protocol::market_type;
 
@@ -64,8 +65,13 @@ public:
     pending_bet_kind get_kind() const { return data.kind; }
     uuid_type get_uuid() const { return data.uuid; }
     wincase_type get_wincase() const { return data.wincase; }
-
     // clang-format on
+
+    /// price level at which this bet can be matched by the opposite wincase bet
+    odds_key_type get_matching_odds_level() const
+    {
+        return data.odds.inverted_key();
+    }
 };
 
 class matched_bet_object : public object<matched_bet_object_type, matched_bet_object>
@@ -95,6 +101,7 @@ struct by_game_uuid_market;
 struct by_game_uuid_created;
 
 struct by_game_uuid_wincase_asc;
+struct by_game_uuid_wincase_odds;
 
 using bet_uuid_history_index
     = shared_multi_index_container<bet_uuid_history_object,
@@ -140,6 +147,32 @@ using pending_bet_index
                                                                                    std::less<time_point_sec>,
                                                                                    std::less<pending_bet_id_type>>>,
 
+                                              ordered_unique<tag<by_game_uuid_wincase_odds>,
+                                                             composite_key<pending_bet_object,
+                                                                           member<pending_bet_object,
+                                                                                  uuid_type,
+                                                                                  &pending_bet_object::game_uuid>,
+                                                                           const_mem_fun<pending_bet_object,
+                                                                                         wincase_type,
+                                                                                         &pending_bet_object::
+                                                                                             get_wincase>,
+                                                                           const_mem_fun<pending_bet_object,
+                                                                                         odds_key_type,
+                                                                                         &pending_bet_object::
+                                                                                             get_matching_odds_level>,
+                                                                           const_mem_fun<pending_bet_object,
+                                                                                         fc::time_point_sec,
+                                                                                         &pending_bet_object::
+                                                                                             get_created>,
+                                                                           member<pending_bet_object,
+                                                                                  pending_bet_id_type,
+                                                                                  &pending_bet_object::id>>,
+                                                             composite_key_compare<std::less<uuid_type>,
+                                                                                   std::less<wincase_type>,
+                                                                                   std::less<odds_key_type>,
+                                                                                   std::less<time_point_sec>,
+                                                                                   std::less<pending_bet_id_type>>>,
+
                                               ordered_unique<tag<by_game_uuid_kind>,
                                                              composite_key<pending_bet_object,
                                                                            member<pending_bet_object,
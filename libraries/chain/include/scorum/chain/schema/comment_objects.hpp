@@ -9,6 +9,8 @@
 #include <scorum/chain/schema/scorum_object_types.hpp>
 #include <scorum/chain/schema/witness_objects.hpp>
 
+#include <scorum/chain/comment_content_store.hpp>
+
 #include <boost/multi_index/composite_key.hpp>
 
 #include <limits>
@@ -23,8 +25,7 @@ class comment_object : public object<comment_object_type, comment_object>
 {
 public:
     /// \cond DO_NOT_DOCUMENT
-    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(
-        comment_object, (category)(parent_permlink)(permlink)(title)(body)(json_metadata)(beneficiaries))
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(comment_object, (category)(parent_permlink)(permlink)(beneficiaries))
 
     id_type id;
 
@@ -34,9 +35,8 @@ public:
     account_name_type author;
     fc::shared_string permlink;
 
-    fc::shared_string title;
-    fc::shared_string body;
-    fc::shared_string json_metadata;
+    /// title, body and json_metadata in the comment content store
+    comment_content_ref content;
     time_point_sec last_update;
     time_point_sec created;
 
@@ -344,9 +344,7 @@ FC_REFLECT( scorum::chain::comment_object,
             (category)
             (parent_author)
             (parent_permlink)
-            (title)
-            (body)
-            (json_metadata)
+            (content)
             (last_update)
             (created)
             (active)
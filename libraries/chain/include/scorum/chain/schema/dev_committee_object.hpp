@@ -78,6 +78,8 @@ FC_REFLECT(scorum::chain::dev_committee_object,
            (betting_resolve_delay_quorum))
 // clang-format on
 
+FC_REFLECT(scorum::chain::dev_committee_member_object, (id)(account))
+
 CHAINBASE_SET_INDEX_TYPE(scorum::chain::dev_committee_object, scorum::chain::dev_committee_index)
 
 CHAINBASE_SET_INDEX_TYPE(scorum::chain::dev_committee_member_object, scorum::chain::dev_committee_member_index)
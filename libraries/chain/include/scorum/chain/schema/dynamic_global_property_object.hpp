@@ -41,6 +41,33 @@ struct betting_total_stats
     asset matched_bets_volume = asset(0, SCORUM_SYMBOL);
 };
 
+/**
+ * Active SP holders reward accumulator.
+ *
+ * Since hardfork #8 per block active SP holders reward is not distributed to every holder. It is added to the
+ * reward-per-share indices and settled into account pending balances when account leaves the pool, votes or reaches
+ * its cashout time (see account_object::active_sp_holders_reward_weight).
+ */
+struct active_sp_holders_reward_accumulator
+{
+    /// accumulator mode is switched on by hardfork #8
+    bool enabled = false;
+
+    /// sum of weights of accounts in the reward pool
+    share_type total_weight = 0;
+
+    /// accumulated reward per weight unit (scaled by SCORUM_ACTIVE_SP_HOLDERS_REWARD_PRECISION)
+    fc::uint128_t scr_reward_per_share;
+    fc::uint128_t sp_reward_per_share;
+
+    /// reward added to the indices which is not settled to accounts yet
+    asset scr_pool = asset(0, SCORUM_SYMBOL);
+    asset sp_pool = asset(0, SP_SYMBOL);
+
+    /// head block time of the last pool expiration pass
+    time_point_sec last_expiration_time;
+};
+
 /**
  * @class dynamic_global_property_object
  * @brief Maintains global state information
@@ -123,6 +150,9 @@ public:
 
     /// this section display information about betting totals
     betting_total_stats betting_stats;
+
+    /// active SP holders reward accumulator state
+    active_sp_holders_reward_accumulator active_sp_holders_reward;
 };
 
 typedef shared_multi_index_container<dynamic_global_property_object,
@@ -156,11 +186,20 @@ FC_REFLECT(scorum::chain::dynamic_global_property_object,
           (participation_count)
           (last_irreversible_block_num)
           (advertising)
-          (betting_stats))
+          (betting_stats)
+          (active_sp_holders_reward))
 
 FC_REFLECT(scorum::chain::adv_total_stats::budget_type_stat, (volume)(budget_pending_outgo)(owner_pending_income))
 FC_REFLECT(scorum::chain::adv_total_stats, (post_budgets)(banner_budgets))
 FC_REFLECT(scorum::chain::betting_total_stats, (pending_bets_volume)(matched_bets_volume))
+FC_REFLECT(scorum::chain::active_sp_holders_reward_accumulator,
+           (enabled)
+           (total_weight)
+           (scr_reward_per_share)
+           (sp_reward_per_share)
+           (scr_pool)
+           (sp_pool)
+           (last_expiration_time))
 // clang-format on
 
 CHAINBASE_SET_INDEX_TYPE(scorum::chain::dynamic_global_property_object, scorum::chain::dynamic_global_property_index)
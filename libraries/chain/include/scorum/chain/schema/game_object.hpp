@@ -20,7 +20,7 @@ using scorum::protocol::wincase_type;
 
 struct by_name;
 struct by_uuid;
-struct by_start_time;
+struct by_status_start_time;
 struct by_bets_resolve_time;
 struct by_auto_resolve_time;
 
@@ -100,8 +100,11 @@ using game_index
                                                                                   game_object::id_type,
                                                                                   &game_object::id>>>,
 
-                                              ordered_unique<tag<by_start_time>,
+                                              ordered_unique<tag<by_status_start_time>,
                                                              composite_key<game_object,
+                                                                           member<game_object,
+                                                                                  game_status,
+                                                                                  &game_object::status>,
                                                                            member<game_object,
                                                                                   fc::time_point_sec,
                                                                                   &game_object::start_time>,
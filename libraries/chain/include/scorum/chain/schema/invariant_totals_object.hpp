@@ -0,0 +1,102 @@
+#pragma once
+
+#include <scorum/chain/schema/scorum_object_types.hpp>
+
+namespace scorum {
+namespace chain {
+
+using scorum::protocol::asset;
+
+/// Sums over the objects which are too many to be scanned on each block by database::validate_invariants
+struct invariant_totals
+{
+    /// sum of all account SCR balances
+    asset accounts_scr = asset(0, SCORUM_SYMBOL);
+
+    /// sum of all account SP balances
+    asset accounts_sp = asset(0, SP_SYMBOL);
+
+    /// sum of all account pending SCR rewards
+    asset accounts_pending_scr = asset(0, SCORUM_SYMBOL);
+
+    /// sum of all account pending SP rewards
+    asset accounts_pending_sp = asset(0, SP_SYMBOL);
+
+    /// sum of all account witness votes (including proxied)
+    share_type accounts_vsf_votes = 0;
+
+    /// sum of escrow balances and pending fees
+    asset escrows_balance = asset(0, SCORUM_SYMBOL);
+
+    /// sum of atomicswap contract amounts
+    asset atomicswap_contracts_balance = asset(0, SCORUM_SYMBOL);
+
+    /// sum of post and banner budget balances, owner pending incomes and budget pending outgoes
+    asset adv_budgets_balance = asset(0, SCORUM_SYMBOL);
+
+    /// sum of pending bet stakes
+    asset pending_bets_stake = asset(0, SCORUM_SYMBOL);
+
+    /// sum of matched bet stakes (both sides)
+    asset matched_bets_stake = asset(0, SCORUM_SYMBOL);
+};
+
+inline bool operator==(const invariant_totals& lhs, const invariant_totals& rhs)
+{
+    return lhs.accounts_scr == rhs.accounts_scr && lhs.accounts_sp == rhs.accounts_sp
+        && lhs.accounts_pending_scr == rhs.accounts_pending_scr && lhs.accounts_pending_sp == rhs.accounts_pending_sp
+        && lhs.accounts_vsf_votes == rhs.accounts_vsf_votes && lhs.escrows_balance == rhs.escrows_balance
+        && lhs.atomicswap_contracts_balance == rhs.atomicswap_contracts_balance
+        && lhs.adv_budgets_balance == rhs.adv_budgets_balance && lhs.pending_bets_stake == rhs.pending_bets_stake
+        && lhs.matched_bets_stake == rhs.matched_bets_stake;
+}
+
+inline bool operator!=(const invariant_totals& lhs, const invariant_totals& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * Running invariant totals. It is updated from object changes by invariants_tracker and lives in chainbase
+ * to be reverted by undo together with the objects it sums.
+ */
+class invariant_totals_object : public object<invariant_totals_object_type, invariant_totals_object>
+{
+public:
+    /// @cond DO_NOT_DOCUMENT
+    CHAINBASE_DEFAULT_CONSTRUCTOR(invariant_totals_object)
+    /// @endcond
+
+    id_type id;
+
+    invariant_totals totals;
+};
+
+typedef shared_multi_index_container<invariant_totals_object,
+                                     indexed_by<ordered_unique<tag<by_id>,
+                                                               member<invariant_totals_object,
+                                                                      invariant_totals_object::id_type,
+                                                                      &invariant_totals_object::id>>>>
+    invariant_totals_index;
+}
+}
+
+// clang-format off
+FC_REFLECT(scorum::chain::invariant_totals,
+           (accounts_scr)
+           (accounts_sp)
+           (accounts_pending_scr)
+           (accounts_pending_sp)
+           (accounts_vsf_votes)
+           (escrows_balance)
+           (atomicswap_contracts_balance)
+           (adv_budgets_balance)
+           (pending_bets_stake)
+           (matched_bets_stake))
+
+FC_REFLECT(scorum::chain::invariant_totals_object,
+           (id)
+           (totals))
+// clang-format on
+
+CHAINBASE_SET_INDEX_TYPE(scorum::chain::invariant_totals_object, scorum::chain::invariant_totals_index)
@@ -46,5 +46,6 @@ class bet_uuid_history_object;
 class game_uuid_history_object;
 class nft_object;
 class game_round_object;
+class invariant_totals_object;
 }
 }
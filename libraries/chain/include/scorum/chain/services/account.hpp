@@ -136,6 +136,14 @@ struct account_service_i : public base_service_i<account_object>
 
     virtual void update_active_sp_holders_cashout_time(const account_object& account) = 0;
 
+    /// switches active SP holders reward to accumulator mode and puts current active SP holders to the pool
+    virtual void enable_active_sp_holders_reward_pool() = 0;
+
+    /// moves reward accrued by account in the pool to account pending reward
+    virtual void settle_active_sp_holders_reward(const account_object& account) = 0;
+
+    virtual void leave_active_sp_holders_reward_pool(const account_object& account) = 0;
+
     virtual void update_owner_authority(const account_object& account, const authority& owner_authority) = 0;
 
     virtual void create_account_recovery(const account_name_type& account_to_recover_name,
@@ -176,6 +184,10 @@ struct account_service_i : public base_service_i<account_object>
     virtual accounts_total accounts_circulating_capital() const = 0;
 
     virtual account_refs_type get_by_cashout_time(const fc::time_point_sec& until) const = 0;
+
+    /// accounts with voting power restoring time in (from, until]
+    virtual account_refs_type get_by_voting_power_restoring_time(const fc::time_point_sec& from,
+                                                                 const fc::time_point_sec& until) const = 0;
 };
 
 // DB operations with account_*** objects
@@ -291,6 +303,12 @@ public:
 
     virtual void update_active_sp_holders_cashout_time(const account_object& account) override;
 
+    virtual void enable_active_sp_holders_reward_pool() override;
+
+    virtual void settle_active_sp_holders_reward(const account_object& account) override;
+
+    virtual void leave_active_sp_holders_reward_pool(const account_object& account) override;
+
     virtual void update_owner_authority(const account_object& account, const authority& owner_authority) override;
 
     virtual void create_account_recovery(const account_name_type& account_to_recover_name,
@@ -329,7 +347,12 @@ public:
 
     virtual account_refs_type get_by_cashout_time(const fc::time_point_sec& until) const override;
 
+    virtual account_refs_type get_by_voting_power_restoring_time(const fc::time_point_sec& from,
+                                                                 const fc::time_point_sec& until) const override;
+
 private:
+    void enter_active_sp_holders_reward_pool(const account_object& account);
+
     dynamic_global_property_service_i& _dgp_svc;
     witness_service_i& _witness_svc;
 };
@@ -28,6 +28,12 @@ struct comment_service_i : public base_service_i<comment_object>
                                            const std::string& parent_permlink) const = 0;
 
     virtual void set_rewarded_flag(const comment_object& comment) = 0;
+
+    /// @returns title, body and json_metadata of the comment from the comment content store
+    virtual comment_content get_content(const comment_object& comment) const = 0;
+
+    /// Appends the content to the comment content store, the returned reference is to be set to the comment
+    virtual comment_content_ref store_content(const comment_content& content) = 0;
 };
 
 class dbs_comment : public dbs_service_base<comment_service_i>
@@ -54,6 +60,13 @@ public:
                                    const std::string& parent_permlink) const override;
 
     void set_rewarded_flag(const comment_object& comment) override;
+
+    comment_content get_content(const comment_object& comment) const override;
+
+    comment_content_ref store_content(const comment_content& content) override;
+
+private:
+    comment_content_store& _content_store;
 };
 } // namespace chain
 } // namespace scorum
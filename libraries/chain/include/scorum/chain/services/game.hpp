@@ -33,7 +33,8 @@ struct game_service_i : public base_service_i<game_object>
     virtual const game_object& get_game(int64_t game_id) const = 0;
     virtual const game_object& get_game(const uuid_type& uuid) const = 0;
 
-    virtual std::vector<object_cref_type> get_games(fc::time_point_sec start) const = 0;
+    /// games in 'created' status with start time not later than @p start
+    virtual std::vector<object_cref_type> get_games_to_start(fc::time_point_sec start) const = 0;
 };
 
 class dbs_game : public dbs_service_base<game_service_i>
@@ -60,7 +61,7 @@ public:
 
     virtual const game_object& get_game(int64_t game_id) const override;
     virtual const game_object& get_game(const uuid_type& uuid) const override;
-    virtual std::vector<object_cref_type> get_games(fc::time_point_sec start) const override;
+    virtual std::vector<object_cref_type> get_games_to_start(fc::time_point_sec start) const override;
 
 private:
     dynamic_global_property_service_i& _dprops_service;
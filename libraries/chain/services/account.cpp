@@ -458,6 +458,9 @@ void dbs_account::update_voting_power(const account_object& account, uint16_t vo
         update_active_sp_holders_cashout_time(account);
     }
 
+    // reward weight is changing, so settle reward accrued with previous weight
+    leave_active_sp_holders_reward_pool(account);
+
     time_point_sec t = _dgp_svc.head_block_time();
 
     update(account, [&](account_object& a) {
@@ -467,6 +470,8 @@ void dbs_account::update_voting_power(const account_object& account, uint16_t vo
             voting_power, t, SCORUM_VOTE_REGENERATION_SECONDS);
         a.vote_reward_competitive_sp = a.effective_scorumpower();
     });
+
+    enter_active_sp_holders_reward_pool(account);
 }
 
 void dbs_account::update_active_sp_holders_cashout_time(const account_object& account)
@@ -480,6 +485,108 @@ void dbs_account::update_active_sp_holders_cashout_time(const account_object& ac
     }
 }
 
+void dbs_account::enable_active_sp_holders_reward_pool()
+{
+    if (_dgp_svc.get().active_sp_holders_reward.enabled)
+        return;
+
+    _dgp_svc.update([&](dynamic_global_property_object& props) {
+        props.active_sp_holders_reward.enabled = true;
+        props.active_sp_holders_reward.last_expiration_time = props.time;
+    });
+
+    for (const account_object& account : get_active_sp_holders())
+    {
+        enter_active_sp_holders_reward_pool(account);
+    }
+}
+
+namespace {
+asset calculate_accrued_reward(share_type weight,
+                               const fc::uint128_t& reward_per_share,
+                               const fc::uint128_t& checkpoint,
+                               const asset& pool)
+{
+    const fc::uint128_t precision(SCORUM_ACTIVE_SP_HOLDERS_REWARD_PRECISION);
+
+    // round down, so accruals of all holders never exceed the pool. Remainder goes back to the fund
+    // when the pool empties
+    fc::uint128_t accrued = fc::uint128_t(weight.value) * (reward_per_share - checkpoint) / precision;
+
+    FC_ASSERT(accrued <= fc::uint128_t(pool.amount.value), "Accrued active SP holders reward exceeds the pool",
+              ("accrued", accrued.to_uint64())("pool", pool));
+
+    return asset(static_cast<share_value_type>(accrued.to_uint64()), pool.symbol());
+}
+}
+
+void dbs_account::settle_active_sp_holders_reward(const account_object& account)
+{
+    const auto& accumulator = _dgp_svc.get().active_sp_holders_reward;
+
+    if (!accumulator.enabled || account.active_sp_holders_reward_weight <= 0)
+        return;
+
+    asset reward_scr
+        = calculate_accrued_reward(account.active_sp_holders_reward_weight, accumulator.scr_reward_per_share,
+                                   account.active_sp_holders_scr_reward_per_share, accumulator.scr_pool);
+    asset reward_sp
+        = calculate_accrued_reward(account.active_sp_holders_reward_weight, accumulator.sp_reward_per_share,
+                                   account.active_sp_holders_sp_reward_per_share, accumulator.sp_pool);
+
+    update(account, [&](account_object& a) {
+        a.active_sp_holders_scr_reward_per_share = accumulator.scr_reward_per_share;
+        a.active_sp_holders_sp_reward_per_share = accumulator.sp_reward_per_share;
+    });
+
+    _dgp_svc.update([&](dynamic_global_property_object& props) {
+        props.active_sp_holders_reward.scr_pool -= reward_scr;
+        props.active_sp_holders_reward.sp_pool -= reward_sp;
+    });
+
+    if (reward_scr.amount > 0)
+        increase_pending_balance(account, reward_scr);
+
+    if (reward_sp.amount > 0)
+        increase_pending_scorumpower(account, reward_sp);
+}
+
+void dbs_account::enter_active_sp_holders_reward_pool(const account_object& account)
+{
+    const auto& accumulator = _dgp_svc.get().active_sp_holders_reward;
+
+    if (!accumulator.enabled || account.active_sp_holders_reward_weight > 0)
+        return;
+
+    if (account.voting_power_restoring_time <= _dgp_svc.head_block_time()
+        || account.vote_reward_competitive_sp.amount <= 0)
+        return;
+
+    update(account, [&](account_object& a) {
+        a.active_sp_holders_reward_weight = a.vote_reward_competitive_sp.amount;
+        a.active_sp_holders_scr_reward_per_share = accumulator.scr_reward_per_share;
+        a.active_sp_holders_sp_reward_per_share = accumulator.sp_reward_per_share;
+    });
+
+    _dgp_svc.update([&](dynamic_global_property_object& props) {
+        props.active_sp_holders_reward.total_weight += account.active_sp_holders_reward_weight;
+    });
+}
+
+void dbs_account::leave_active_sp_holders_reward_pool(const account_object& account)
+{
+    if (account.active_sp_holders_reward_weight <= 0)
+        return;
+
+    settle_active_sp_holders_reward(account);
+
+    _dgp_svc.update([&](dynamic_global_property_object& props) {
+        props.active_sp_holders_reward.total_weight -= account.active_sp_holders_reward_weight;
+    });
+
+    update(account, [&](account_object& a) { a.active_sp_holders_reward_weight = 0; });
+}
+
 void dbs_account::create_account_recovery(const account_name_type& account_to_recover,
                                           const authority& new_owner_authority)
 {
@@ -709,6 +816,17 @@ dbs_account::account_refs_type dbs_account::get_by_cashout_time(const fc::time_p
     FC_CAPTURE_AND_RETHROW((until))
 }
 
+dbs_account::account_refs_type dbs_account::get_by_voting_power_restoring_time(const fc::time_point_sec& from,
+                                                                              const fc::time_point_sec& until) const
+{
+    try
+    {
+        return get_range_by<by_voting_power_restoring_time>(from < ::boost::lambda::_1,
+                                                            ::boost::lambda::_1 <= until);
+    }
+    FC_CAPTURE_AND_RETHROW((from)(until))
+}
+
 accounts_total dbs_account::accounts_circulating_capital() const
 {
     accounts_total totals;
@@ -721,11 +839,7 @@ accounts_total dbs_account::accounts_circulating_capital() const
         totals.pending_scr += itr->active_sp_holders_pending_scr_reward;
         totals.pending_sp += itr->active_sp_holders_pending_sp_reward;
 
-        totals.vsf_votes += (itr->proxy == SCORUM_PROXY_TO_SELF_ACCOUNT
-                                 ? itr->witness_vote_weight()
-                                 : (SCORUM_MAX_PROXY_RECURSION_DEPTH > 0
-                                        ? itr->proxied_vsf_votes[SCORUM_MAX_PROXY_RECURSION_DEPTH - 1]
-                                        : itr->scorumpower.amount));
+        totals.vsf_votes += itr->circulating_vsf_votes();
     }
 
     return totals;
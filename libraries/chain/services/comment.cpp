@@ -13,6 +13,7 @@ namespace chain {
 
 dbs_comment::dbs_comment(database& db)
     : base_service_type(db)
+    , _content_store(db.get_comment_content_store())
 {
 }
 
@@ -82,5 +83,19 @@ void dbs_comment::set_rewarded_flag(const comment_object& comment)
     FC_CAPTURE_AND_RETHROW((comment.author)(comment.permlink))
 }
 
+comment_content dbs_comment::get_content(const comment_object& comment) const
+{
+    try
+    {
+        return _content_store.read(comment.content);
+    }
+    FC_CAPTURE_AND_RETHROW((comment.author)(comment.permlink))
+}
+
+comment_content_ref dbs_comment::store_content(const comment_content& content)
+{
+    return _content_store.append(content);
+}
+
 } // namespace chain
 } // namespace scorum
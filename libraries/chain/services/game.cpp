@@ -86,10 +86,11 @@ const game_object& dbs_game::get_game(const uuid_type& uuid) const
     return get_by<by_uuid>(uuid);
 }
 
-std::vector<dbs_game::object_cref_type> dbs_game::get_games(fc::time_point_sec start) const
+std::vector<dbs_game::object_cref_type> dbs_game::get_games_to_start(fc::time_point_sec start) const
 {
-    return get_range_by<by_start_time>(::boost::multi_index::unbounded,
-                                       ::boost::lambda::_1 <= std::make_tuple(start, ALL_IDS));
+    return get_range_by<by_status_start_time>(
+        std::make_tuple(game_status::created) <= ::boost::lambda::_1,
+        ::boost::lambda::_1 <= std::make_tuple(game_status::created, start, ALL_IDS));
 }
 
 } // namespace scorum
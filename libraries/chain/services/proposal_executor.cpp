@@ -62,11 +62,19 @@ void dbs_proposal_executor::execute_proposal(const proposal_object& proposal)
     {
         auto& evaluator = evaluators.get_evaluator(proposal.operation);
 
-        auto note = _db.create_notification(proposal_virtual_operation(proposal.operation));
+        const operation op = proposal_virtual_operation(proposal.operation);
+        if (_db.is_operation_observed(op))
+        {
+            auto note = _db.create_notification(op);
 
-        _db.notify_pre_apply_operation(note);
-        evaluator.apply(proposal.operation);
-        _db.notify_post_apply_operation(note);
+            _db.notify_pre_apply_operation(note);
+            evaluator.apply(proposal.operation);
+            _db.notify_post_apply_operation(note);
+        }
+        else
+        {
+            evaluator.apply(proposal.operation);
+        }
 
         proposal_service.remove(proposal);
     }
@@ -1,5 +1,9 @@
 #include <chainbase/chainbase.hpp>
 
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <fstream>
+
 namespace chainbase {
 
 database::~database()
@@ -36,6 +40,21 @@ void database::create_meta_file(const boost::filesystem::path& file)
     }
 }
 
+void database::create_readers_file(const boost::filesystem::path& file, bool read_only)
+{
+    _readers_file = file;
+
+    if (!boost::filesystem::exists(file))
+        std::ofstream(file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app);
+
+    if (read_only)
+    {
+        // waits while the file is being grown
+        _readers_flock = boost::interprocess::file_lock(file.generic_string().c_str());
+        _readers_flock.lock_sharable();
+    }
+}
+
 boost::filesystem::path database::shared_memory_path(const boost::filesystem::path& data_dir)
 {
     return data_dir / "shared_memory.bin";
@@ -46,6 +65,11 @@ boost::filesystem::path database::shared_memory_meta_path(const boost::filesyste
     return data_dir / "shared_memory.meta";
 }
 
+boost::filesystem::path database::shared_memory_readers_path(const boost::filesystem::path& data_dir)
+{
+    return data_dir / "shared_memory.readers";
+}
+
 void database::open(const boost::filesystem::path& dir, uint32_t flags, uint64_t shared_file_size)
 {
     bool read_only = !(flags & database::read_write);
@@ -54,7 +78,11 @@ void database::open(const boost::filesystem::path& dir, uint32_t flags, uint64_t
 
     close();
 
+    // read only process must not map the file that is being grown
+    create_readers_file(shared_memory_readers_path(dir), read_only);
+
     create_segment_file(shared_memory_path(dir), read_only, shared_file_size);
+    _grow_count = 0;
 
     create_meta_file(shared_memory_meta_path(dir));
 
@@ -75,11 +103,44 @@ void database::flush()
         _meta->flush();
 }
 
+bool database::grow(uint64_t size_increment)
+{
+    require_write_lock(__FUNCTION__, "shared memory");
+
+    // read only processes don't remap the file, objects allocated in the new part would be out of their mapping.
+    // The lock is held while growing, so they can't map the file in the middle
+    boost::interprocess::file_lock readers_flock(_readers_file.generic_string().c_str());
+    boost::interprocess::scoped_lock<boost::interprocess::file_lock> readers_lock(readers_flock,
+                                                                                 boost::interprocess::try_to_lock);
+    if (!readers_lock.owns())
+        return false;
+
+    // indices keep their offsets in the segment, only the address of the mapping can be changed
+    const char* old_address = static_cast<const char*>(_segment->get_address());
+
+    boost::container::flat_map<uint16_t, std::ptrdiff_t> offsets;
+    for (const auto& item : _index_map)
+        offsets[item.first] = static_cast<const char*>(item.second) - old_address;
+
+    grow_segment_file(size_increment);
+
+    char* new_address = static_cast<char*>(_segment->get_address());
+
+    for (auto& item : _index_map)
+        item.second = new_address + offsets[item.first];
+
+    ++_grow_count;
+
+    return true;
+}
+
 void database::close()
 {
     close_segment_file();
 
     _meta.reset();
+
+    _readers_flock = boost::interprocess::file_lock();
 }
 
 void database::wipe(const boost::filesystem::path& dir)
@@ -88,6 +149,7 @@ void database::wipe(const boost::filesystem::path& dir)
 
     boost::filesystem::remove_all(shared_memory_path(dir));
     boost::filesystem::remove_all(shared_memory_meta_path(dir));
+    boost::filesystem::remove_all(shared_memory_readers_path(dir));
     _index_map.clear();
 }
 
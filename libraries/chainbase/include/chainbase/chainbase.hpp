@@ -11,11 +11,16 @@ class database : public undo_db_state
 {
     boost::interprocess::file_lock _flock;
 
+    /// read only processes hold the sharable lock on it while the shared memory file is mapped
+    boost::interprocess::file_lock _readers_flock;
+    boost::filesystem::path _readers_file;
+
     std::unique_ptr<boost::interprocess::managed_mapped_file> _meta;
 
 private:
     void check_dir_existance(const boost::filesystem::path& dir, bool read_only);
     void create_meta_file(const boost::filesystem::path& file);
+    void create_readers_file(const boost::filesystem::path& file, bool read_only);
 
 public:
     virtual ~database();
@@ -28,11 +33,29 @@ public:
 
     static boost::filesystem::path shared_memory_path(const boost::filesystem::path& data_dir);
     static boost::filesystem::path shared_memory_meta_path(const boost::filesystem::path& data_dir);
+    static boost::filesystem::path shared_memory_readers_path(const boost::filesystem::path& data_dir);
 
     void open(const boost::filesystem::path& dir, uint32_t write = read_only, uint64_t shared_file_size = 0);
     void close();
     void flush();
     void wipe(const boost::filesystem::path& dir);
+
+    /**
+    * Extends the shared memory file by size_increment bytes without closing the database.
+    * It has to be called under the write lock while there are no undo sessions and no references to objects.
+    *
+    * @returns false if the file is opened by read only processes, they would keep mapping the old size
+    */
+    bool grow(uint64_t size_increment);
+
+    /// @returns how many times the shared memory file has been grown since open
+    uint32_t grow_count() const
+    {
+        return _grow_count;
+    }
+
+private:
+    uint32_t _grow_count = 0;
 };
 
 } // namespace chainbase
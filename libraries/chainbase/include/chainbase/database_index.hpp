@@ -1,10 +1,13 @@
 #pragma once
 
+#include <memory>
+
 #include <boost/container/flat_map.hpp>
 
 #include <chainbase/chain_object.hpp>
 #include <chainbase/database_guard.hpp>
 #include <chainbase/generic_index.hpp>
+#include <chainbase/object_observer.hpp>
 
 namespace chainbase {
 
@@ -149,13 +152,26 @@ public:
     {
         CHAINBASE_REQUIRE_WRITE_LOCK(ObjectType);
         typedef typename get_index_type<ObjectType>::type index_type;
-        get_mutable_index<index_type>().modify(obj, m);
+
+        auto observer = get_observer<ObjectType>();
+        if (!observer)
+        {
+            get_mutable_index<index_type>().modify(obj, m);
+            return;
+        }
+
+        get_mutable_index<index_type>().modify(
+            obj, m, [&](const ObjectType& old_obj) { observer->on_modify(old_obj, obj); });
     }
 
     template <typename ObjectType> auto remove(const ObjectType& obj)
     {
         CHAINBASE_REQUIRE_WRITE_LOCK(ObjectType);
         typedef typename get_index_type<ObjectType>::type index_type;
+
+        if (auto observer = get_observer<ObjectType>())
+            observer->on_remove(obj); // obj is invalid after removing
+
         return get_mutable_index<index_type>().remove(obj);
     }
 
@@ -163,7 +179,39 @@ public:
     {
         CHAINBASE_REQUIRE_WRITE_LOCK(ObjectType);
         typedef typename get_index_type<ObjectType>::type index_type;
-        return get_mutable_index<index_type>().emplace(std::forward<Constructor>(con));
+
+        const ObjectType& obj = get_mutable_index<index_type>().emplace(std::forward<Constructor>(con));
+
+        if (auto observer = get_observer<ObjectType>())
+            observer->on_create(obj);
+
+        return obj;
+    }
+
+    /**
+    * Sets (or resets with nullptr) the only observer of ObjectType changes.
+    * Observers are process local and are not stored in shared memory.
+    */
+    template <typename ObjectType> void set_observer(std::shared_ptr<object_observer<ObjectType>> observer)
+    {
+        const uint16_t type_id = ObjectType::type_id;
+
+        if (observer)
+            _observers[type_id] = observer;
+        else
+            _observers.erase(type_id);
+    }
+
+    template <typename ObjectType> object_observer<ObjectType>* get_observer() const
+    {
+        if (_observers.empty())
+            return nullptr;
+
+        auto itr = _observers.find((uint16_t)ObjectType::type_id);
+        if (itr == _observers.end())
+            return nullptr;
+
+        return static_cast<object_observer<ObjectType>*>(itr->second.get());
     }
 
 protected:
@@ -171,5 +219,7 @@ protected:
     * This is a full map (size 2^16) of all possible index designed for constant time lookup
     */
     boost::container::flat_map<uint16_t, void*> _index_map;
+
+    boost::container::flat_map<uint16_t, std::shared_ptr<void>> _observers;
 };
 }
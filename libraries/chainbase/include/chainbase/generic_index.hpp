@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/throw_exception.hpp>
+#include <array>
 #include <stdexcept>
 
 #include <fc/shared_containers.hpp>
@@ -125,53 +126,67 @@ public:
     using base_index_type = base_index<MultiIndexType>;
 
 private:
-    //------------------------------------------//
-    class undo_state
-    {
-    public:
-        using id_type = typename value_type::id_type;
-        using id_type_set = fc::shared_set<id_type>;
-        using id_value_type_map = fc::shared_map<id_type, value_type>;
-
-        template <typename T>
-        undo_state(const fc::shared_allocator<T>& al)
-            : old_values(al)
-            , removed_values(al)
-            , new_ids(al)
-        {
-        }
+    using id_type = typename value_type::id_type;
 
-        id_value_type_map old_values;
-        id_value_type_map removed_values;
-        id_type_set new_ids;
+    //------------------------------------------//
+    /**
+    *  Session boundary in the undo log. The session owns log records from 'start' up to the start of the next
+    *  session (or the end of the log).
+    */
+    struct undo_state
+    {
+        uint64_t start = 0;
         id_type old_next_id = 0;
         int64_t revision = 0;
     };
 
+    // number of entries of the table to find out if object has been recorded in the head session
+    static const size_t undo_dedup_table_size = 4096;
+
 public:
     template <typename Allocator>
     generic_index(const Allocator& a)
         : base_index_type(a)
         , _stack(a)
+        , _log(a)
     {
+        _recorded_at.fill(0);
     }
 
     template <typename Constructor> const value_type& emplace(Constructor&& c)
     {
-        const value_type& value = base_index_type::emplace(c);
-
-        on_create(value);
-
-        return value;
+        // nothing to record, objects with id >= old_next_id are removed by undo
+        return base_index_type::emplace(c);
     }
 
     template <typename Modifier> void modify(const value_type& obj, Modifier&& m)
     {
-        auto unmodified_copy = obj;
+        on_modify(obj);
 
         base_index_type::modify(obj, m);
+    }
 
-        on_modify(unmodified_copy);
+    /**
+    * Same as modify(obj, m) but passes the unmodified copy (it is made for undo anyway) to the callback
+    * after the object has been modified.
+    */
+    template <typename Modifier, typename Callback> void modify(const value_type& obj, Modifier&& m, Callback&& cb)
+    {
+        const value_type* recorded = on_modify(obj);
+        if (recorded)
+        {
+            base_index_type::modify(obj, m);
+
+            cb(*recorded);
+        }
+        else
+        {
+            auto unmodified_copy = obj;
+
+            base_index_type::modify(obj, m);
+
+            cb(static_cast<const value_type&>(unmodified_copy));
+        }
     }
 
     auto remove(const value_type& obj)
@@ -181,13 +196,48 @@ public:
         return base_index_type::remove(obj);
     }
 
+    /// @returns id that will be assigned to the next created object
+    id_type next_id() const
+    {
+        return this->_next_id;
+    }
+
+    /// @returns true if there are changes that can be undone (the state is not at the last commit)
+    bool has_undo_history() const
+    {
+        return enabled();
+    }
+
+    /**
+    * Inserts the object with the id set by the constructor. It's used to load the saved state into the index
+    * without undo history, next_id has to be restored by set_next_id after loading.
+    */
+    template <typename Constructor> const value_type& load(Constructor&& c)
+    {
+        if (enabled())
+            BOOST_THROW_EXCEPTION(std::logic_error("cannot load objects while there is an existing undo stack"));
+
+        return base_index_type::emplace_(c, this->get_allocator());
+    }
+
+    void set_next_id(id_type next_id)
+    {
+        if (enabled())
+            BOOST_THROW_EXCEPTION(std::logic_error("cannot set next id while there is an existing undo stack"));
+
+        this->_next_id = next_id;
+    }
+
 private:
     // abstract_generic_index_i interface
     abstract_undo_session_ptr start_undo_session() override
     {
-        _stack.emplace_back(this->get_allocator());
-        _stack.back().old_next_id = this->_next_id;
-        _stack.back().revision = ++_revision;
+        undo_state state;
+        state.start = log_end();
+        state.old_next_id = this->_next_id;
+        state.revision = ++_revision;
+
+        _stack.push_back(state);
 
         return abstract_undo_session_ptr(new session(*this));
     }
@@ -195,31 +245,53 @@ private:
     /**
     *  Restores the state to how it was prior to the current session discarding all changes
     *  made between the last revision and the current revision.
+    *
+    *  Objects created in the session are removed, then the recorded objects are restored so the oldest record
+    *  (the value before the session) wins. The existing objects are restored before the removed ones are inserted
+    *  again, as a removed object can have the unique key that an existing object has taken after the removal.
     */
     void undo() override
     {
         if (!enabled())
             return;
 
-        const auto& head = _stack.back();
+        const undo_state head = _stack.back();
 
-        for (auto& item : head.old_values)
+        for (id_type id = head.old_next_id; id < this->_next_id; ++id)
         {
-            base_index_type::modify(this->get(item.second.id), [&](value_type& v) { v = std::move(item.second); });
+            auto obj = this->find(id);
+            if (obj)
+                base_index_type::remove(*obj);
         }
 
-        for (auto id : head.new_ids)
+        // objects created in the session that has been squashed to this one are skipped
+
+        for (uint64_t pos = log_end(); pos > head.start; --pos)
         {
-            base_index_type::remove(this->get(id));
-        }
+            auto& recorded = record(pos - 1);
+            if (recorded.id >= head.old_next_id)
+                continue;
 
-        this->_next_id = head.old_next_id;
+            auto obj = this->find(recorded.id);
+            if (obj)
+                base_index_type::modify(*obj, [&](value_type& v) { v = std::move(recorded); });
+        }
 
-        for (auto& item : head.removed_values)
+        for (uint64_t pos = head.start; pos < log_end(); ++pos)
         {
-            base_index_type::emplace_(std::move(item.second));
+            auto& recorded = record(pos);
+            if (recorded.id >= head.old_next_id)
+                continue;
+
+            // the existing objects are restored already, the removed one is inserted from its oldest record
+            if (!this->find(recorded.id))
+                base_index_type::emplace_(std::move(recorded));
         }
 
+        this->_next_id = head.old_next_id;
+
+        _log.erase(_log.begin() + (head.start - _log_begin), _log.end());
+
         _stack.pop_back();
         --_revision;
     }
@@ -229,6 +301,9 @@ private:
     *  recent revision numbers into one revision number (reducing the head revision number)
     *
     *  This method does not change the state of the index, only the state of the undo buffer.
+    *
+    *  The previous session just takes the records of the head session: undo of the merged session removes objects
+    *  created in both and restores the oldest records.
     */
     void squash() override
     {
@@ -237,105 +312,10 @@ private:
         if (_stack.size() == 1)
         {
             _stack.pop_front();
+            discard_log(log_end());
             return;
         }
 
-        auto& state = _stack.back();
-        auto& prev_state = _stack[_stack.size() - 2];
-
-        // An object's relationship to a state can be:
-        // in new_ids            : new
-        // in old_values (was=X) : upd(was=X)
-        // in removed (was=X)    : del(was=X)
-        // not in any of above   : nop
-        //
-        // When merging A=prev_state and B=state we have a 4x4 matrix of all possibilities:
-        //
-        //                   |--------------------- B ----------------------|
-        //
-        //                +------------+------------+------------+------------+
-        //                | new        | upd(was=Y) | del(was=Y) | nop        |
-        //   +------------+------------+------------+------------+------------+
-        // / | new        | N/A        | new       A| nop       C| new       A|
-        // | +------------+------------+------------+------------+------------+
-        // | | upd(was=X) | N/A        | upd(was=X)A| del(was=X)C| upd(was=X)A|
-        // A +------------+------------+------------+------------+------------+
-        // | | del(was=X) | N/A        | N/A        | N/A        | del(was=X)A|
-        // | +------------+------------+------------+------------+------------+
-        // \ | nop        | new       B| upd(was=Y)B| del(was=Y)B| nop      AB|
-        //   +------------+------------+------------+------------+------------+
-        //
-        // Each entry was composed by labelling what should occur in the given case.
-        //
-        // Type A means the composition of states contains the same entry as the first of the two merged states for that
-        // object.
-        // Type B means the composition of states contains the same entry as the second of the two merged states for
-        // that object.
-        // Type C means the composition of states contains an entry different from either of the merged states for that
-        // object.
-        // Type N/A means the composition of states violates causal timing.
-        // Type AB means both type A and type B simultaneously.
-        //
-        // The merge() operation is defined as modifying prev_state in-place to be the state object which represents the
-        // composition of
-        // state A and B.
-        //
-        // Type A (and AB) can be implemented as a no-op; prev_state already contains the correct value for the merged
-        // state.
-        // Type B (and AB) can be implemented by copying from state to prev_state.
-        // Type C needs special case-by-case logic.
-        // Type N/A can be ignored or assert(false) as it can only occur if prev_state and state have illegal values
-        // (a serious logic error which should never happen).
-        //
-
-        // We can only be outside type A/AB (the nop path) if B is not nop, so it suffices to iterate through B's three
-        // containers.
-
-        for (const auto& item : state.old_values)
-        {
-            if (prev_state.new_ids.find(item.second.id) != prev_state.new_ids.end())
-            {
-                // new+upd -> new, type A
-                continue;
-            }
-            if (prev_state.old_values.find(item.second.id) != prev_state.old_values.end())
-            {
-                // upd(was=X) + upd(was=Y) -> upd(was=X), type A
-                continue;
-            }
-            // del+upd -> N/A
-            assert(prev_state.removed_values.find(item.second.id) == prev_state.removed_values.end());
-            // nop+upd(was=Y) -> upd(was=Y), type B
-            prev_state.old_values.emplace(std::move(item));
-        }
-
-        // *+new, but we assume the N/A cases don't happen, leaving type B nop+new -> new
-        for (auto id : state.new_ids)
-            prev_state.new_ids.insert(id);
-
-        // *+del
-        for (auto& obj : state.removed_values)
-        {
-            if (prev_state.new_ids.find(obj.second.id) != prev_state.new_ids.end())
-            {
-                // new + del -> nop (type C)
-                prev_state.new_ids.erase(obj.second.id);
-                continue;
-            }
-            auto it = prev_state.old_values.find(obj.second.id);
-            if (it != prev_state.old_values.end())
-            {
-                // upd(was=X) + del(was=Y) -> del(was=X)
-                prev_state.removed_values.emplace(std::move(*it));
-                prev_state.old_values.erase(obj.second.id);
-                continue;
-            }
-            // del + del -> N/A
-            assert(prev_state.removed_values.find(obj.second.id) == prev_state.removed_values.end());
-            // nop + del(was=Y) -> del(was=Y)
-            prev_state.removed_values.emplace(std::move(obj)); //[obj.second->id] = std::move(obj.second);
-        }
-
         _stack.pop_back();
         --_revision;
     }
@@ -349,6 +329,8 @@ private:
         {
             _stack.pop_front();
         }
+
+        discard_log(_stack.empty() ? log_end() : _stack.front().start);
     }
 
     /**
@@ -378,56 +360,57 @@ private:
         return !_stack.empty();
     }
 
-    void on_modify(const value_type& v)
+    uint64_t log_end() const
     {
-        if (!enabled())
-            return;
-
-        auto& head = _stack.back();
-
-        if (head.new_ids.find(v.id) != head.new_ids.end())
-            return;
+        return _log_begin + _log.size();
+    }
 
-        auto itr = head.old_values.find(v.id);
-        if (itr != head.old_values.end())
-            return;
+    value_type& record(uint64_t pos)
+    {
+        return _log[pos - _log_begin];
+    }
 
-        head.old_values.emplace(std::pair<typename value_type::id_type, const value_type&>(v.id, v));
+    void discard_log(uint64_t pos)
+    {
+        _log.erase(_log.begin(), _log.begin() + (pos - _log_begin));
+        _log_begin = pos;
     }
 
-    void on_remove(const value_type& v)
+    /**
+    *  The object has to be recorded once per session. Table entry keeps the position of the last record of one of
+    *  the objects with the same hash, so collision can only lead to a duplicate record, that is harmless for undo.
+    */
+    bool is_recorded(const id_type& id)
     {
-        if (!enabled())
-            return;
+        const auto& head = _stack.back();
 
-        auto& head = _stack.back();
-        if (head.new_ids.count(v.id))
-        {
-            head.new_ids.erase(v.id);
-            return;
-        }
+        if (id >= head.old_next_id)
+            return true; // created in the session
 
-        auto itr = head.old_values.find(v.id);
-        if (itr != head.old_values.end())
-        {
-            head.removed_values.emplace(std::move(*itr));
-            head.old_values.erase(v.id);
-            return;
-        }
+        uint64_t pos = _recorded_at[id._id % undo_dedup_table_size];
+        return pos >= head.start && pos < log_end() && record(pos).id == id;
+    }
 
-        if (head.removed_values.count(v.id))
-            return;
+    /// @returns recorded object or nullptr if the object has been already recorded in the session
+    const value_type* record_once(const value_type& v)
+    {
+        if (!enabled() || is_recorded(v.id))
+            return nullptr;
+
+        _recorded_at[v.id._id % undo_dedup_table_size] = log_end();
+        _log.push_back(v);
 
-        head.removed_values.emplace(std::pair<typename value_type::id_type, const value_type&>(v.id, v));
+        return &_log.back();
     }
 
-    void on_create(const value_type& v)
+    const value_type* on_modify(const value_type& v)
     {
-        if (!enabled())
-            return;
-        auto& head = _stack.back();
+        return record_once(v);
+    }
 
-        head.new_ids.insert(v.id);
+    void on_remove(const value_type& v)
+    {
+        record_once(v);
     }
 
 private:
@@ -440,6 +423,16 @@ private:
     int64_t _revision = 0;
 
     fc::shared_deque<undo_state> _stack;
+
+    /**
+    *  Append only log of the objects values before their first modification or removal in the session.
+    *  Records are addressed by the position counted from the creation of the index, _log_begin is
+    *  the position of the first record that hasn't been committed.
+    */
+    fc::shared_deque<value_type> _log;
+    uint64_t _log_begin = 0;
+
+    std::array<uint64_t, undo_dedup_table_size> _recorded_at;
 };
 
 /** this class is meant to be specified to enable lookup of index type by object type using
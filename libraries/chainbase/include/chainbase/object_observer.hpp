@@ -0,0 +1,21 @@
+#pragma once
+
+namespace chainbase {
+
+/**
+*  Process local listener of object changes made through database_index.
+*
+*  Callbacks are invoked after the change has been applied (on_remove is invoked before the object is erased).
+*  Undo does not notify observers, so anything derived from notifications must be stored in the database itself
+*  to be reverted together with the observed objects.
+*/
+template <typename ObjectType> class object_observer
+{
+public:
+    virtual ~object_observer() = default;
+
+    virtual void on_create(const ObjectType& obj) = 0;
+    virtual void on_modify(const ObjectType& old_obj, const ObjectType& obj) = 0;
+    virtual void on_remove(const ObjectType& obj) = 0;
+};
+}
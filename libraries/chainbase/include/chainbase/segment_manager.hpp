@@ -11,6 +11,8 @@ class segment_manager
 protected:
     bool _read_only = false;
 
+    boost::filesystem::path _file;
+
     std::unique_ptr<boost::interprocess::managed_mapped_file> _segment;
 
 public:
@@ -21,6 +23,12 @@ public:
 protected:
     void create_segment_file(const boost::filesystem::path& file, bool read_only, uint64_t shared_file_size);
 
+    /**
+    * Unmaps the segment file, extends it by size_increment bytes and maps it again. The segment can be mapped at
+    * another address, so all process local pointers into the segment are invalid after the call.
+    */
+    void grow_segment_file(uint64_t size_increment);
+
     void flush_segment_file();
 
     void close_segment_file();
@@ -45,6 +45,8 @@ void segment_manager::create_segment_file(const boost::filesystem::path& file,
 {
     ilog("Try to open segment file");
 
+    _file = file;
+
     if (boost::filesystem::exists(file))
     {
         if (read_only)
@@ -83,6 +85,23 @@ void segment_manager::create_segment_file(const boost::filesystem::path& file,
     }
 }
 
+void segment_manager::grow_segment_file(uint64_t size_increment)
+{
+    FC_ASSERT(_segment && !_read_only, "Only the segment file opened in read/write mode can be grown");
+
+    _segment->flush();
+    _segment.reset();
+
+    // the file has to be mapped again even if it has not been grown
+    bool grown = boost::interprocess::managed_mapped_file::grow(_file.generic_string().c_str(), size_increment);
+
+    _segment.reset(
+        new boost::interprocess::managed_mapped_file(boost::interprocess::open_only, _file.generic_string().c_str()));
+
+    if (!grown)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not grow database file to requested size."));
+}
+
 void segment_manager::flush_segment_file()
 {
     FC_ASSERT(_segment);
@@ -30,6 +30,21 @@ typedef fc::shared_multi_index_container<book,
 
 CHAINBASE_SET_INDEX_TYPE(book, book_index)
 
+struct shelf : public chainbase::object<1, shelf>
+{
+    CHAINBASE_DEFAULT_CONSTRUCTOR(shelf)
+
+    id_type id;
+    int place = 0;
+};
+
+typedef fc::shared_multi_index_container<shelf,
+                                         indexed_by<ordered_unique<member<shelf, shelf::id_type, &shelf::id>>,
+                                                    ordered_unique<BOOST_MULTI_INDEX_MEMBER(shelf, int, place)>>>
+    shelf_index;
+
+CHAINBASE_SET_INDEX_TYPE(shelf, shelf_index)
+
 class moc_database : public chainbase::database
 {
     typedef chainbase::database _Base;
@@ -44,6 +59,23 @@ public:
         for_each_index([&](chainbase::abstract_generic_index_i& item) { item.undo(); });
     }
 
+    void squash()
+    {
+        for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
+    }
+
+    void commit(int64_t revision)
+    {
+        for_each_index([&](chainbase::abstract_generic_index_i& item) { item.commit(revision); });
+    }
+
+    int64_t revision()
+    {
+        int64_t result = 0;
+        for_each_index([&](chainbase::abstract_generic_index_i& item) { result = item.revision(); });
+        return result;
+    }
+
     // TODO (if chainbase::database became private)
 };
 
@@ -146,4 +178,225 @@ BOOST_AUTO_TEST_CASE(open_and_create)
     }
 }
 
+struct book_observer : public chainbase::object_observer<book>
+{
+    void on_create(const book& b) override
+    {
+        total += b.a;
+    }
+    void on_modify(const book& old_b, const book& b) override
+    {
+        total += b.a - old_b.a;
+    }
+    void on_remove(const book& b) override
+    {
+        total -= b.a;
+    }
+
+    int total = 0;
+};
+
+BOOST_AUTO_TEST_CASE(observe_changes)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+        db.add_index<book_index>();
+
+        auto observer = std::make_shared<book_observer>();
+        db.set_observer<book>(observer);
+
+        const auto& book1 = db.create<book>([](book& b) { b.a = 3; });
+        const auto& book2 = db.create<book>([](book& b) { b.a = 4; });
+        BOOST_REQUIRE_EQUAL(observer->total, 7);
+
+        db.modify(book1, [](book& b) { b.a = 10; });
+        BOOST_REQUIRE_EQUAL(observer->total, 14);
+
+        db.remove(book2);
+        BOOST_REQUIRE_EQUAL(observer->total, 10);
+
+        db.set_observer<book>(nullptr);
+        BOOST_REQUIRE(db.get_observer<book>() == nullptr);
+
+        db.modify(book1, [](book& b) { b.a = 1; });
+        BOOST_REQUIRE_EQUAL(observer->total, 10);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+    boost::filesystem::remove_all(temp);
+}
+
+BOOST_AUTO_TEST_CASE(undo_squashed_sessions)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+        db.add_index<book_index>();
+
+        const auto& book0 = db.create<book>([](book& b) { b.a = 1; });
+        db.create<book>([](book& b) { b.a = 2; });
+
+        {
+            auto session = db.start_undo_session();
+            db.modify(book0, [](book& b) { b.a = 10; });
+            db.create<book>([](book& b) { b.a = 20; });
+            session->push();
+        }
+        {
+            auto session = db.start_undo_session();
+            db.modify(db.get(book::id_type(0)), [](book& b) { b.a = 11; });
+            db.modify(db.get(book::id_type(2)), [](book& b) { b.a = 21; });
+            db.remove(db.get(book::id_type(1)));
+            db.remove(db.get(book::id_type(2)));
+            db.create<book>([](book& b) { b.a = 30; });
+            session->push();
+        }
+
+        db.squash();
+        db.undo();
+
+        BOOST_REQUIRE_EQUAL(db.get(book::id_type(0)).a, 1);
+        BOOST_REQUIRE_EQUAL(db.get(book::id_type(1)).a, 2);
+        BOOST_CHECK(db.find(book::id_type(2)) == nullptr);
+        BOOST_CHECK(db.find(book::id_type(3)) == nullptr);
+
+        // ids are given again after undo
+        BOOST_REQUIRE_EQUAL(db.create<book>([](book& b) { b.a = 40; }).id._id, 2);
+
+        {
+            auto session = db.start_undo_session();
+            db.modify(db.get(book::id_type(1)), [](book& b) { b.a = 50; });
+            session->push();
+        }
+
+        db.commit(db.revision());
+        db.undo();
+
+        BOOST_REQUIRE_EQUAL(db.get(book::id_type(1)).a, 50);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+    boost::filesystem::remove_all(temp);
+}
+
+BOOST_AUTO_TEST_CASE(undo_objects_sharing_dedup_table_entry)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+        db.add_index<book_index>();
+
+        const int books_count = 4096 * 2 + 1;
+        for (int i = 0; i < books_count; ++i)
+            db.create<book>([&](book& b) { b.a = i; });
+
+        auto observer = std::make_shared<book_observer>();
+        db.set_observer<book>(observer);
+
+        {
+            auto session = db.start_undo_session();
+            for (int round = 1; round <= 3; ++round)
+            {
+                for (int i = 0; i < books_count; i += 4096)
+                    db.modify(db.get(book::id_type(i)), [&](book& b) { b.a += round; });
+            }
+            BOOST_REQUIRE_EQUAL(observer->total, 6 * 3);
+        }
+
+        for (int i = 0; i < books_count; i += 4096)
+            BOOST_REQUIRE_EQUAL(db.get(book::id_type(i)).a, i);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+    boost::filesystem::remove_all(temp);
+}
+
+BOOST_AUTO_TEST_CASE(undo_removal_of_object_whose_unique_key_is_taken)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+        db.add_index<shelf_index>();
+
+        const auto& x = db.create<shelf>([](shelf& s) { s.place = 1; });
+        const auto& y = db.create<shelf>([](shelf& s) { s.place = 2; });
+
+        const auto x_id = x.id;
+        const auto y_id = y.id;
+
+        {
+            auto session = db.start_undo_session();
+            db.modify(y, [](shelf& s) { s.place = 3; });
+            db.remove(x);
+            // the unique key of the removed object is taken
+            db.modify(db.get(y_id), [](shelf& s) { s.place = 1; });
+        }
+
+        BOOST_REQUIRE_EQUAL(db.get(x_id).place, 1);
+        BOOST_REQUIRE_EQUAL(db.get(y_id).place, 2);
+        BOOST_REQUIRE_EQUAL(db.get_index<shelf_index>().indices().size(), 2u);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+    boost::filesystem::remove_all(temp);
+}
+
+BOOST_AUTO_TEST_CASE(grow_opened_database)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+        db.add_index<book_index>();
+
+        for (int i = 0; i < 100; ++i)
+            db.create<book>([&](book& b) { b.a = i; });
+
+        const auto size = db.get_size();
+
+        BOOST_REQUIRE(db.grow(1024 * 1024 * 8));
+
+        BOOST_REQUIRE_EQUAL(db.grow_count(), 1u);
+        BOOST_REQUIRE_EQUAL(db.get_size(), size + 1024 * 1024 * 8);
+        BOOST_REQUIRE_GT(db.get_free_memory(), 1024u * 1024 * 8);
+
+        BOOST_REQUIRE_EQUAL(db.get_index<book_index>().indices().size(), 100u);
+        BOOST_REQUIRE_EQUAL(db.get(book::id_type(99)).a, 99);
+
+        {
+            auto session = db.start_undo_session();
+            db.create<book>([&](book& b) { b.a = 100; });
+        }
+        BOOST_CHECK_THROW(db.get(book::id_type(100)), std::out_of_range);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+    boost::filesystem::remove_all(temp);
+}
+
 // BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#include <graphene/net/compact_block.hpp>
+
+#include <cstring>
+
+namespace graphene {
+namespace net {
+
+short_transaction_id_type get_short_transaction_id(const transaction_id_type& id)
+{
+    short_transaction_id_type short_id = 0;
+    std::memcpy(&short_id, id.data(), sizeof(short_id));
+    return short_id;
+}
+
+transaction_id_type get_transaction_id_lower_bound(short_transaction_id_type short_id)
+{
+    // ids are ordered by bytes, so the rest of the bytes are zero for the lower bound
+    transaction_id_type id;
+    std::memcpy(id.data(), &short_id, sizeof(short_id));
+    return id;
+}
+
+compact_block_message make_compact_block_message(const signed_block& block, const block_id_type& block_id)
+{
+    compact_block_message result;
+    result.header = block;
+    result.block_id = block_id;
+
+    result.short_ids.reserve(block.transactions.size());
+    for (const auto& trx : block.transactions)
+        result.short_ids.push_back(get_short_transaction_id(trx.id()));
+
+    return result;
+}
+
+compact_block_reconstructor::compact_block_reconstructor(const compact_block_message& compact_block)
+    : _compact_block(compact_block)
+    , _transactions(compact_block.short_ids.size())
+{
+}
+
+const block_id_type& compact_block_reconstructor::block_id() const
+{
+    return _compact_block.block_id;
+}
+
+const item_hash_t& compact_block_reconstructor::item_hash() const
+{
+    return _compact_block.item_hash;
+}
+
+void compact_block_reconstructor::fill(const transaction_lookup_type& lookup)
+{
+    for (size_t i = 0; i < _transactions.size(); ++i)
+    {
+        if (_transactions[i])
+            continue;
+
+        _transactions[i] = lookup(_compact_block.short_ids[i]);
+        if (_transactions[i])
+            ++_cached_transactions_count;
+    }
+}
+
+std::vector<uint32_t> compact_block_reconstructor::get_missing_indices() const
+{
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < _transactions.size(); ++i)
+    {
+        if (!_transactions[i])
+            result.push_back(static_cast<uint32_t>(i));
+    }
+    return result;
+}
+
+void compact_block_reconstructor::add_missing_transactions(const std::vector<signed_transaction>& transactions)
+{
+    const std::vector<uint32_t> missing = get_missing_indices();
+
+    FC_ASSERT(transactions.size() == missing.size(), "Expected ${expected} transactions, got ${got}",
+              ("expected", missing.size())("got", transactions.size()));
+
+    for (size_t i = 0; i < missing.size(); ++i)
+        _transactions[missing[i]] = transactions[i];
+}
+
+void compact_block_reconstructor::clear_transactions()
+{
+    for (auto& trx : _transactions)
+        trx.reset();
+    _cached_transactions_count = 0;
+}
+
+size_t compact_block_reconstructor::get_cached_transactions_count() const
+{
+    return _cached_transactions_count;
+}
+
+bool compact_block_reconstructor::is_complete() const
+{
+    for (const auto& trx : _transactions)
+    {
+        if (!trx)
+            return false;
+    }
+    return true;
+}
+
+immutable_block_ptr compact_block_reconstructor::make_block() const
+{
+    FC_ASSERT(is_complete(), "Block ${id} has missing transactions", ("id", _compact_block.block_id));
+
+    signed_block block;
+    static_cast<scorum::protocol::signed_block_header&>(block) = _compact_block.header;
+
+    block.transactions.reserve(_transactions.size());
+    for (const auto& trx : _transactions)
+        block.transactions.push_back(*trx);
+
+    // a short id may match another transaction from the cache
+    if (block.calculate_merkle_root() != block.transaction_merkle_root)
+        return immutable_block_ptr();
+
+    immutable_block_ptr result = scorum::protocol::make_immutable_block(std::move(block));
+    if (result->id() != _compact_block.block_id)
+        return immutable_block_ptr();
+
+    return result;
+}
+}
+} // graphene::net
@@ -53,5 +53,10 @@ const core_message_type_enum get_current_connections_request_message::type
     = core_message_type_enum::get_current_connections_request_message_type;
 const core_message_type_enum get_current_connections_reply_message::type
     = core_message_type_enum::get_current_connections_reply_message_type;
+const core_message_type_enum compact_block_message::type = core_message_type_enum::compact_block_message_type;
+const core_message_type_enum fetch_compact_block_transactions_message::type
+    = core_message_type_enum::fetch_compact_block_transactions_message_type;
+const core_message_type_enum compact_block_transactions_message::type
+    = core_message_type_enum::compact_block_transactions_message_type;
 }
 } // graphene::net
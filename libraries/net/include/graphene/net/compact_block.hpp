@@ -0,0 +1,64 @@
+#pragma once
+
+#include <graphene/net/core_messages.hpp>
+
+#include <fc/optional.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace graphene {
+namespace net {
+
+using short_transaction_id_type = uint64_t;
+
+/// @returns first 8 bytes of the transaction id
+short_transaction_id_type get_short_transaction_id(const transaction_id_type& id);
+
+/// @returns the smallest transaction id having the short id as the prefix, the lower bound for the ordered lookup
+transaction_id_type get_transaction_id_lower_bound(short_transaction_id_type short_id);
+
+compact_block_message make_compact_block_message(const signed_block& block, const block_id_type& block_id);
+
+/**
+ * Restores the block from the compact block message. The transactions are taken from the local cache by the short
+ * ids and the missing ones are added when the peer sends them.
+ */
+class compact_block_reconstructor
+{
+public:
+    using transaction_lookup_type = std::function<fc::optional<signed_transaction>(short_transaction_id_type)>;
+
+    explicit compact_block_reconstructor(const compact_block_message& compact_block);
+
+    const block_id_type& block_id() const;
+
+    /// @returns id of the requested block message the compact block is sent for
+    const item_hash_t& item_hash() const;
+
+    void fill(const transaction_lookup_type& lookup);
+
+    /// @returns positions of the transactions that haven't been found, ascending
+    std::vector<uint32_t> get_missing_indices() const;
+
+    /// Puts the transactions to the missing positions in the ascending order
+    void add_missing_transactions(const std::vector<signed_transaction>& transactions);
+
+    /// Forgets the transactions found in the cache, so all of them are requested from the peer
+    void clear_transactions();
+
+    /// @returns number of the transactions found in the cache
+    size_t get_cached_transactions_count() const;
+
+    bool is_complete() const;
+
+    /// @returns the block or null if it doesn't match the merkle root or the id of the compact block
+    immutable_block_ptr make_block() const;
+
+private:
+    compact_block_message _compact_block;
+    std::vector<fc::optional<signed_transaction>> _transactions;
+    size_t _cached_transactions_count = 0;
+};
+}
+} // graphene::net
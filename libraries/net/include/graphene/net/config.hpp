@@ -57,6 +57,12 @@
 
 #define GRAPHENE_NET_MAXIMUM_QUEUED_MESSAGES_IN_BYTES (1024 * 1024)
 
+/**
+ * The encrypted stream is read and written in chunks of this size, the queued messages are coalesced into writes
+ * of about this size
+ */
+#define GRAPHENE_NET_SOCKET_BUFFER_SIZE (64 * 1024)
+
 /**
  * When we receive a message from the network, we advertise it to
  * our peers and save a copy in a cache were we will find it if
@@ -81,6 +87,19 @@
 
 #define GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING 200
 
+/**
+ * During sync, the next blocks are requested from the peers round-robin in stripes
+ * of this many blocks, so the contiguous run of blocks doesn't wait for a single peer
+ */
+#define GRAPHENE_NET_SYNC_STRIPE_SIZE 20
+
+/**
+ * Size of the sync blocks received out of order that are kept until the blocks
+ * before them arrive.  When it's exceeded, only the blocks next to be pushed
+ * are requested.
+ */
+#define GRAPHENE_NET_MAX_SYNC_BLOCKS_BUFFER_SIZE (128 * 1024 * 1024)
+
 /**
  * During normal operation, how many items will be fetched from each
  * peer at a time.  This will only come into play when the network
@@ -44,6 +44,7 @@ using scorum::protocol::signed_transaction;
 using scorum::protocol::block_id_type;
 using scorum::protocol::transaction_id_type;
 using scorum::protocol::signed_block;
+using scorum::protocol::immutable_block_ptr;
 
 typedef fc::ecc::public_key_data node_id_t;
 typedef fc::ripemd160 item_hash_t;
@@ -83,6 +84,9 @@ enum core_message_type_enum
     check_firewall_reply_message_type = 5015,
     get_current_connections_request_message_type = 5016,
     get_current_connections_reply_message_type = 5017,
+    compact_block_message_type = 5018,
+    fetch_compact_block_transactions_message_type = 5019,
+    compact_block_transactions_message_type = 5020,
     core_message_type_last = 5099
 };
 
@@ -105,13 +109,19 @@ struct block_message
     static const core_message_type_enum type;
 
     block_message() {}
-    block_message(const signed_block& blk)
-        : block(blk)
-        , block_id(blk.id())
+    block_message(signed_block blk)
+        : block(scorum::protocol::make_immutable_block(std::move(blk)))
+        , block_id(block->id())
+    {
+    }
+    block_message(immutable_block_ptr blk)
+        : block(std::move(blk))
+        , block_id(block->id())
     {
     }
 
-    signed_block block;
+    /// copies of the message share the block
+    immutable_block_ptr block;
     block_id_type block_id;
 };
 
@@ -416,6 +426,54 @@ struct get_current_connections_reply_message
     uint32_t download_rate_one_hour;
     std::vector<current_connection_data> current_connections;
 };
+
+/**
+ * Block sent to the peer that has most likely seen its transactions already: the header and the short ids of
+ * the transactions. The peer takes the transactions from its message cache and asks for the missing ones with
+ * fetch_compact_block_transactions_message. It's sent instead of the block_message only to the peers that
+ * announced "compact_blocks" in the hello message.
+ */
+struct compact_block_message
+{
+    static const core_message_type_enum type;
+
+    scorum::protocol::signed_block_header header;
+    block_id_type block_id;
+    std::vector<uint64_t> short_ids; /// first 8 bytes of the transaction ids, in the order of the block
+    item_hash_t item_hash; /// id of the block message requested by the peer
+
+    compact_block_message() {}
+};
+
+struct fetch_compact_block_transactions_message
+{
+    static const core_message_type_enum type;
+
+    block_id_type block_id;
+    std::vector<uint32_t> indices; /// positions of the transactions in the block, ascending
+
+    fetch_compact_block_transactions_message() {}
+    fetch_compact_block_transactions_message(const block_id_type& block_id, const std::vector<uint32_t>& indices)
+        : block_id(block_id)
+        , indices(indices)
+    {
+    }
+};
+
+struct compact_block_transactions_message
+{
+    static const core_message_type_enum type;
+
+    block_id_type block_id;
+    std::vector<signed_transaction> transactions; /// in the order of the requested indices
+
+    compact_block_transactions_message() {}
+    compact_block_transactions_message(const block_id_type& block_id, std::vector<signed_transaction> transactions)
+        : block_id(block_id)
+        , transactions(std::move(transactions))
+    {
+    }
+};
 }
 } // graphene::net
 
@@ -443,6 +501,9 @@ FC_REFLECT_ENUM(
         (check_firewall_reply_message_type)
         (get_current_connections_request_message_type)
         (get_current_connections_reply_message_type)
+        (compact_block_message_type)
+        (fetch_compact_block_transactions_message_type)
+        (compact_block_transactions_message_type)
         (core_message_type_last))
 
 FC_REFLECT(graphene::net::trx_message, (trx))
@@ -495,6 +556,9 @@ FC_REFLECT(graphene::net::current_connection_data, (connection_duration)(remote_
 FC_REFLECT(graphene::net::get_current_connections_reply_message,
     (upload_rate_one_minute)(download_rate_one_minute)(upload_rate_fifteen_minutes)(download_rate_fifteen_minutes)(
                upload_rate_one_hour)(download_rate_one_hour)(current_connections))
+FC_REFLECT(graphene::net::compact_block_message, (header)(block_id)(short_ids)(item_hash))
+FC_REFLECT(graphene::net::fetch_compact_block_transactions_message, (block_id)(indices))
+FC_REFLECT(graphene::net::compact_block_transactions_message, (block_id)(transactions))
 
 // clang-format on
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <graphene/net/message.hpp>
+
+#include <vector>
+
+namespace graphene {
+namespace net {
+
+/// @returns size of the frame of the message: the header and the data padded to the multiple of 16 bytes
+size_t get_message_frame_size(uint32_t message_size);
+
+/// Appends the frame of the message to the buffer, the padding is zeroed
+void append_message_frame(std::vector<char>& buffer, const message& m);
+
+/**
+ * Decrypted bytes received from the stcp_socket. The socket is read in large chunks to the free space at the end
+ * and all complete frames are taken from the front at once. The unread bytes are moved to the front only when
+ * there's not enough room at the end, so a frame is always contiguous.
+ */
+class message_frame_buffer
+{
+public:
+    explicit message_frame_buffer(size_t capacity);
+
+    /// @returns the free space at the end having at least min_size bytes
+    char* prepare(size_t min_size);
+
+    /// Marks size bytes written to the space returned by prepare as received
+    void commit(size_t size);
+
+    /// Takes the next message if its frame is received completely
+    bool pop_message(message& m);
+
+    /// @returns number of the received bytes not taken yet
+    size_t size() const;
+
+private:
+    const size_t _capacity;
+    std::vector<char> _buffer;
+    size_t _begin = 0;
+    size_t _end = 0;
+};
+}
+} // graphene::net
@@ -55,6 +55,8 @@ public:
     void connect_to(const fc::ip::endpoint& remote_endpoint);
 
     void send_message(const message& message_to_send);
+    /// Sends the messages with one write to the socket
+    void send_messages(const std::vector<message>& messages_to_send);
     void close_connection();
     void destroy_connection();
 
@@ -81,6 +81,16 @@ public:
         std::vector<fc::uint160_t>& contained_transaction_message_ids)
         = 0;
 
+    /**
+     *  @brief Called during sync for the block that is going to be passed to handle_block soon, so the
+     *         checks independent of the chain state (signatures) can start in parallel
+     *
+     *  Unlike the other methods it's called from the network thread, so it must be thread safe and must not block.
+     */
+    virtual void prevalidate_block(const graphene::net::block_message& blk_msg)
+    {
+    }
+
     /**
      *  @brief Called when a new transaction comes in from the network
      *
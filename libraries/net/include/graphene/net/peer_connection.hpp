@@ -24,6 +24,7 @@
 #pragma once
 
 #include <graphene/net/node.hpp>
+#include <graphene/net/compact_block.hpp>
 #include <graphene/net/peer_database.hpp>
 #include <graphene/net/message_oriented_connection.hpp>
 #include <graphene/net/stcp_socket.hpp>
@@ -41,6 +42,7 @@
 #include <boost/multi_index/hashed_index.hpp>
 
 #include <queue>
+#include <deque>
 #include <boost/container/deque.hpp>
 #include <fc/thread/future.hpp>
 
@@ -169,7 +171,7 @@ private:
     };
 
     size_t _total_queued_messages_size;
-    std::queue<std::unique_ptr<queued_message>, std::list<std::unique_ptr<queued_message>>> _queued_messages;
+    std::deque<std::unique_ptr<queued_message>> _queued_messages;
     fc::future<void> _send_queued_messages_done;
 
 public:
@@ -274,6 +276,9 @@ public:
 
     item_to_time_map_type items_requested_from_peer; /// items we've requested from this peer during normal operation.
     /// fetch from another peer if this peer disconnects
+    bool supports_compact_blocks; /// peer can restore blocks from compact_block_message
+    std::map<block_id_type, compact_block_reconstructor>
+        compact_blocks_being_reconstructed; /// compact blocks waiting for the missing transactions from this peer
     /// @}
 
     // if they're flooding us with transactions, we set this to avoid fetching for a few seconds to let the
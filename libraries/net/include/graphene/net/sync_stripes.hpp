@@ -0,0 +1,32 @@
+#pragma once
+
+#include <graphene/net/core_messages.hpp>
+
+#include <boost/container/deque.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace graphene {
+namespace net {
+
+/// Blocks that can be requested from a peer during sync
+struct sync_peer_items
+{
+    const boost::container::deque<item_hash_t>& ids_of_items_to_get;
+    size_t end_index; /// only the ids before this position are requested
+    size_t capacity; /// number of blocks we can request from the peer
+};
+
+/**
+ * Assigns the blocks to request during sync to the peers. Stripes of up to stripe_size ids are taken from the peers
+ * round-robin, so the blocks next to be pushed come from all peers at once. Each id is assigned to one peer only,
+ * the ids is_needed returns false for are skipped.
+ *
+ * @returns ids of the blocks to request from each peer, in the order of the peers
+ */
+std::vector<std::vector<item_hash_t>> assign_sync_stripes(const std::vector<sync_peer_items>& peers,
+                                                          size_t stripe_size,
+                                                          const std::function<bool(const item_hash_t&)>& is_needed);
+}
+} // graphene::net
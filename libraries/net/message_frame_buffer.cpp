@@ -0,0 +1,82 @@
+#include <graphene/net/message_frame_buffer.hpp>
+#include <graphene/net/config.hpp>
+
+#include <cstring>
+
+namespace graphene {
+namespace net {
+
+size_t get_message_frame_size(uint32_t message_size)
+{
+    return 16 * ((sizeof(message_header) + message_size + 15) / 16);
+}
+
+void append_message_frame(std::vector<char>& buffer, const message& m)
+{
+    const size_t offset = buffer.size();
+    buffer.resize(offset + get_message_frame_size(m.size), 0);
+    memcpy(buffer.data() + offset, (const char*)&m, sizeof(message_header));
+    memcpy(buffer.data() + offset + sizeof(message_header), m.data.data(), m.size);
+}
+
+message_frame_buffer::message_frame_buffer(size_t capacity)
+    : _capacity(capacity)
+    , _buffer(capacity)
+{
+}
+
+char* message_frame_buffer::prepare(size_t min_size)
+{
+    if (_buffer.size() - _end < min_size)
+    {
+        memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+        _end -= _begin;
+        _begin = 0;
+
+        if (_buffer.size() - _end < min_size)
+            _buffer.resize(_end + min_size);
+    }
+    return _buffer.data() + _end;
+}
+
+void message_frame_buffer::commit(size_t size)
+{
+    FC_ASSERT(_end + size <= _buffer.size());
+    _end += size;
+}
+
+bool message_frame_buffer::pop_message(message& m)
+{
+    if (size() < sizeof(message_header))
+        return false;
+
+    message_header header;
+    memcpy((char*)&header, _buffer.data() + _begin, sizeof(message_header));
+
+    FC_ASSERT(header.size <= MAX_MESSAGE_SIZE, "", ("m.size", header.size)("MAX_MESSAGE_SIZE", MAX_MESSAGE_SIZE));
+
+    const size_t frame_size = get_message_frame_size(header.size);
+    if (size() < frame_size)
+        return false;
+
+    const char* data = _buffer.data() + _begin + sizeof(message_header);
+    static_cast<message_header&>(m) = header;
+    m.data.assign(data, data + header.size);
+
+    _begin += frame_size;
+    if (_begin == _end)
+    {
+        _begin = _end = 0;
+        // don't keep the memory taken by the largest message received
+        if (_buffer.size() > _capacity)
+            std::vector<char>(_capacity).swap(_buffer);
+    }
+    return true;
+}
+
+size_t message_frame_buffer::size() const
+{
+    return _end - _begin;
+}
+}
+} // graphene::net
@@ -30,6 +30,7 @@
 
 #include <graphene/net/message_oriented_connection.hpp>
 #include <graphene/net/stcp_socket.hpp>
+#include <graphene/net/message_frame_buffer.hpp>
 #include <graphene/net/config.hpp>
 
 #ifdef DEFAULT_LOGGER
@@ -71,6 +72,7 @@ private:
 
     void read_loop();
     void start_read_loop();
+    void send_frames(const std::vector<char>& frames);
 
 public:
     fc::tcp_socket& get_socket();
@@ -83,6 +85,7 @@ public:
     ~message_oriented_connection_impl();
 
     void send_message(const message& message_to_send);
+    void send_messages(const std::vector<message>& messages_to_send);
     void close_connection();
     void destroy_connection();
 
@@ -147,9 +150,7 @@ void message_oriented_connection_impl::bind(const fc::ip::endpoint& local_endpoi
 void message_oriented_connection_impl::read_loop()
 {
     VERIFY_CORRECT_THREAD();
-    const int BUFFER_SIZE = 16;
-    const int LEFTOVER = BUFFER_SIZE - sizeof(message_header);
-    static_assert(BUFFER_SIZE >= sizeof(message_header), "insufficient buffer");
+    static_assert(GRAPHENE_NET_SOCKET_BUFFER_SIZE % 16 == 0, "stcp_socket reads multiples of 16 bytes");
 
     _connected_time = fc::time_point::now();
 
@@ -158,48 +159,40 @@ void message_oriented_connection_impl::read_loop()
 
     try
     {
+        message_frame_buffer buffer(GRAPHENE_NET_SOCKET_BUFFER_SIZE);
         message m;
         while (true)
         {
-            char buffer[BUFFER_SIZE];
-            _sock.read(buffer, BUFFER_SIZE);
-            _bytes_received += BUFFER_SIZE;
-            memcpy((char*)&m, buffer, sizeof(message_header));
-
-            FC_ASSERT(m.size <= MAX_MESSAGE_SIZE, "", ("m.size", m.size)("MAX_MESSAGE_SIZE", MAX_MESSAGE_SIZE));
-
-            size_t remaining_bytes_with_padding = 16 * ((m.size - LEFTOVER + 15) / 16);
-            m.data.resize(
-                LEFTOVER + remaining_bytes_with_padding); // give extra 16 bytes to allow for padding added in send call
-            std::copy(buffer + sizeof(message_header), buffer + sizeof(buffer), m.data.begin());
-            if (remaining_bytes_with_padding)
-            {
-                _sock.read(&m.data[LEFTOVER], remaining_bytes_with_padding);
-                _bytes_received += remaining_bytes_with_padding;
-            }
-            m.data.resize(m.size); // truncate off the padding bytes
+            // one read may bring many small messages or a part of a large one
+            size_t bytes_read
+                = _sock.readsome(buffer.prepare(GRAPHENE_NET_SOCKET_BUFFER_SIZE), GRAPHENE_NET_SOCKET_BUFFER_SIZE);
+            buffer.commit(bytes_read);
+            _bytes_received += bytes_read;
 
-            _last_message_received_time = fc::time_point::now();
-
-            try
-            {
-                // message handling errors are warnings...
-                _delegate->on_message(_self, m);
-            }
-            /// Dedicated catches needed to distinguish from general fc::exception
-            catch (const fc::canceled_exception& e)
-            {
-                throw e;
-            }
-            catch (const fc::eof_exception& e)
+            while (buffer.pop_message(m))
             {
-                throw e;
-            }
-            catch (const fc::exception& e)
-            {
-                /// Here loop should be continued so exception should be just caught locally.
-                wlog("message transmission failed ${er}", ("er", e.to_detail_string()));
-                throw;
+                _last_message_received_time = fc::time_point::now();
+
+                try
+                {
+                    // message handling errors are warnings...
+                    _delegate->on_message(_self, m);
+                }
+                /// Dedicated catches needed to distinguish from general fc::exception
+                catch (const fc::canceled_exception& e)
+                {
+                    throw e;
+                }
+                catch (const fc::eof_exception& e)
+                {
+                    throw e;
+                }
+                catch (const fc::exception& e)
+                {
+                    /// Here loop should be continued so exception should be just caught locally.
+                    wlog("message transmission failed ${er}", ("er", e.to_detail_string()));
+                    throw;
+                }
             }
         }
     }
@@ -258,6 +251,29 @@ void message_oriented_connection_impl::send_message(const message& message_to_se
       } send_message_scope_logger(remote_endpoint);
 #endif
 #endif
+    if (message_to_send.size > MAX_MESSAGE_SIZE)
+        elog("Trying to send a message larger than MAX_MESSAGE_SIZE. This probably won't work...");
+
+    std::vector<char> frames;
+    append_message_frame(frames, message_to_send);
+    send_frames(frames);
+}
+
+void message_oriented_connection_impl::send_messages(const std::vector<message>& messages_to_send)
+{
+    VERIFY_CORRECT_THREAD();
+    std::vector<char> frames;
+    for (const message& message_to_send : messages_to_send)
+    {
+        if (message_to_send.size > MAX_MESSAGE_SIZE)
+            elog("Trying to send a message larger than MAX_MESSAGE_SIZE. This probably won't work...");
+        append_message_frame(frames, message_to_send);
+    }
+    send_frames(frames);
+}
+
+void message_oriented_connection_impl::send_frames(const std::vector<char>& frames)
+{
     struct verify_no_send_in_progress
     {
         bool& var;
@@ -275,19 +291,15 @@ void message_oriented_connection_impl::send_message(const message& message_to_se
         }
     } _verify_no_send_in_progress(_send_message_in_progress);
 
+    if (frames.empty())
+        return;
+
     try
     {
-        size_t size_of_message_and_header = sizeof(message_header) + message_to_send.size;
-        if (message_to_send.size > MAX_MESSAGE_SIZE)
-            elog("Trying to send a message larger than MAX_MESSAGE_SIZE. This probably won't work...");
-        // pad the message we send to a multiple of 16 bytes
-        size_t size_with_padding = 16 * ((size_of_message_and_header + 15) / 16);
-        std::unique_ptr<char[]> padded_message(new char[size_with_padding]);
-        memcpy(padded_message.get(), (char*)&message_to_send, sizeof(message_header));
-        memcpy(padded_message.get() + sizeof(message_header), message_to_send.data.data(), message_to_send.size);
-        _sock.write(padded_message.get(), size_with_padding);
+        // all frames are encrypted and written together and flushed once
+        _sock.write(frames.data(), frames.size());
         _sock.flush();
-        _bytes_sent += size_with_padding;
+        _bytes_sent += frames.size();
         _last_message_sent_time = fc::time_point::now();
     }
     FC_RETHROW_EXCEPTIONS(warn, "unable to send message");
@@ -393,6 +405,11 @@ void message_oriented_connection::send_message(const message& message_to_send)
     my->send_message(message_to_send);
 }
 
+void message_oriented_connection::send_messages(const std::vector<message>& messages_to_send)
+{
+    my->send_messages(messages_to_send);
+}
+
 void message_oriented_connection::close_connection()
 {
     my->close_connection();
@@ -74,6 +74,8 @@
 #include <graphene/net/node.hpp>
 #include <graphene/net/peer_database.hpp>
 #include <graphene/net/peer_connection.hpp>
+#include <graphene/net/compact_block.hpp>
+#include <graphene/net/sync_stripes.hpp>
 #include <graphene/net/stcp_socket.hpp>
 #include <graphene/net/config.hpp>
 #include <graphene/net/exceptions.hpp>
@@ -131,16 +133,20 @@ private:
         fc::uint160_t message_contents_hash; // hash of whatever the message contains (if it's a transaction, this is
         // the transaction id, if it's a block, it's the block_id)
 
+        immutable_block_ptr block; // unpacked block of the block message, to make compact blocks without unpacking
+
         message_info(const message_hash_type& message_hash,
                      const message& message_body,
                      uint32_t block_clock_when_received,
                      const message_propagation_data& propagation_data,
-                     fc::uint160_t message_contents_hash)
+                     fc::uint160_t message_contents_hash,
+                     immutable_block_ptr block)
             : message_hash(message_hash)
             , message_body(message_body)
             , block_clock_when_received(block_clock_when_received)
             , propagation_data(propagation_data)
             , message_contents_hash(message_contents_hash)
+            , block(std::move(block))
         {
         }
     };
@@ -175,8 +181,13 @@ public:
     void cache_message(const message& message_to_cache,
                        const message_hash_type& hash_of_message_to_cache,
                        const message_propagation_data& propagation_data,
-                       const fc::uint160_t& message_content_hash);
+                       const fc::uint160_t& message_content_hash,
+                       immutable_block_ptr block = immutable_block_ptr());
     message get_message(const message_hash_type& hash_of_message_to_lookup);
+    // return null if the block wasn't cached
+    immutable_block_ptr get_block(const message_hash_type& hash_of_message_to_lookup) const;
+    immutable_block_ptr get_block_by_id(const block_id_type& block_id) const;
+    fc::optional<signed_transaction> get_transaction(short_transaction_id_type short_id) const;
     message_propagation_data
     get_message_propagation_data(const fc::uint160_t& hash_of_message_contents_to_lookup) const;
     size_t size() const
@@ -197,10 +208,11 @@ void blockchain_tied_message_cache::block_accepted()
 void blockchain_tied_message_cache::cache_message(const message& message_to_cache,
                                                   const message_hash_type& hash_of_message_to_cache,
                                                   const message_propagation_data& propagation_data,
-                                                  const fc::uint160_t& message_content_hash)
+                                                  const fc::uint160_t& message_content_hash,
+                                                  immutable_block_ptr block)
 {
-    _message_cache.insert(
-        message_info(hash_of_message_to_cache, message_to_cache, block_clock, propagation_data, message_content_hash));
+    _message_cache.insert(message_info(hash_of_message_to_cache, message_to_cache, block_clock, propagation_data,
+                                       message_content_hash, std::move(block)));
 }
 
 message blockchain_tied_message_cache::get_message(const message_hash_type& hash_of_message_to_lookup)
@@ -212,6 +224,39 @@ message blockchain_tied_message_cache::get_message(const message_hash_type& hash
     FC_THROW_EXCEPTION(fc::key_not_found_exception, "Requested message not in cache");
 }
 
+immutable_block_ptr blockchain_tied_message_cache::get_block(const message_hash_type& hash_of_message_to_lookup) const
+{
+    auto iter = _message_cache.get<message_hash_index>().find(hash_of_message_to_lookup);
+    if (iter != _message_cache.get<message_hash_index>().end())
+        return iter->block;
+    return immutable_block_ptr();
+}
+
+immutable_block_ptr blockchain_tied_message_cache::get_block_by_id(const block_id_type& block_id) const
+{
+    auto range = _message_cache.get<message_contents_hash_index>().equal_range(block_id);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (iter->block)
+            return iter->block;
+    }
+    return immutable_block_ptr();
+}
+
+fc::optional<signed_transaction>
+blockchain_tied_message_cache::get_transaction(short_transaction_id_type short_id) const
+{
+    // transaction ids with the same prefix are next to each other in the contents hash index
+    const auto& idx = _message_cache.get<message_contents_hash_index>();
+    for (auto iter = idx.lower_bound(get_transaction_id_lower_bound(short_id));
+         iter != idx.end() && get_short_transaction_id(iter->message_contents_hash) == short_id; ++iter)
+    {
+        if (iter->message_body.msg_type == trx_message_type)
+            return iter->message_body.as<trx_message>().trx;
+    }
+    return fc::optional<signed_transaction>();
+}
+
 message_propagation_data blockchain_tied_message_cache::get_message_propagation_data(
     const fc::uint160_t& hash_of_message_contents_to_lookup) const
 {
@@ -404,6 +449,7 @@ public:
     bool handle_block(const graphene::net::block_message& block_message,
                       bool sync_mode,
                       std::vector<fc::uint160_t>& contained_transaction_message_ids) override;
+    void prevalidate_block(const graphene::net::block_message& block_message) override;
     void handle_transaction(const graphene::net::trx_message& transaction_message) override;
     std::vector<item_hash_t> get_block_ids(const std::vector<item_hash_t>& blockchain_synopsis,
                                            uint32_t& remaining_item_count,
@@ -472,9 +518,9 @@ public:
         _active_sync_requests; /// list of sync blocks we've asked for from peers but have not yet received
     std::list<graphene::net::block_message>
         _new_received_sync_items; /// list of sync blocks we've just received but haven't yet tried to process
-    std::list<graphene::net::block_message> _received_sync_items; /// list of sync blocks we've received, but can't yet
-    /// process because we are still missing blocks that
-    /// come earlier in the chain
+    std::map<item_hash_t, graphene::net::block_message> _received_sync_items; /// sync blocks we've received, but
+    /// can't yet process because we are still missing blocks that come earlier in the chain, by block_id
+    size_t _received_sync_items_size; /// packed size of the blocks in _received_sync_items
     // @}
 
     fc::future<void> _process_backlog_of_sync_blocks_done;
@@ -619,6 +665,7 @@ public:
     unsigned _maximum_number_of_blocks_to_handle_at_one_time;
     unsigned _maximum_number_of_sync_blocks_to_prefetch;
     unsigned _maximum_blocks_per_peer_during_syncing;
+    size_t _maximum_sync_blocks_buffer_size;
 
     std::list<fc::future<void>> _handle_message_calls_in_progress;
     std::set<message_hash_type> _message_ids_currently_being_processed;
@@ -724,10 +771,28 @@ public:
         peer_connection* originating_peer,
         const get_current_connections_reply_message& get_current_connections_reply_message_received);
 
+    void on_compact_block_message(peer_connection* originating_peer,
+                                  const compact_block_message& compact_block_message_received);
+
+    void on_fetch_compact_block_transactions_message(
+        peer_connection* originating_peer,
+        const fetch_compact_block_transactions_message& fetch_compact_block_transactions_message_received);
+
+    void on_compact_block_transactions_message(
+        peer_connection* originating_peer,
+        const compact_block_transactions_message& compact_block_transactions_message_received);
+
+    void process_reconstructed_compact_block(peer_connection* originating_peer,
+                                             compact_block_reconstructor& reconstructor);
+
+    /// Drops the compact blocks restored for the item and the ones whose block is no longer requested
+    void forget_compact_blocks(peer_connection* originating_peer, const item_hash_t& item_hash);
+
     void on_connection_closed(peer_connection* originating_peer) override;
 
     void send_sync_block_to_node_delegate(const graphene::net::block_message& block_message_to_send);
     void process_backlog_of_sync_blocks();
+    void forget_unreachable_sync_items();
     void trigger_process_backlog_of_sync_blocks();
     void process_block_during_sync(peer_connection* originating_peer,
                                    const graphene::net::block_message& block_message,
@@ -790,6 +855,8 @@ public:
     uint32_t get_connection_count() const;
 
     void broadcast(const message& item_to_broadcast, const message_propagation_data& propagation_data);
+    void broadcast(const graphene::net::block_message& block_to_broadcast,
+                   const message_propagation_data& propagation_data);
     void broadcast(const message& item_to_broadcast);
     void sync_from(const item_id& current_head_block, const std::vector<uint32_t>& hard_fork_block_numbers);
     bool is_connected() const;
@@ -860,6 +927,7 @@ node_impl::node_impl(const std::string& user_agent)
     , _is_firewalled(firewalled_state::unknown)
     , _potential_peer_database_updated(false)
     , _sync_items_to_fetch_updated(false)
+    , _received_sync_items_size(0)
     , _suspend_fetching_sync_blocks(false)
     , _items_to_fetch_updated(false)
     , _items_to_fetch_sequence_counter(0)
@@ -886,6 +954,7 @@ node_impl::node_impl(const std::string& user_agent)
     , _maximum_number_of_blocks_to_handle_at_one_time(MAXIMUM_NUMBER_OF_BLOCKS_TO_HANDLE_AT_ONE_TIME)
     , _maximum_number_of_sync_blocks_to_prefetch(MAXIMUM_NUMBER_OF_BLOCKS_TO_PREFETCH)
     , _maximum_blocks_per_peer_during_syncing(GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING)
+    , _maximum_sync_blocks_buffer_size(GRAPHENE_NET_MAX_SYNC_BLOCKS_BUFFER_SIZE)
 {
     _rate_limiter.set_actual_rate_time_constant(fc::seconds(2));
     fc::rand_pseudo_bytes(&_node_id.data[0], (int)_node_id.size());
@@ -1057,10 +1126,7 @@ void node_impl::trigger_p2p_network_connect_loop()
 bool node_impl::have_already_received_sync_item(const item_hash_t& item_hash)
 {
     VERIFY_CORRECT_THREAD();
-    return std::find_if(
-               _received_sync_items.begin(), _received_sync_items.end(),
-               [&item_hash](const graphene::net::block_message& message) { return message.block_id == item_hash; })
-        != _received_sync_items.end()
+    return _received_sync_items.find(item_hash) != _received_sync_items.end()
         || std::find_if(
                _new_received_sync_items.begin(), _new_received_sync_items.end(),
                [&item_hash](const graphene::net::block_message& message) { return message.block_id == item_hash; })
@@ -1111,43 +1177,49 @@ void node_impl::fetch_sync_items_loop()
 
             {
                 ASSERT_TASK_NOT_PREEMPTED();
-                std::set<item_hash_t> sync_items_to_request;
 
-                // for each idle peer that we're syncing with
+                // when the blocks received out of order take too much memory, only the blocks next to be pushed
+                // are requested, so the buffer can be drained
+                const bool sync_blocks_buffer_is_full = _received_sync_items_size >= _maximum_sync_blocks_buffer_size;
+
+                std::vector<peer_connection_ptr> sync_peers;
+                std::vector<sync_peer_items> sync_peers_items;
+
+                // for each peer that we're syncing with and that has room for more requests
                 for (const peer_connection_ptr& peer : _active_connections)
                 {
-                    if (peer->we_need_sync_items_from_peer
-                        && sync_item_requests_to_send.find(peer) == sync_item_requests_to_send.end()
-                        && // if we've already scheduled a request for this peer, don't consider scheduling another
-                        peer->idle())
-                    {
-                        if (!peer->inhibit_fetching_sync_blocks)
-                        {
-                            // loop through the items it has that we don't yet have on our blockchain
-                            for (unsigned i = 0; i < peer->ids_of_items_to_get.size(); ++i)
-                            {
-                                item_hash_t item_to_potentially_request = peer->ids_of_items_to_get[i];
-                                // if we don't already have this item in our temporary storage and we haven't requested
-                                // from another syncing peer
-                                if (!have_already_received_sync_item(item_to_potentially_request)
-                                    && // already got it, but for some reson it's still in our list of items to fetch
-                                    sync_items_to_request.find(item_to_potentially_request)
-                                        == sync_items_to_request.end()
-                                    && // we have already decided to request it from another peer during this iteration
-                                    _active_sync_requests.find(item_to_potentially_request)
-                                        == _active_sync_requests.end()) // we've requested it in a previous iteration
-                                // and we're still waiting for it to arrive
-                                {
-                                    // then schedule a request from this peer
-                                    sync_item_requests_to_send[peer].push_back(item_to_potentially_request);
-                                    sync_items_to_request.insert(item_to_potentially_request);
-                                    if (sync_item_requests_to_send[peer].size()
-                                        >= _maximum_blocks_per_peer_during_syncing)
-                                        break;
-                                }
-                            }
-                        }
-                    }
+                    if (!peer->we_need_sync_items_from_peer || peer->inhibit_fetching_sync_blocks
+                        || peer->item_ids_requested_from_peer
+                        || peer->sync_items_requested_from_peer.size() >= _maximum_blocks_per_peer_during_syncing)
+                        continue;
+
+                    // let the peer become idle to fetch the next batch of item ids (see process_block_message)
+                    if (peer->number_of_unfetched_item_ids > 0 && !peer->sync_items_requested_from_peer.empty()
+                        && peer->ids_of_items_to_get.size() < GRAPHENE_NET_MIN_BLOCK_IDS_TO_PREFETCH)
+                        continue;
+
+                    size_t end_index = peer->ids_of_items_to_get.size();
+                    if (sync_blocks_buffer_is_full)
+                        end_index = std::min<size_t>(end_index, _maximum_blocks_per_peer_during_syncing);
+
+                    sync_peers.push_back(peer);
+                    sync_peers_items.push_back({ peer->ids_of_items_to_get, end_index,
+                                                 _maximum_blocks_per_peer_during_syncing
+                                                     - peer->sync_items_requested_from_peer.size() });
+                }
+
+                // request the items we don't already have in our temporary storage and haven't requested in a
+                // previous iteration (we're still waiting for them to arrive)
+                auto requests = assign_sync_stripes(
+                    sync_peers_items, GRAPHENE_NET_SYNC_STRIPE_SIZE, [this](const item_hash_t& item) {
+                        return !have_already_received_sync_item(item)
+                            && _active_sync_requests.find(item) == _active_sync_requests.end();
+                    });
+
+                for (size_t i = 0; i < sync_peers.size(); ++i)
+                {
+                    if (!requests[i].empty())
+                        sync_item_requests_to_send[sync_peers[i]] = std::move(requests[i]);
                 }
             } // end non-preemptable section
 
@@ -1993,6 +2065,17 @@ void node_impl::on_message(peer_connection* originating_peer, const message& rec
         on_get_current_connections_reply_message(originating_peer,
                                                  received_message.as<get_current_connections_reply_message>());
         break;
+    case core_message_type_enum::compact_block_message_type:
+        on_compact_block_message(originating_peer, received_message.as<compact_block_message>());
+        break;
+    case core_message_type_enum::fetch_compact_block_transactions_message_type:
+        on_fetch_compact_block_transactions_message(originating_peer,
+                                                    received_message.as<fetch_compact_block_transactions_message>());
+        break;
+    case core_message_type_enum::compact_block_transactions_message_type:
+        on_compact_block_transactions_message(originating_peer,
+                                              received_message.as<compact_block_transactions_message>());
+        break;
 
     default:
         // ignore any message in between core_message_type_first and _last that we don't handle above
@@ -2037,6 +2120,8 @@ fc::variant_object node_impl::generate_hello_user_data()
 
     user_data["chain_id"] = _chain_id;
 
+    user_data["compact_blocks"] = true;
+
     return user_data;
 }
 
@@ -2064,6 +2149,8 @@ void node_impl::parse_hello_user_data_for_peer(peer_connection* originating_peer
         originating_peer->last_known_fork_block_number = user_data["last_known_fork_block_number"].as<uint32_t>();
     if (user_data.contains("chain_id"))
         originating_peer->chain_id = user_data["chain_id"].as<scorum::protocol::chain_id_type>();
+    if (user_data.contains("compact_blocks"))
+        originating_peer->supports_compact_blocks = user_data["compact_blocks"].as_bool();
 }
 
 void node_impl::on_hello_message(peer_connection* originating_peer, const hello_message& hello_message_received)
@@ -2993,6 +3080,20 @@ void node_impl::on_fetch_items_message(peer_connection* originating_peer,
             message requested_message = _message_cache.get_message(item_hash);
             dlog("received item request for item ${id} from peer ${endpoint}, returning the item from my message cache",
                  ("endpoint", originating_peer->get_remote_endpoint())("id", requested_message.id()));
+            if (fetch_items_message_received.item_type == block_message_type
+                && originating_peer->supports_compact_blocks)
+            {
+                // the peer has most likely received the transactions of the recent block already
+                immutable_block_ptr block = _message_cache.get_block(item_hash);
+                if (block)
+                {
+                    compact_block_message compact_block = make_compact_block_message(*block, block->id());
+                    compact_block.item_hash = item_hash;
+                    reply_messages.push_back(compact_block);
+                    last_block_message_sent = reply_messages.back();
+                    continue;
+                }
+            }
             reply_messages.push_back(requested_message);
             if (fetch_items_message_received.item_type == block_message_type)
                 last_block_message_sent = requested_message;
@@ -3027,9 +3128,13 @@ void node_impl::on_fetch_items_message(peer_connection* originating_peer,
     // if we sent them a block, update our record of the last block they've seen accordingly
     if (last_block_message_sent)
     {
-        graphene::net::block_message block = last_block_message_sent->as<graphene::net::block_message>();
-        originating_peer->last_block_delegate_has_seen = block.block_id;
-        originating_peer->last_block_time_delegate_has_seen = _delegate->get_block_time(block.block_id);
+        block_id_type last_block_id;
+        if (last_block_message_sent->msg_type == compact_block_message_type)
+            last_block_id = last_block_message_sent->as<compact_block_message>().block_id;
+        else
+            last_block_id = last_block_message_sent->as<graphene::net::block_message>().block_id;
+        originating_peer->last_block_delegate_has_seen = last_block_id;
+        originating_peer->last_block_time_delegate_has_seen = _delegate->get_block_time(last_block_id);
     }
 
     for (const message& reply : reply_messages)
@@ -3046,6 +3151,16 @@ void node_impl::on_item_not_available_message(peer_connection* originating_peer,
 {
     VERIFY_CORRECT_THREAD();
     const item_id& requested_item = item_not_available_message_received.requested_item;
+    if (requested_item.item_type == compact_block_message_type
+        && originating_peer->compact_blocks_being_reconstructed.erase(requested_item.item_hash))
+    {
+        wlog("Peer doesn't have the transactions of the compact block it has sent.");
+        return;
+    }
+
+    if (requested_item.item_type == block_message_type)
+        forget_compact_blocks(originating_peer, requested_item.item_hash);
+
     auto regular_item_iter = originating_peer->items_requested_from_peer.find(requested_item);
     if (regular_item_iter != originating_peer->items_requested_from_peer.end())
     {
@@ -3273,6 +3388,9 @@ void node_impl::on_connection_closed(peer_connection* originating_peer)
         trigger_fetch_sync_items_loop();
     }
 
+    // the blocks received from this peer are pushed only if another peer has them in its list
+    forget_unreachable_sync_items();
+
     if (!originating_peer->items_requested_from_peer.empty())
     {
         for (auto item_and_time : originating_peer->items_requested_from_peer)
@@ -3298,10 +3416,10 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
     {
         std::vector<fc::uint160_t> contained_transaction_message_ids;
         fc_ilog(fc::logger::get("sync"), "p2p pushing sync block #${block_num} ${block_hash}",
-                ("block_num", block_message_to_send.block.block_num())("block_hash", block_message_to_send.block_id));
+                ("block_num", block_message_to_send.block->block_num())("block_hash", block_message_to_send.block_id));
         _delegate->handle_block(block_message_to_send, true, contained_transaction_message_ids);
         ilog("Successfully pushed sync block ${num} (id:${id})",
-             ("num", block_message_to_send.block.block_num())("id", block_message_to_send.block_id));
+             ("num", block_message_to_send.block->block_num())("id", block_message_to_send.block_id));
         _most_recent_blocks_accepted.push_back(block_message_to_send.block_id);
 
         client_accepted_block = true;
@@ -3311,11 +3429,11 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
         fc_wlog(fc::logger::get("sync"), "p2p failed to push sync block #${block_num} ${block_hash}: block is on a "
                                          "fork older than our undo history would "
                                          "allow us to switch to: ${e}",
-                ("block_num", block_message_to_send.block.block_num())("block_hash", block_message_to_send.block_id)(
+                ("block_num", block_message_to_send.block->block_num())("block_hash", block_message_to_send.block_id)(
                     "e", (fc::exception)e));
         wlog("Failed to push sync block ${num} (id:${id}): block is on a fork older than our undo history would "
              "allow us to switch to: ${e}",
-             ("num", block_message_to_send.block.block_num())("id", block_message_to_send.block_id)("e",
+             ("num", block_message_to_send.block->block_num())("id", block_message_to_send.block_id)("e",
                                                                                                     (fc::exception)e));
         handle_message_exception = e;
         discontinue_fetching_blocks_from_peer = true;
@@ -3329,10 +3447,10 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
         fc_wlog(
             fc::logger::get("sync"),
             "p2p failed to push sync block #${block_num} ${block_hash}: client rejected sync block sent by peer: ${e}",
-            ("block_num", block_message_to_send.block.block_num())("block_hash", block_message_to_send.block_id)("e",
+            ("block_num", block_message_to_send.block->block_num())("block_hash", block_message_to_send.block_id)("e",
                                                                                                                  e));
         wlog("Failed to push sync block ${num} (id:${id}): client rejected sync block sent by peer: ${e}",
-             ("num", block_message_to_send.block.block_num())("id", block_message_to_send.block_id)("e", e));
+             ("num", block_message_to_send.block->block_num())("id", block_message_to_send.block_id)("e", e));
         handle_message_exception = e;
     }
 
@@ -3348,7 +3466,7 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
         --_total_number_of_unfetched_items;
         dlog("sync: client accpted the block, we now have only ${count} items left to fetch before we're in sync",
              ("count", _total_number_of_unfetched_items));
-        bool is_fork_block = is_hard_fork_block(block_message_to_send.block.block_num());
+        bool is_fork_block = is_hard_fork_block(block_message_to_send.block->block_num());
         for (const peer_connection_ptr& peer : _active_connections)
         {
             ASSERT_TASK_NOT_PREEMPTED(); // don't yield while iterating over _active_connections
@@ -3362,16 +3480,16 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
                     uint32_t next_fork_block_number
                         = get_next_known_hard_fork_block_number(peer->last_known_fork_block_number);
                     if (next_fork_block_number != 0
-                        && next_fork_block_number <= block_message_to_send.block.block_num())
+                        && next_fork_block_number <= block_message_to_send.block->block_num())
                     {
                         std::ostringstream disconnect_reason_stream;
                         disconnect_reason_stream << "You need to upgrade your client due to hard fork at block "
-                                                 << block_message_to_send.block.block_num();
+                                                 << block_message_to_send.block->block_num();
                         peers_to_disconnect[peer] = std::make_pair(
                             disconnect_reason_stream.str(),
                             fc::oexception(fc::exception(FC_LOG_MESSAGE(
                                 error, "You need to upgrade your client due to hard fork at block ${block_number}",
-                                ("block_number", block_message_to_send.block.block_num())))));
+                                ("block_number", block_message_to_send.block->block_num())))));
 #ifdef ENABLE_DEBUG_ULOGS
                         ulog("Disconnecting from peer during sync because their version is too old.  Their version "
                              "date: ${date}",
@@ -3408,7 +3526,7 @@ void node_impl::send_sync_block_to_node_delegate(const graphene::net::block_mess
                 if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
                 {
                     peer->last_block_delegate_has_seen = block_message_to_send.block_id;
-                    peer->last_block_time_delegate_has_seen = block_message_to_send.block.timestamp;
+                    peer->last_block_time_delegate_has_seen = block_message_to_send.block->timestamp;
 
                     peer->ids_of_items_being_processed.erase(items_being_processed_iter);
                     dlog(
@@ -3522,86 +3640,103 @@ void node_impl::process_backlog_of_sync_blocks()
 
     do
     {
-        std::copy(std::make_move_iterator(_new_received_sync_items.begin()),
-                  std::make_move_iterator(_new_received_sync_items.end()), std::front_inserter(_received_sync_items));
+        for (graphene::net::block_message& new_block : _new_received_sync_items)
+        {
+            block_id_type block_id = new_block.block_id;
+            if (_received_sync_items.find(block_id) == _received_sync_items.end())
+            {
+                _received_sync_items_size += new_block.block->packed_size();
+                _received_sync_items.emplace(block_id, std::move(new_block));
+            }
+        }
         _new_received_sync_items.clear();
         dlog("currently ${count} sync items to consider", ("count", _received_sync_items.size()));
 
         block_processed_this_iteration = false;
-        for (auto received_block_iter = _received_sync_items.begin(); received_block_iter != _received_sync_items.end();
-             ++received_block_iter)
+
+        // the next block on the active chain or one of the forks is at the front of some peer's list
+        auto received_block_iter = _received_sync_items.end();
+        for (const peer_connection_ptr& peer : _active_connections)
         {
+            ASSERT_TASK_NOT_PREEMPTED(); // don't yield while iterating over _active_connections
+            if (!peer->ids_of_items_to_get.empty())
+            {
+                received_block_iter = _received_sync_items.find(peer->ids_of_items_to_get.front());
+                if (received_block_iter != _received_sync_items.end())
+                    break;
+            }
+        }
+
+        if (received_block_iter != _received_sync_items.end())
+        {
+            const graphene::net::block_message& received_block = received_block_iter->second;
 
-            // find out if this block is the next block on the active chain or one of the forks
-            bool potential_first_block = false;
+            // process it, remove it from all sync peers lists
             for (const peer_connection_ptr& peer : _active_connections)
             {
                 ASSERT_TASK_NOT_PREEMPTED(); // don't yield while iterating over _active_connections
-                if (!peer->ids_of_items_to_get.empty()
-                    && peer->ids_of_items_to_get.front() == received_block_iter->block_id)
+                if (!peer->ids_of_items_to_get.empty() && peer->ids_of_items_to_get.front() == received_block.block_id)
                 {
-                    potential_first_block = true;
                     peer->ids_of_items_to_get.pop_front();
-                    peer->ids_of_items_being_processed.insert(received_block_iter->block_id);
+                    peer->ids_of_items_being_processed.insert(received_block.block_id);
                 }
             }
 
-            // if it is, process it, remove it from all sync peers lists
-            if (potential_first_block)
+            graphene::net::block_message block_message_to_process = std::move(received_block_iter->second);
+            _received_sync_items_size -= block_message_to_process.block->packed_size();
+            _received_sync_items.erase(received_block_iter);
+
+            // we can get into an interesting situation near the end of synchronization.  We can be in
+            // sync with one peer who is sending us the last block on the chain via a regular inventory
+            // message, while at the same time still be synchronizing with a peer who is sending us the
+            // block through the sync mechanism.  Further, we must request both blocks because
+            // we don't know they're the same (for the peer in normal operation, it has only told us the
+            // message id, for the peer in the sync case we only known the block_id).
+            if (std::find(_most_recent_blocks_accepted.begin(), _most_recent_blocks_accepted.end(),
+                          block_message_to_process.block_id)
+                == _most_recent_blocks_accepted.end())
             {
-                // we can get into an interesting situation near the end of synchronization.  We can be in
-                // sync with one peer who is sending us the last block on the chain via a regular inventory
-                // message, while at the same time still be synchronizing with a peer who is sending us the
-                // block through the sync mechanism.  Further, we must request both blocks because
-                // we don't know they're the same (for the peer in normal operation, it has only told us the
-                // message id, for the peer in the sync case we only known the block_id).
-                if (std::find(_most_recent_blocks_accepted.begin(), _most_recent_blocks_accepted.end(),
-                              received_block_iter->block_id)
-                    == _most_recent_blocks_accepted.end())
-                {
-                    graphene::net::block_message block_message_to_process = *received_block_iter;
-                    _received_sync_items.erase(received_block_iter);
-                    _handle_message_calls_in_progress.emplace_back(fc::async(
-                        [this, block_message_to_process]() {
-                            send_sync_block_to_node_delegate(block_message_to_process);
-                        },
-                        "send_sync_block_to_node_delegate"));
-                    ++blocks_processed;
-                    block_processed_this_iteration = true;
-                }
-                else
+                // signatures of the contiguous run are checked in parallel while the blocks before it are pushed
+                _delegate->prevalidate_block(block_message_to_process);
+                _handle_message_calls_in_progress.emplace_back(fc::async(
+                    [this, block_message_to_process]() {
+                        send_sync_block_to_node_delegate(block_message_to_process);
+                    },
+                    "send_sync_block_to_node_delegate"));
+                ++blocks_processed;
+            }
+            else
+            {
+                dlog("Already received and accepted this block (presumably through normal inventory mechanism), "
+                     "treating it as accepted");
+                for (const peer_connection_ptr& peer : _active_connections)
                 {
-                    dlog("Already received and accepted this block (presumably through normal inventory mechanism), "
-                         "treating it as accepted");
-                    for (const peer_connection_ptr& peer : _active_connections)
+                    auto items_being_processed_iter
+                        = peer->ids_of_items_being_processed.find(block_message_to_process.block_id);
+                    if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
                     {
-                        auto items_being_processed_iter
-                            = peer->ids_of_items_being_processed.find(received_block_iter->block_id);
-                        if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
+                        peer->ids_of_items_being_processed.erase(items_being_processed_iter);
+                        dlog("Removed item from ${endpoint}'s list of items being processed, still processing "
+                             "${len} blocks",
+                             ("endpoint", peer->get_remote_endpoint())("len",
+                                                                       peer->ids_of_items_being_processed.size()));
+
+                        // if we just processed the last item in our list from this peer, we will want to
+                        // send another request to find out if we are now in sync (this is normally handled in
+                        // send_sync_block_to_node_delegate)
+                        if (peer->ids_of_items_to_get.empty() && peer->number_of_unfetched_item_ids == 0
+                            && peer->ids_of_items_being_processed.empty())
                         {
-                            peer->ids_of_items_being_processed.erase(items_being_processed_iter);
-                            dlog("Removed item from ${endpoint}'s list of items being processed, still processing "
-                                 "${len} blocks",
-                                 ("endpoint", peer->get_remote_endpoint())("len",
-                                                                           peer->ids_of_items_being_processed.size()));
-
-                            // if we just processed the last item in our list from this peer, we will want to
-                            // send another request to find out if we are now in sync (this is normally handled in
-                            // send_sync_block_to_node_delegate)
-                            if (peer->ids_of_items_to_get.empty() && peer->number_of_unfetched_item_ids == 0
-                                && peer->ids_of_items_being_processed.empty())
-                            {
-                                dlog("We received last item in our list for peer ${endpoint}, setup to do a sync check",
-                                     ("endpoint", peer->get_remote_endpoint()));
-                                fetch_next_batch_of_item_ids_from_peer(peer.get());
-                            }
+                            dlog("We received last item in our list for peer ${endpoint}, setup to do a sync check",
+                                 ("endpoint", peer->get_remote_endpoint()));
+                            fetch_next_batch_of_item_ids_from_peer(peer.get());
                         }
                     }
                 }
+            }
 
-                break; // start iterating _received_sync_items from the beginning
-            } // end if potential_first_block
-        } // end for each block in _received_sync_items
+            block_processed_this_iteration = true; // look for the next block at the fronts of the lists
+        }
 
         if (_handle_message_calls_in_progress.size() >= _maximum_number_of_blocks_to_handle_at_one_time)
         {
@@ -3610,7 +3745,8 @@ void node_impl::process_backlog_of_sync_blocks()
             // ulog("stopping processing sync block backlog because we have ${count} blocks in progress, total on hand:
             // ${received}",
             //     ("count", _handle_message_calls_in_progress.size())("received", _received_sync_items.size()));
-            if (_received_sync_items.size() >= _maximum_number_of_sync_blocks_to_prefetch)
+            if (_received_sync_items.size() >= _maximum_number_of_sync_blocks_to_prefetch
+                || _received_sync_items_size >= _maximum_sync_blocks_buffer_size)
                 _suspend_fetching_sync_blocks = true;
             break;
         }
@@ -3622,6 +3758,45 @@ void node_impl::process_backlog_of_sync_blocks()
         trigger_fetch_sync_items_loop();
 }
 
+// the buffered blocks are pushed when they get to the front of a peer's list. The blocks that are in no list
+// anymore (the peer has disconnected or the sync has restarted) would take the buffer until the node restarts
+void node_impl::forget_unreachable_sync_items()
+{
+    VERIFY_CORRECT_THREAD();
+    if (_received_sync_items.empty())
+        return;
+
+    std::set<item_hash_t> reachable_items;
+    for (const peer_connection_ptr& peer : _active_connections)
+    {
+        for (const item_hash_t& item_hash : peer->ids_of_items_to_get)
+        {
+            if (_received_sync_items.find(item_hash) != _received_sync_items.end())
+                reachable_items.insert(item_hash);
+        }
+    }
+
+    size_t forgotten_items = 0;
+    for (auto iter = _received_sync_items.begin(); iter != _received_sync_items.end();)
+    {
+        if (reachable_items.find(iter->first) == reachable_items.end())
+        {
+            _received_sync_items_size -= iter->second.block->packed_size();
+            iter = _received_sync_items.erase(iter);
+            ++forgotten_items;
+        }
+        else
+            ++iter;
+    }
+
+    if (forgotten_items > 0)
+    {
+        dlog("forgot ${count} sync blocks no peer is going to push, ${size} bytes of sync blocks left",
+             ("count", forgotten_items)("size", _received_sync_items_size));
+        trigger_fetch_sync_items_loop();
+    }
+}
+
 void node_impl::trigger_process_backlog_of_sync_blocks()
 {
     if (!_node_is_shutting_down
@@ -3672,14 +3847,14 @@ void node_impl::process_block_during_normal_operation(peer_connection* originati
             _message_ids_currently_being_processed.insert(message_hash);
             fc_ilog(fc::logger::get("sync"),
                     "p2p pushing block #${block_num} ${block_hash} from ${peer} (message_id was ${id})",
-                    ("block_num", block_message_to_process.block.block_num())("block_hash",
+                    ("block_num", block_message_to_process.block->block_num())("block_hash",
                                                                               block_message_to_process.block_id)(
                         "peer", originating_peer->get_remote_endpoint())("id", message_hash));
             _delegate->handle_block(block_message_to_process, false, contained_transaction_message_ids);
             _message_ids_currently_being_processed.erase(message_hash);
             message_validated_time = fc::time_point::now();
             ilog("Successfully pushed block ${num} (id:${id})",
-                 ("num", block_message_to_process.block.block_num())("id", block_message_to_process.block_id));
+                 ("num", block_message_to_process.block->block_num())("id", block_message_to_process.block_id));
             _most_recent_blocks_accepted.push_back(block_message_to_process.block_id);
 
             bool new_transaction_discovered = false;
@@ -3704,7 +3879,7 @@ void node_impl::process_block_during_normal_operation(peer_connection* originati
         {
             fc_ilog(fc::logger::get("sync"),
                     "p2p NOT pushing block #${block_num} ${block_hash} from ${peer} because we recently pushed it",
-                    ("block_num", block_message_to_process.block.block_num())("block_hash",
+                    ("block_num", block_message_to_process.block->block_num())("block_hash",
                                                                               block_message_to_process.block_id)(
                         "peer", originating_peer->get_remote_endpoint())("id", message_hash));
             dlog("Already received and accepted this block (presumably through sync mechanism), treating it as "
@@ -3714,8 +3889,8 @@ void node_impl::process_block_during_normal_operation(peer_connection* originati
         dlog("client validated the block, advertising it to other peers");
 
         item_id block_message_item_id(core_message_type_enum::block_message_type, message_hash);
-        uint32_t block_number = block_message_to_process.block.block_num();
-        fc::time_point_sec block_time = block_message_to_process.block.timestamp;
+        uint32_t block_number = block_message_to_process.block->block_num();
+        fc::time_point_sec block_time = block_message_to_process.block->timestamp;
 
         for (const peer_connection_ptr& peer : _active_connections)
         {
@@ -3782,7 +3957,7 @@ void node_impl::process_block_during_normal_operation(peer_connection* originati
     {
         // client rejected the block.  Disconnect the client and any other clients that offered us this block
         wlog("Failed to push block ${num} (id:${id}), client rejected block sent by peer",
-             ("num", block_message_to_process.block.block_num())("id", block_message_to_process.block_id));
+             ("num", block_message_to_process.block->block_num())("id", block_message_to_process.block_id));
 
         disconnect_exception = e;
         disconnect_reason = "You offered me a block that I have deemed to be invalid";
@@ -4166,6 +4341,172 @@ void node_impl::on_get_current_connections_reply_message(
     VERIFY_CORRECT_THREAD();
 }
 
+void node_impl::on_compact_block_message(peer_connection* originating_peer,
+                                         const compact_block_message& compact_block_message_received)
+{
+    VERIFY_CORRECT_THREAD();
+    dlog("received compact block ${id} with ${count} transactions from peer ${endpoint}",
+         ("id", compact_block_message_received.block_id)("count", compact_block_message_received.short_ids.size())(
+             "endpoint", originating_peer->get_remote_endpoint()));
+
+    // only the blocks we've asked for are restored, so the peer can't make us keep state and fetch transactions
+    const item_id requested_item(block_message_type, compact_block_message_received.item_hash);
+    if (originating_peer->items_requested_from_peer.find(requested_item)
+        == originating_peer->items_requested_from_peer.end())
+    {
+        dlog("received compact block ${id} I haven't requested from peer ${endpoint}, ignoring it",
+             ("id", compact_block_message_received.block_id)("endpoint", originating_peer->get_remote_endpoint()));
+        return;
+    }
+
+    // a newer compact block for the same request replaces the older one
+    forget_compact_blocks(originating_peer, compact_block_message_received.item_hash);
+
+    compact_block_reconstructor reconstructor(compact_block_message_received);
+    reconstructor.fill(
+        [this](short_transaction_id_type short_id) { return _message_cache.get_transaction(short_id); });
+
+    if (reconstructor.is_complete())
+    {
+        process_reconstructed_compact_block(originating_peer, reconstructor);
+        return;
+    }
+
+    std::vector<uint32_t> missing_indices = reconstructor.get_missing_indices();
+    dlog("requesting ${count} missing transactions of compact block ${id} from peer ${endpoint}",
+         ("count", missing_indices.size())("id", reconstructor.block_id())(
+             "endpoint", originating_peer->get_remote_endpoint()));
+
+    originating_peer->send_message(
+        fetch_compact_block_transactions_message(reconstructor.block_id(), missing_indices));
+    originating_peer->compact_blocks_being_reconstructed.erase(reconstructor.block_id());
+    originating_peer->compact_blocks_being_reconstructed.emplace(reconstructor.block_id(), std::move(reconstructor));
+}
+
+void node_impl::forget_compact_blocks(peer_connection* originating_peer, const item_hash_t& item_hash)
+{
+    VERIFY_CORRECT_THREAD();
+    // compact blocks are kept only while their block is requested, so there are no more of them than requests
+    auto& compact_blocks = originating_peer->compact_blocks_being_reconstructed;
+    for (auto iter = compact_blocks.begin(); iter != compact_blocks.end();)
+    {
+        const item_hash_t& requested_hash = iter->second.item_hash();
+        if (requested_hash == item_hash
+            || originating_peer->items_requested_from_peer.find(item_id(block_message_type, requested_hash))
+                == originating_peer->items_requested_from_peer.end())
+            iter = compact_blocks.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+void node_impl::on_fetch_compact_block_transactions_message(
+    peer_connection* originating_peer,
+    const fetch_compact_block_transactions_message& fetch_compact_block_transactions_message_received)
+{
+    VERIFY_CORRECT_THREAD();
+    const block_id_type& block_id = fetch_compact_block_transactions_message_received.block_id;
+
+    immutable_block_ptr block = _message_cache.get_block_by_id(block_id);
+    if (!block)
+    {
+        try
+        {
+            block = _delegate->get_item(item_id(block_message_type, block_id)).as<graphene::net::block_message>().block;
+        }
+        catch (fc::key_not_found_exception&)
+        {
+        }
+    }
+
+    std::vector<signed_transaction> transactions;
+    if (block)
+    {
+        transactions.reserve(fetch_compact_block_transactions_message_received.indices.size());
+        for (uint32_t index : fetch_compact_block_transactions_message_received.indices)
+        {
+            if (index >= block->transactions.size())
+            {
+                block.reset();
+                break;
+            }
+            transactions.push_back(block->transactions[index]);
+        }
+    }
+
+    if (!block)
+    {
+        dlog("peer ${endpoint} requested transactions of block ${id} that I can't provide",
+             ("endpoint", originating_peer->get_remote_endpoint())("id", block_id));
+        originating_peer->send_message(item_not_available_message(item_id(compact_block_message_type, block_id)));
+        return;
+    }
+
+    originating_peer->send_message(compact_block_transactions_message(block_id, std::move(transactions)));
+}
+
+void node_impl::on_compact_block_transactions_message(
+    peer_connection* originating_peer,
+    const compact_block_transactions_message& compact_block_transactions_message_received)
+{
+    VERIFY_CORRECT_THREAD();
+    auto& compact_blocks = originating_peer->compact_blocks_being_reconstructed;
+    auto iter = compact_blocks.find(compact_block_transactions_message_received.block_id);
+    if (iter == compact_blocks.end())
+    {
+        dlog("received transactions of compact block ${id} I'm not waiting for from peer ${endpoint}",
+             ("id", compact_block_transactions_message_received.block_id)(
+                 "endpoint", originating_peer->get_remote_endpoint()));
+        return;
+    }
+
+    compact_block_reconstructor reconstructor(std::move(iter->second));
+    compact_blocks.erase(iter);
+
+    try
+    {
+        reconstructor.add_missing_transactions(compact_block_transactions_message_received.transactions);
+    }
+    catch (const fc::exception& e)
+    {
+        disconnect_from_peer(originating_peer, "You sent me wrong transactions of the compact block", true, e);
+        return;
+    }
+
+    process_reconstructed_compact_block(originating_peer, reconstructor);
+}
+
+void node_impl::process_reconstructed_compact_block(peer_connection* originating_peer,
+                                                    compact_block_reconstructor& reconstructor)
+{
+    VERIFY_CORRECT_THREAD();
+    immutable_block_ptr block = reconstructor.make_block();
+    if (!block)
+    {
+        if (reconstructor.get_cached_transactions_count() == 0)
+        {
+            // every transaction came from the peer, asking again won't help
+            disconnect_from_peer(originating_peer, "You sent me a compact block that doesn't match its transactions",
+                                 true, fc::exception(FC_LOG_MESSAGE(error, "Invalid compact block ${id}",
+                                                                    ("id", reconstructor.block_id()))));
+            return;
+        }
+
+        dlog("compact block ${id} doesn't match the cached transactions, requesting all of them from peer ${endpoint}",
+             ("id", reconstructor.block_id())("endpoint", originating_peer->get_remote_endpoint()));
+        reconstructor.clear_transactions();
+        originating_peer->send_message(
+            fetch_compact_block_transactions_message(reconstructor.block_id(), reconstructor.get_missing_indices()));
+        originating_peer->compact_blocks_being_reconstructed.emplace(reconstructor.block_id(),
+                                                                     std::move(reconstructor));
+        return;
+    }
+
+    // the restored block message is packed the same way as the full one, so it has the id we've requested
+    message block_message_to_process(graphene::net::block_message(std::move(block)));
+    process_block_message(originating_peer, block_message_to_process, block_message_to_process.id());
+}
+
 // this handles any message we get that doesn't require any special processing.
 // currently, this is any message other than block messages and p2p-specific
 // messages.  (transaction messages would be handled here, for example)
@@ -4236,6 +4577,7 @@ void node_impl::start_synchronizing_with_peer(const peer_connection_ptr& peer)
 {
     VERIFY_CORRECT_THREAD();
     peer->ids_of_items_to_get.clear();
+    forget_unreachable_sync_items();
     peer->number_of_unfetched_item_ids = 0;
     peer->we_need_sync_items_from_peer = true;
     peer->last_block_delegate_has_seen = item_hash_t();
@@ -5090,7 +5432,8 @@ void node_impl::dump_node_status()
 
     ilog("--------- MEMORY USAGE ------------");
     ilog("node._active_sync_requests size: ${size}", ("size", _active_sync_requests.size()));
-    ilog("node._received_sync_items size: ${size}", ("size", _received_sync_items.size()));
+    ilog("node._received_sync_items size: ${size} (${bytes} bytes)",
+         ("size", _received_sync_items.size())("bytes", _received_sync_items_size));
     ilog("node._new_received_sync_items size: ${size}", ("size", _new_received_sync_items.size()));
     ilog("node._items_to_fetch size: ${size}", ("size", _items_to_fetch.size()));
     ilog("node._new_inventory size: ${size}", ("size", _new_inventory.size()));
@@ -5276,10 +5619,12 @@ void node_impl::broadcast(const message& item_to_broadcast, const message_propag
 {
     VERIFY_CORRECT_THREAD();
     fc::uint160_t hash_of_message_contents;
+    immutable_block_ptr block;
     if (item_to_broadcast.msg_type == graphene::net::block_message_type)
     {
         graphene::net::block_message block_message_to_broadcast = item_to_broadcast.as<graphene::net::block_message>();
         hash_of_message_contents = block_message_to_broadcast.block_id; // for debugging
+        block = block_message_to_broadcast.block;
         _most_recent_blocks_accepted.push_back(block_message_to_broadcast.block_id);
     }
     else if (item_to_broadcast.msg_type == graphene::net::trx_message_type)
@@ -5292,11 +5637,27 @@ void node_impl::broadcast(const message& item_to_broadcast, const message_propag
     message_hash_type hash_of_item_to_broadcast = item_to_broadcast.id();
 
     _message_cache.cache_message(item_to_broadcast, hash_of_item_to_broadcast, propagation_data,
-                                 hash_of_message_contents);
+                                 hash_of_message_contents, block);
     _new_inventory.insert(item_id(item_to_broadcast.msg_type, hash_of_item_to_broadcast));
     trigger_advertise_inventory_loop();
 }
 
+void node_impl::broadcast(const graphene::net::block_message& block_to_broadcast,
+                          const message_propagation_data& propagation_data)
+{
+    VERIFY_CORRECT_THREAD();
+    // the block is relayed as it has been received, so it's packed once and never unpacked again
+    message item_to_broadcast(block_to_broadcast);
+    message_hash_type hash_of_item_to_broadcast = item_to_broadcast.id();
+
+    _most_recent_blocks_accepted.push_back(block_to_broadcast.block_id);
+
+    _message_cache.cache_message(item_to_broadcast, hash_of_item_to_broadcast, propagation_data,
+                                 block_to_broadcast.block_id, block_to_broadcast.block);
+    _new_inventory.insert(item_id(block_message_type, hash_of_item_to_broadcast));
+    trigger_advertise_inventory_loop();
+}
+
 void node_impl::broadcast(const message& item_to_broadcast)
 {
     VERIFY_CORRECT_THREAD();
@@ -5346,6 +5707,8 @@ void node_impl::set_advanced_node_parameters(const fc::variant_object& params)
         _maximum_number_of_sync_blocks_to_prefetch = params["maximum_number_of_sync_blocks_to_prefetch"].as<uint32_t>();
     if (params.contains("maximum_blocks_per_peer_during_syncing"))
         _maximum_blocks_per_peer_during_syncing = params["maximum_blocks_per_peer_during_syncing"].as<uint32_t>();
+    if (params.contains("maximum_sync_blocks_buffer_size"))
+        _maximum_sync_blocks_buffer_size = params["maximum_sync_blocks_buffer_size"].as<uint64_t>();
 
     _desired_number_of_connections = std::min(_desired_number_of_connections, _maximum_number_of_connections);
 
@@ -5364,6 +5727,7 @@ fc::variant_object node_impl::get_advanced_node_parameters()
     result["maximum_number_of_blocks_to_handle_at_one_time"] = _maximum_number_of_blocks_to_handle_at_one_time;
     result["maximum_number_of_sync_blocks_to_prefetch"] = _maximum_number_of_sync_blocks_to_prefetch;
     result["maximum_blocks_per_peer_during_syncing"] = _maximum_blocks_per_peer_during_syncing;
+    result["maximum_sync_blocks_buffer_size"] = (uint64_t)_maximum_sync_blocks_buffer_size;
     return result;
 }
 
@@ -5854,6 +6218,12 @@ bool statistics_gathering_node_delegate_wrapper::handle_block(
     INVOKE_AND_COLLECT_STATISTICS(handle_block, block_message, sync_mode, contained_transaction_message_ids);
 }
 
+void statistics_gathering_node_delegate_wrapper::prevalidate_block(const graphene::net::block_message& block_message)
+{
+    // called on the network thread, the delegate doesn't wait for the checks
+    _node_delegate->prevalidate_block(block_message);
+}
+
 void statistics_gathering_node_delegate_wrapper::handle_transaction(
     const graphene::net::trx_message& transaction_message)
 {
@@ -88,6 +88,7 @@ peer_connection::peer_connection(peer_connection_delegate* delegate)
     , peer_needs_sync_items_from_us(true)
     , we_need_sync_items_from_peer(true)
     , inhibit_fetching_sync_blocks(false)
+    , supports_compact_blocks(false)
     , transaction_fetching_inhibited_until(fc::time_point::min())
     , last_known_fork_block_number(0)
     , firewall_check_state(nullptr)
@@ -320,14 +321,24 @@ void peer_connection::send_queued_messages_task()
 #endif
     while (!_queued_messages.empty())
     {
-        _queued_messages.front()->transmission_start_time = fc::time_point::now();
-        message message_to_send = _queued_messages.front()->get_message(_node);
+        // the messages queued by now are coalesced into one write, the ones queued while it's in progress go to
+        // the next write
+        std::vector<message> messages_to_send;
+        size_t batch_size = 0;
+        while (messages_to_send.size() < _queued_messages.size() && batch_size < GRAPHENE_NET_SOCKET_BUFFER_SIZE)
+        {
+            queued_message& queued = *_queued_messages[messages_to_send.size()];
+            queued.transmission_start_time = fc::time_point::now();
+            messages_to_send.push_back(queued.get_message(_node));
+            batch_size += messages_to_send.back().size;
+        }
+
         try
         {
-            // dlog("peer_connection::send_queued_messages_task() calling message_oriented_connection::send_message() "
-            //     "to send message of type ${type} for peer ${endpoint}",
-            //     ("type", message_to_send.msg_type)("endpoint", get_remote_endpoint()));
-            _message_connection.send_message(message_to_send);
+            // dlog("peer_connection::send_queued_messages_task() calling message_oriented_connection::send_messages() "
+            //     "to send ${count} messages for peer ${endpoint}",
+            //     ("count", messages_to_send.size())("endpoint", get_remote_endpoint()));
+            _message_connection.send_messages(messages_to_send);
             // dlog("peer_connection::send_queued_messages_task()'s call to message_oriented_connection::send_message()
             // completed normally for peer ${endpoint}",
             //     ("endpoint", get_remote_endpoint()));
@@ -358,9 +369,12 @@ void peer_connection::send_queued_messages_task()
         {
             elog("message_oriented_exception::send_message() threw an unhandled exception");
         }
-        _queued_messages.front()->transmission_finish_time = fc::time_point::now();
-        _total_queued_messages_size -= _queued_messages.front()->get_size_in_queue();
-        _queued_messages.pop();
+        for (size_t i = 0; i < messages_to_send.size(); ++i)
+        {
+            _queued_messages.front()->transmission_finish_time = fc::time_point::now();
+            _total_queued_messages_size -= _queued_messages.front()->get_size_in_queue();
+            _queued_messages.pop_front();
+        }
     }
     // dlog("leaving peer_connection::send_queued_messages_task() due to queue exhaustion");
 }
@@ -369,7 +383,7 @@ void peer_connection::send_queueable_message(std::unique_ptr<queued_message>&& m
 {
     VERIFY_CORRECT_THREAD();
     _total_queued_messages_size += message_to_send->get_size_in_queue();
-    _queued_messages.emplace(std::move(message_to_send));
+    _queued_messages.emplace_back(std::move(message_to_send));
     if (_total_queued_messages_size > GRAPHENE_NET_MAXIMUM_QUEUED_MESSAGES_IN_BYTES)
     {
         elog("send queue exceeded maximum size of ${max} bytes (current size ${current} bytes)",
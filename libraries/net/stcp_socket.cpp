@@ -33,6 +33,7 @@
 #include <fc/exception/exception.hpp>
 
 #include <graphene/net/stcp_socket.hpp>
+#include <graphene/net/config.hpp>
 
 namespace graphene {
 namespace net {
@@ -113,7 +114,7 @@ size_t stcp_socket::readsome(char* buffer, size_t len)
         } buffer_in_use_checker(_read_buffer_in_use);
 #endif
 
-        const size_t read_buffer_length = 4096;
+        const size_t read_buffer_length = GRAPHENE_NET_SOCKET_BUFFER_SIZE;
         if (!_read_buffer)
             _read_buffer.reset(new char[read_buffer_length], [](char* p) { delete[] p; });
 
@@ -168,7 +169,7 @@ size_t stcp_socket::writesome(const char* buffer, size_t len)
         } buffer_in_use_checker(_write_buffer_in_use);
 #endif
 
-        const std::size_t write_buffer_length = 4096;
+        const std::size_t write_buffer_length = GRAPHENE_NET_SOCKET_BUFFER_SIZE;
         if (!_write_buffer)
             _write_buffer.reset(new char[write_buffer_length], [](char* p) { delete[] p; });
         len = std::min<size_t>(write_buffer_length, len);
@@ -0,0 +1,50 @@
+#include <graphene/net/sync_stripes.hpp>
+
+#include <algorithm>
+#include <set>
+
+namespace graphene {
+namespace net {
+
+std::vector<std::vector<item_hash_t>> assign_sync_stripes(const std::vector<sync_peer_items>& peers,
+                                                          size_t stripe_size,
+                                                          const std::function<bool(const item_hash_t&)>& is_needed)
+{
+    std::vector<std::vector<item_hash_t>> requests(peers.size());
+    std::set<item_hash_t> assigned_items;
+
+    std::vector<size_t> next_index(peers.size(), 0); /// next position in the ids of the peer to consider
+    std::vector<size_t> capacity;
+    capacity.reserve(peers.size());
+    for (const sync_peer_items& peer : peers)
+        capacity.push_back(peer.capacity);
+
+    bool assigned_this_round = true;
+    while (assigned_this_round)
+    {
+        assigned_this_round = false;
+        for (size_t i = 0; i < peers.size(); ++i)
+        {
+            const size_t end_index = std::min(peers[i].end_index, peers[i].ids_of_items_to_get.size());
+
+            size_t assigned_to_stripe = 0;
+            while (capacity[i] > 0 && assigned_to_stripe < stripe_size && next_index[i] < end_index)
+            {
+                const item_hash_t& item = peers[i].ids_of_items_to_get[next_index[i]++];
+                // skip the items assigned to another peer during this call
+                if (assigned_items.find(item) == assigned_items.end() && is_needed(item))
+                {
+                    requests[i].push_back(item);
+                    assigned_items.insert(item);
+                    --capacity[i];
+                    ++assigned_to_stripe;
+                    assigned_this_round = true;
+                }
+            }
+        }
+    }
+
+    return requests;
+}
+}
+} // graphene::net
@@ -240,8 +240,21 @@ void account_by_key_plugin::plugin_initialize(const boost::program_options::vari
     {
         chain::database& db = database();
 
-        db.pre_apply_operation.connect([&](const operation_notification& o) { my->pre_operation(o); });
-        db.post_apply_operation.connect([&](const operation_notification& o) { my->post_operation(o); });
+        auto on_pre_operation = [&](const operation_notification& o) { my->pre_operation(o); };
+        auto on_post_operation = [&](const operation_notification& o) { my->post_operation(o); };
+
+        // only operations that are handled by pre_operation_visitor and post_operation_visitor
+        db.pre_apply_operation_of<account_create_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<account_create_with_delegation_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<account_create_by_committee_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<account_update_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<recover_account_operation>().connect(on_pre_operation);
+
+        db.post_apply_operation_of<account_create_operation>().connect(on_post_operation);
+        db.post_apply_operation_of<account_create_with_delegation_operation>().connect(on_post_operation);
+        db.post_apply_operation_of<account_create_by_committee_operation>().connect(on_post_operation);
+        db.post_apply_operation_of<account_update_operation>().connect(on_post_operation);
+        db.post_apply_operation_of<recover_account_operation>().connect(on_post_operation);
 
         db.add_plugin_index<key_lookup_index>();
     }
@@ -13,7 +13,7 @@ namespace account_statistics {
 namespace detail {
 
 class account_statistics_plugin_impl
-    : public common_statistics::common_statistics_plugin_impl<bucket_object, account_statistics_plugin>
+    : public common_statistics::common_statistics_plugin_impl<bucket_object, account_statistics_plugin, block_metric>
 {
 public:
     account_statistics_plugin_impl(account_statistics_plugin& plugin)
@@ -24,7 +24,9 @@ public:
     {
     }
 
-    virtual void process_post_operation(const bucket_object& bucket, const operation_notification& o) override;
+    virtual void process_post_operation(block_metric& metric, const operation_notification& o) override;
+
+    virtual void apply_metric(bucket_object& bucket, const block_metric& metric) override;
 };
 
 struct activity_operation_process
@@ -45,12 +47,10 @@ struct activity_operation_process
 
 struct operation_process
 {
-    chain::database& _db;
-    const bucket_object& _bucket;
+    block_metric& _metric;
 
-    operation_process(chain::database& db, const bucket_object& b)
-        : _db(db)
-        , _bucket(b)
+    operation_process(block_metric& metric)
+        : _metric(metric)
     {
     }
 
@@ -60,24 +60,27 @@ struct operation_process
 
     void operator()(const transfer_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto& from_stat = b.account_statistic[op.from];
-            from_stat.transfers_from++;
-            from_stat.scorum_sent += op.amount;
-
-            auto& to_stat = b.account_statistic[op.to];
-            to_stat.transfers_to++;
-            to_stat.scorum_received += op.amount;
-        });
+        auto& from_stat = _metric.account_statistic[op.from];
+        from_stat.transfers_from++;
+        from_stat.scorum_sent += op.amount;
+
+        auto& to_stat = _metric.account_statistic[op.to];
+        to_stat.transfers_to++;
+        to_stat.scorum_received += op.amount;
     }
 };
 
-void account_statistics_plugin_impl::process_post_operation(const bucket_object& bucket,
-                                                            const operation_notification& o)
+void account_statistics_plugin_impl::process_post_operation(block_metric& metric, const operation_notification& o)
 {
-    auto& db = _self.database();
+    o.op.visit(operation_process(metric));
+}
 
-    o.op.visit(operation_process(db, bucket));
+void account_statistics_plugin_impl::apply_metric(bucket_object& bucket, const block_metric& metric)
+{
+    for (const auto& item : metric.account_statistic)
+    {
+        bucket.account_statistic[item.first] += item.second;
+    }
 }
 
 } // namespace detail
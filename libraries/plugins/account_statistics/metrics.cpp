@@ -4,7 +4,7 @@
 namespace scorum {
 namespace account_statistics {
 
-account_statistic& account_statistic::operator+=(const account_metric& stat)
+account_metric& account_metric::operator+=(const account_metric& stat)
 {
     this->signed_transactions += stat.signed_transactions;
 
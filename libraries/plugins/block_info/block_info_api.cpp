@@ -36,7 +36,10 @@ std::shared_ptr<scorum::plugin::block_info::block_info_plugin> block_info_api_im
 
 void block_info_api_impl::get_block_info(const get_block_info_args& args, std::vector<block_info>& result)
 {
-    const std::vector<block_info>& _block_info = get_plugin()->_block_info;
+    auto plugin = get_plugin();
+    std::lock_guard<std::mutex> lock(plugin->_block_info_mutex);
+
+    const std::vector<block_info>& _block_info = plugin->_block_info;
 
     FC_ASSERT(args.start_block_num > 0);
     FC_ASSERT(args.count <= 10000);
@@ -48,8 +51,11 @@ void block_info_api_impl::get_block_info(const get_block_info_args& args, std::v
 
 void block_info_api_impl::get_blocks_with_info(const get_block_info_args& args, std::vector<block_with_info>& result)
 {
-    const std::vector<block_info>& _block_info = get_plugin()->_block_info;
-    const chain::database& db = get_plugin()->database();
+    auto plugin = get_plugin();
+    std::lock_guard<std::mutex> lock(plugin->_block_info_mutex);
+
+    const std::vector<block_info>& _block_info = plugin->_block_info;
+    const chain::database& db = plugin->database();
 
     FC_ASSERT(args.start_block_num > 0);
     FC_ASSERT(args.count <= 10000);
@@ -26,11 +26,27 @@ std::string block_info_plugin::plugin_name() const
     return "block_info";
 }
 
+void block_info_plugin::plugin_set_program_options(boost::program_options::options_description& cli,
+                                                   boost::program_options::options_description& cfg)
+{
+    cfg.add_options()("block-info-async", boost::program_options::value<bool>()->default_value(false),
+                      "Collect block info on the plugin thread instead of the block applying one.");
+}
+
 void block_info_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 {
     chain::database& db = database();
 
-    _applied_block_conn = db.applied_block.connect([this](const chain::signed_block& b) { on_applied_block(b); });
+    if (options.count("block-info-async") && options.at("block-info-async").as<bool>())
+    {
+        _stream.reset(new chain::async_block_stream(
+            db, plugin_name(), [this](const chain::async_block_notification& note) { on_async_block(note); }));
+    }
+    else
+    {
+        _applied_block_conn
+            = db.applied_block.connect([this](const chain::signed_block& b) { on_applied_block(b); });
+    }
 }
 
 void block_info_plugin::plugin_startup()
@@ -40,24 +56,48 @@ void block_info_plugin::plugin_startup()
 
 void block_info_plugin::plugin_shutdown()
 {
+    _stream.reset();
 }
 
 void block_info_plugin::on_applied_block(const chain::signed_block& b)
 {
-    uint32_t block_num = b.block_num();
     const chain::database& db = database();
 
-    while (block_num >= _block_info.size())
-        _block_info.emplace_back();
-
-    block_info& info = _block_info[block_num];
+    block_info info;
     const chain::dynamic_global_property_object& dgpo = db.obtain_service<chain::dbs_dynamic_global_property>().get();
 
     info.block_id = b.id();
     info.block_size = fc::raw::pack_size(b);
     info.aslot = dgpo.current_aslot;
     info.last_irreversible_block_num = dgpo.last_irreversible_block_num;
-    return;
+
+    set_block_info(b.block_num(), info);
+}
+
+void block_info_plugin::on_async_block(const chain::async_block_notification& note)
+{
+    // info of the popped block is replaced by the one that is applied instead
+    if (note.event != chain::async_block_notification::applied_block)
+        return;
+
+    block_info info;
+
+    info.block_id = note.block->id();
+    info.block_size = fc::raw::pack_size(*note.block);
+    info.aslot = note.current_aslot;
+    info.last_irreversible_block_num = note.last_irreversible_block_num;
+
+    set_block_info(note.block_num, info);
+}
+
+void block_info_plugin::set_block_info(uint32_t block_num, const block_info& info)
+{
+    std::lock_guard<std::mutex> lock(_block_info_mutex);
+
+    while (block_num >= _block_info.size())
+        _block_info.emplace_back();
+
+    _block_info[block_num] = info;
 }
 }
 }
@@ -2,8 +2,11 @@
 #pragma once
 
 #include <scorum/app/plugin.hpp>
+#include <scorum/chain/async_block_stream.hpp>
 #include <scorum/plugins/block_info/block_info.hpp>
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -22,6 +25,8 @@ using scorum::app::application;
 /**
  * @brief This plugin tracks information about applied blocks
  *
+ * With 'block-info-async' the information is collected on the plugin thread from the async_block_stream.
+ *
  * @ingroup plugins
  * @addtogroup block_info_plugin Block info plugin
  */
@@ -34,13 +39,21 @@ public:
     virtual std::string plugin_name() const override;
     virtual void plugin_initialize(const boost::program_options::variables_map& options) override;
     virtual void plugin_startup() override;
+    virtual void plugin_set_program_options(boost::program_options::options_description& cli,
+                                            boost::program_options::options_description& cfg) override;
     virtual void plugin_shutdown() override;
 
     void on_applied_block(const chain::signed_block& b);
+    void on_async_block(const chain::async_block_notification& note);
+
+    void set_block_info(uint32_t block_num, const block_info& info);
 
+    /// guards _block_info that is updated by the stream thread in asynchronous mode
+    mutable std::mutex _block_info_mutex;
     std::vector<block_info> _block_info;
 
     boost::signals2::scoped_connection _applied_block_conn;
+    std::unique_ptr<chain::async_block_stream> _stream;
 };
 }
 }
@@ -24,6 +24,15 @@ public:
     {
     }
 
+    std::shared_ptr<blockchain_history_plugin> get_plugin() const
+    {
+        auto plugin = _app.get_plugin<blockchain_history_plugin>(BLOCKCHAIN_HISTORY_PLUGIN_NAME);
+
+        FC_ASSERT(plugin, "Cann't get " BLOCKCHAIN_HISTORY_PLUGIN_NAME " plugin from application.");
+
+        return plugin;
+    }
+
     template <typename history_object_type, typename fill_result_functor>
     void get_history(const std::string& account, uint64_t from, uint32_t limit, fill_result_functor& funct) const
     {
@@ -58,9 +67,10 @@ public:
     {
         std::map<uint32_t, applied_operation> result;
 
-        const auto db = _app.chain_database();
+        const auto plugin = get_plugin();
 
-        auto fill_funct = [&](const history_object_type& hobj) { result[hobj.sequence] = db->get(hobj.op); };
+        auto fill_funct
+            = [&](const history_object_type& hobj) { result[hobj.sequence] = plugin->get_operation(hobj.op); };
         this->template get_history<history_object_type>(account, from, limit, fill_funct);
 
         return result;
@@ -108,11 +118,12 @@ std::map<uint32_t, applied_withdraw_operation>
 account_history_api::get_account_sp_to_scr_transfers(const std::string& account, uint64_t from, uint32_t limit) const
 {
     const auto db = _impl->_app.chain_database();
+    const auto plugin = _impl->get_plugin();
     return db->with_read_lock([&]() {
         std::map<uint32_t, applied_withdraw_operation> result;
 
         auto fill_funct = [&](const account_withdrawals_to_scr_history_object& obj) {
-            auto it = result.emplace(obj.sequence, applied_withdraw_operation(db->get(obj.op))).first;
+            auto it = result.emplace(obj.sequence, applied_withdraw_operation(plugin->get_operation(obj.op))).first;
             auto& applied_op = it->second;
 
             share_type to_withdraw = 0;
@@ -126,7 +137,7 @@ account_history_api::get_account_sp_to_scr_transfers(const std::string& account,
             }
             else if (!obj.progress.empty())
             {
-                auto last_op = fc::raw::unpack<operation>(db->get(obj.progress.back()).serialized_op);
+                auto last_op = plugin->get_operation(obj.progress.back()).op;
 
                 last_op.weak_visit(
                     [&](const acc_finished_vesting_withdraw_operation&) {
@@ -141,8 +152,7 @@ account_history_api::get_account_sp_to_scr_transfers(const std::string& account,
 
                 if (obj.progress.size() > 1)
                 {
-                    auto before_last_op_obj = db->get(*(obj.progress.rbegin() + 1));
-                    auto before_last_op = fc::raw::unpack<operation>(before_last_op_obj.serialized_op);
+                    auto before_last_op = plugin->get_operation(*(obj.progress.rbegin() + 1)).op;
 
                     before_last_op.weak_visit([&](const acc_finished_vesting_withdraw_operation&) {
                         // if pre-last 'progress' operation is 'acc_finished_' then withdraw was finished
@@ -152,7 +162,7 @@ account_history_api::get_account_sp_to_scr_transfers(const std::string& account,
 
                 for (auto& id : obj.progress)
                 {
-                    auto op = fc::raw::unpack<operation>(db->get(id).serialized_op);
+                    auto op = plugin->get_operation(id).op;
 
                     op.weak_visit(
                         [&](const acc_to_acc_vesting_withdraw_operation& op) {
@@ -1,6 +1,7 @@
 #include <scorum/blockchain_history/blockchain_history_api.hpp>
 #include <scorum/blockchain_history/blockchain_history_plugin.hpp>
 #include <scorum/blockchain_history/schema/operation_objects.hpp>
+#include <scorum/blockchain_history/operation_store.hpp>
 #include <scorum/app/application.hpp>
 #include <scorum/chain/services/dynamic_global_property.hpp>
 #include <scorum/common_api/config_api.hpp>
@@ -24,7 +25,7 @@ public:
 private:
     template <typename ObjectType> applied_operation get_filtered_operation(const ObjectType& obj) const
     {
-        return _db->get(obj.op);
+        return get_plugin()->get_operation(obj.op);
     }
 
     applied_operation get_operation(const filtered_not_virt_operations_history_object& obj) const
@@ -61,6 +62,15 @@ public:
     {
     }
 
+    std::shared_ptr<blockchain_history_plugin> get_plugin() const
+    {
+        auto plugin = _app.get_plugin<blockchain_history_plugin>(BLOCKCHAIN_HISTORY_PLUGIN_NAME);
+
+        FC_ASSERT(plugin, "Cann't get " BLOCKCHAIN_HISTORY_PLUGIN_NAME " plugin from application.");
+
+        return plugin;
+    }
+
     using result_type = std::map<uint32_t, applied_operation>;
 
     template <typename IndexType> result_type get_ops_history(uint32_t from_op, uint32_t limit) const
@@ -101,6 +111,47 @@ public:
         return result;
     }
 
+    result_type get_all_ops_history(uint32_t from_op, uint32_t limit) const
+    {
+        FC_ASSERT(limit > 0, "Limit must be greater than zero");
+        FC_ASSERT(limit <= get_api_config(API_BLOCKCHAIN_HISTORY).max_blockchain_history_depth,
+                  "Limit of ${l} is greater than maxmimum allowed ${2}",
+                  ("l", limit)("2", get_api_config(API_BLOCKCHAIN_HISTORY).max_blockchain_history_depth));
+        FC_ASSERT(from_op >= limit, "From must be greater than limit");
+
+        if (from_op != std::numeric_limits<decltype(from_op)>::max())
+        {
+            --from_op;
+        }
+
+        result_type result;
+
+        // irreversible operations are in the store, the rest of them follow in the shared memory
+        const auto plugin = get_plugin();
+        const auto& store = plugin->get_operation_store();
+        const auto& idx = _db->get_index<operation_index, by_id>();
+
+        uint64_t next_id = store.next_id();
+        if (!idx.empty())
+            next_id = std::max(next_id, (uint64_t)idx.rbegin()->id._id + 1);
+
+        if (next_id == 0)
+            return result;
+
+        // move to last operation
+        int64_t end = std::min((uint64_t)from_op, next_id - 1);
+        int64_t start = end - limit;
+
+        for (int64_t id = end; id > start && id >= 0; --id)
+        {
+            auto op = plugin->find_operation(operation_object::id_type(id));
+            if (op.valid())
+                result[(uint32_t)id] = *op;
+        }
+
+        return result;
+    }
+
     template <typename IndexType>
     result_type get_ops_history_by_time(const fc::time_point_sec& from,
                                         const fc::time_point_sec& to,
@@ -119,6 +170,19 @@ public:
 
         result_type result;
 
+        // stored operations are older than the ones in the shared memory
+        const auto plugin = get_plugin();
+        const auto& store = plugin->get_operation_store();
+        for (uint64_t id = store.lower_bound(from); limit && id < store.next_id() && id <= from_op; ++id)
+        {
+            auto op = store.get(id);
+            if (!op.valid() || op->timestamp > to)
+                break;
+
+            --limit;
+            result[(uint32_t)id] = *op;
+        }
+
         const auto& idx = _db->get_index<IndexType, by_timestamp>();
         if (idx.empty())
             return result;
@@ -131,7 +195,7 @@ public:
             auto id = it->id;
             FC_ASSERT(id._id >= 0, "Invalid operation_object id");
             const operation_object& op = (*it);
-            if (id > from_op)
+            if (id > from_op || result.count((uint32_t)id._id))
                 continue;
 
             --limit;
@@ -147,6 +211,16 @@ public:
 
         result_type result;
 
+        const auto plugin = get_plugin();
+        const auto& store = plugin->get_operation_store();
+        auto stored = store.get_block_range(block_num);
+        for (uint64_t id = stored.first; id < stored.second; ++id)
+        {
+            auto op = store.get(id);
+            if (op.valid() && operation_filter(op->op))
+                result[(uint32_t)id] = *op;
+        }
+
         auto range = idx.equal_range(block_num);
 
         for (auto it = range.first; it != range.second; ++it)
@@ -172,19 +246,24 @@ public:
 #else
         FC_ASSERT(!_app.is_read_only(), "get_transaction is not available in read-only mode.");
 
+        optional<applied_operation> op;
+
         const auto& idx = _db->get_index<operation_index>().indices().get<by_transaction_id>();
         auto itr = idx.lower_bound(id);
         if (itr != idx.end() && itr->trx_id == id)
-        {
-            auto blk = _db->fetch_block_by_number(itr->block);
-            FC_ASSERT(blk.valid());
-            FC_ASSERT(blk->transactions.size() > itr->trx_in_block);
-            annotated_signed_transaction result = blk->transactions[itr->trx_in_block];
-            result.block_num = itr->block;
-            result.transaction_num = itr->trx_in_block;
-            return result;
-        }
-        FC_ASSERT(false, "Unknown Transaction ${t}", ("t", id));
+            op = applied_operation(*itr);
+        else
+            op = get_plugin()->get_operation_store().find_transaction(id);
+
+        FC_ASSERT(op.valid(), "Unknown Transaction ${t}", ("t", id));
+
+        auto blk = _db->fetch_block_by_number(op->block);
+        FC_ASSERT(blk.valid());
+        FC_ASSERT(blk->transactions.size() > op->trx_in_block);
+        annotated_signed_transaction result = blk->transactions[op->trx_in_block];
+        result.block_num = op->block;
+        result.transaction_num = op->trx_in_block;
+        return result;
 #endif
     }
 
@@ -303,7 +382,7 @@ std::map<uint32_t, applied_operation> blockchain_history_api::get_ops_history(
         default:;
         }
 
-        return _impl->get_ops_history<operation_index>(from_op, limit);
+        return _impl->get_all_ops_history(from_op, limit);
     });
 }
 
@@ -3,6 +3,7 @@
 #include <scorum/blockchain_history/blockchain_history_api.hpp>
 #include <scorum/blockchain_history/devcommittee_history_api.hpp>
 #include <scorum/blockchain_history/schema/history_object.hpp>
+#include <scorum/blockchain_history/operation_store.hpp>
 
 #include <scorum/account_identity/impacted.hpp>
 
@@ -11,6 +12,7 @@
 
 #include <scorum/chain/database/database.hpp>
 #include <scorum/chain/operation_notification.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
 #include <scorum/blockchain_history/schema/operation_objects.hpp>
 
 #include <fc/smart_ref_impl.hpp>
@@ -60,9 +62,20 @@ public:
         db.add_plugin_index<filtered_market_operations_history_index>();
 
         db.pre_apply_operation.connect([&](const operation_notification& note) { on_operation(note); });
+
+        if (!_store_dir.string().empty())
+        {
+            ilog("Blockchain History: storing irreversible operations in ${d}", ("d", _store_dir));
+
+            _store.open(_store_dir, _store_segment_size);
+
+            db.applied_block.connect([&](const signed_block&) { move_irreversible_operations(); });
+        }
     }
 
     const operation_object& create_operation_obj(const operation_notification& note);
+    void move_irreversible_operations();
+    void check_operation_store();
     void update_filtered_operation_index(const operation_object& object, const operation& op);
     void on_operation(const operation_notification& note);
 
@@ -71,6 +84,10 @@ public:
     bool _filter_content = false;
     bool _blacklist = false;
     flat_set<std::string> _op_list;
+
+    fc::path _store_dir;
+    uint64_t _store_segment_size = operation_store::default_segment_size;
+    operation_store _store;
 };
 
 class operation_visitor
@@ -281,6 +298,55 @@ const operation_object& blockchain_history_plugin_impl::create_operation_obj(con
     });
 }
 
+void blockchain_history_plugin_impl::move_irreversible_operations()
+{
+    scorum::chain::database& db = database();
+
+    const uint32_t last_irreversible_block
+        = db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num;
+
+    check_operation_store();
+
+    // ids and blocks of the operations grow together
+    const auto& idx = db.get_index<operation_index, by_id>();
+
+    bool appended = false;
+    for (auto it = idx.begin(); it != idx.end() && it->block <= last_irreversible_block;)
+    {
+        const auto& op = *it;
+        ++it;
+
+        // operations that were restored by the undo of the block are stored already
+        if ((uint64_t)op.id._id >= _store.next_id())
+        {
+            _store.append(op);
+            appended = true;
+        }
+
+        db.remove(op);
+    }
+
+    if (appended)
+        _store.flush();
+}
+
+void blockchain_history_plugin_impl::check_operation_store()
+{
+    if (!_store.is_open())
+        return;
+
+    // the operations of the blocks undone at the opening (or of all blocks if the shared memory was created from
+    // scratch) are created again with the same ids, so the store keeps only the operations the shared memory has
+    // created. Irreversible operations are never undone while the node runs, so it's ahead only after the opening
+    const uint64_t next_id = (uint64_t)database().get_index<operation_index>().next_id()._id;
+    if (_store.next_id() > next_id)
+    {
+        wlog("Operation store is ahead of the shared memory, dropping the operations from ${id}", ("id", next_id));
+
+        _store.truncate(next_id);
+    }
+}
+
 void blockchain_history_plugin_impl::update_filtered_operation_index(const operation_object& object,
                                                                      const operation& op)
 {
@@ -305,6 +371,8 @@ void blockchain_history_plugin_impl::update_filtered_operation_index(const opera
 
 void blockchain_history_plugin_impl::on_operation(const operation_notification& note)
 {
+    check_operation_store();
+
     flat_set<account_name_type> impacted;
     scorum::chain::database& db = database();
 
@@ -381,7 +449,12 @@ void blockchain_history_plugin::plugin_set_program_options(boost::program_option
         "times")("history-whitelist-ops", boost::program_options::value<std::vector<std::string>>()->composing(),
                  "Defines a list of operations which will be explicitly logged.")(
         "history-blacklist-ops", boost::program_options::value<std::vector<std::string>>()->composing(),
-        "Defines a list of operations which will be explicitly ignored.");
+        "Defines a list of operations which will be explicitly ignored.")(
+        "history-operation-store-dir", boost::program_options::value<boost::filesystem::path>(),
+        "Directory to move operations of the irreversible blocks to from the shared memory (absolute path or relative "
+        "to application data dir). All operations are kept in the shared memory if it is not set.")(
+        "history-operation-store-segment-size", boost::program_options::value<uint64_t>()->default_value(256),
+        "Size of the operation store segment file in MB.");
     cli.add(get_api_config(API_BLOCKCHAIN_HISTORY).get_options_descriptions());
     cli.add(get_api_config(API_ACCOUNT_HISTORY).get_options_descriptions());
     cfg.add(cli);
@@ -435,6 +508,18 @@ void blockchain_history_plugin::plugin_initialize(const boost::program_options::
             ilog("Account History: blacklisting ops ${o}", ("o", _my->_op_list));
         }
 
+        if (options.count("history-operation-store-dir"))
+        {
+            auto dir = options.at("history-operation-store-dir").as<boost::filesystem::path>();
+            if (dir.is_relative())
+                dir = app::get_data_dir_path(options) / dir;
+
+            _my->_store_dir = dir;
+        }
+
+        if (options.count("history-operation-store-segment-size"))
+            _my->_store_segment_size = options.at("history-operation-store-segment-size").as<uint64_t>() * 1024 * 1024;
+
         _my->initialize();
     }
     FC_LOG_AND_RETHROW()
@@ -453,6 +538,31 @@ flat_map<account_name_type, account_name_type> blockchain_history_plugin::tracke
 {
     return _my->_tracked_accounts;
 }
+
+optional<applied_operation> blockchain_history_plugin::find_operation(const operation_object::id_type& id) const
+{
+    optional<applied_operation> result;
+
+    const auto* obj = app().chain_database()->find<operation_object>(id);
+    if (obj)
+        result = applied_operation(*obj);
+    else
+        result = _my->_store.get((uint64_t)id._id);
+
+    return result;
+}
+
+applied_operation blockchain_history_plugin::get_operation(const operation_object::id_type& id) const
+{
+    auto result = find_operation(id);
+    FC_ASSERT(result.valid(), "Unknown operation ${id}", ("id", id));
+    return *result;
+}
+
+const operation_store& blockchain_history_plugin::get_operation_store() const
+{
+    return _my->_store;
+}
 }
 }
 
@@ -24,6 +24,15 @@ public:
     {
     }
 
+    std::shared_ptr<blockchain_history_plugin> get_plugin() const
+    {
+        auto plugin = _app.get_plugin<blockchain_history_plugin>(BLOCKCHAIN_HISTORY_PLUGIN_NAME);
+
+        FC_ASSERT(plugin, "Cann't get " BLOCKCHAIN_HISTORY_PLUGIN_NAME " plugin from application.");
+
+        return plugin;
+    }
+
     template <typename history_object_type, typename fill_result_functor>
     void get_history(uint64_t from, uint32_t limit, fill_result_functor& funct) const
     {
@@ -47,9 +56,10 @@ public:
     {
         std::vector<applied_operation> result;
 
-        const auto db = _app.chain_database();
+        const auto plugin = get_plugin();
 
-        auto fill_funct = [&](const history_object_type& hobj) { result.emplace_back(db->get(hobj.op)); };
+        auto fill_funct
+            = [&](const history_object_type& hobj) { result.emplace_back(plugin->get_operation(hobj.op)); };
         this->template get_history<history_object_type>(from, limit, fill_funct);
 
         return result;
@@ -85,11 +95,12 @@ std::vector<applied_withdraw_operation> devcommittee_history_api::get_sp_to_scr_
                                                                                           uint32_t limit) const
 {
     const auto db = _impl->_app.chain_database();
+    const auto plugin = _impl->get_plugin();
     return db->with_read_lock([&]() {
         std::vector<applied_withdraw_operation> result;
 
         auto fill_funct = [&](const devcommittee_withdrawals_to_scr_history_object& obj) {
-            result.emplace_back(db->get(obj.op));
+            result.emplace_back(plugin->get_operation(obj.op));
             auto& applied_op = result.back();
 
             share_type to_withdraw = 0;
@@ -106,7 +117,7 @@ std::vector<applied_withdraw_operation> devcommittee_history_api::get_sp_to_scr_
             }
             else if (!obj.progress.empty())
             {
-                auto last_op = fc::raw::unpack<operation>(db->get(obj.progress.back()).serialized_op);
+                auto last_op = plugin->get_operation(obj.progress.back()).op;
 
                 last_op.weak_visit(
                     [&](const devpool_finished_vesting_withdraw_operation&) {
@@ -126,8 +137,7 @@ std::vector<applied_withdraw_operation> devcommittee_history_api::get_sp_to_scr_
 
                 if (obj.progress.size() > 1)
                 {
-                    auto before_last_op_obj = db->get(*(obj.progress.rbegin() + 1));
-                    auto before_last_op = fc::raw::unpack<operation>(before_last_op_obj.serialized_op);
+                    auto before_last_op = plugin->get_operation(*(obj.progress.rbegin() + 1)).op;
 
                     before_last_op.weak_visit([&](const devpool_finished_vesting_withdraw_operation&) {
                         // if pre-last 'progress' operation is 'acc_finished_' then withdraw was finished
@@ -137,7 +147,7 @@ std::vector<applied_withdraw_operation> devcommittee_history_api::get_sp_to_scr_
 
                 for (auto& id : obj.progress)
                 {
-                    auto op = fc::raw::unpack<operation>(db->get(id).serialized_op);
+                    auto op = plugin->get_operation(id).op;
 
                     op.weak_visit([&](const devpool_to_devpool_vesting_withdraw_operation& op) {
                         applied_op.withdrawn += op.withdrawn.amount;
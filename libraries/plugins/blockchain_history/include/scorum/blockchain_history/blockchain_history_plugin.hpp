@@ -26,6 +26,8 @@
 #include <scorum/app/plugin.hpp>
 #include <scorum/chain/database/database.hpp>
 
+#include <scorum/blockchain_history/schema/applied_operation.hpp>
+
 #ifndef BLOCKCHAIN_HISTORY_PLUGIN_NAME
 #define BLOCKCHAIN_HISTORY_PLUGIN_NAME "blockchain_history"
 #endif
@@ -39,10 +41,15 @@ namespace detail {
 class blockchain_history_plugin_impl;
 }
 
+class operation_store;
+
 /**
  * @brief This plugin is designed to track a range of operations by account so that one node doesn't need to hold the
  * full operation history in memory.
  *
+ * If 'history-operation-store-dir' is set, operations of the irreversible blocks are moved from the shared memory
+ * to the append only operation store. Only the reversible tail of the history stays in the shared memory.
+ *
  * @ingroup plugins
  * @addtogroup blockchain_history_plugin Blockchain history plugin
  */
@@ -60,6 +67,12 @@ public:
 
     flat_map<account_name_type, account_name_type> tracked_accounts() const; /// map start_range to end_range
 
+    /// @returns operation from the shared memory or from the operation store if it is irreversible
+    optional<applied_operation> find_operation(const operation_object::id_type& id) const;
+    applied_operation get_operation(const operation_object::id_type& id) const;
+
+    const operation_store& get_operation_store() const;
+
     friend class detail::blockchain_history_plugin_impl;
     std::unique_ptr<detail::blockchain_history_plugin_impl> _my;
 };
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <scorum/blockchain_history/schema/applied_operation.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/optional.hpp>
+
+#include <memory>
+
+namespace scorum {
+namespace blockchain_history {
+
+namespace detail {
+class operation_store_impl;
+}
+
+/* The operation store is an append only store of the irreversible operations that keeps them out of the shared
+ * memory file. Operations are appended in the order of their ids without gaps.
+ *
+ * operations.NNNNNN - segments of the packed operations, a new segment is started when the current one is full:
+ *
+ * +------------------+------------------+-----+
+ * | Header, Op bytes | Header, Op bytes | ... |
+ * +------------------+------------------+-----+
+ *
+ * operations.index - fixed size entries (segment, position, size, block, timestamp) for every operation id. Both
+ * blocks and timestamps never decrease with ids, so operations of the block and operations by time are found
+ * by the binary search over the memory-mapped index.
+ *
+ * transactions.index - memory-mapped open addressing hash table of the transaction id to the id of its first operation.
+ *
+ * Appended operations become visible for the reads after flush().
+ */
+class operation_store
+{
+public:
+    static const uint64_t default_segment_size = 256 * 1024 * 1024;
+
+    operation_store();
+    ~operation_store();
+
+    /// @param segment_size  is used for the new segments only
+    void open(const fc::path& dir, uint64_t segment_size = default_segment_size);
+    void close();
+    bool is_open() const;
+
+    void append(const operation_object& op);
+    void flush();
+
+    /// drops the operations with ids not less than 'next_id'
+    void truncate(uint64_t next_id);
+
+    /// all operations in [first_id, next_id) are in the store
+    uint64_t first_id() const;
+    uint64_t next_id() const;
+
+    bool contains(uint64_t id) const;
+
+    optional<applied_operation> get(uint64_t id) const;
+
+    /// @returns block of the stored operation
+    uint32_t get_block(uint64_t id) const;
+
+    /// @returns [first, last) ids of the operations in the block
+    std::pair<uint64_t, uint64_t> get_block_range(uint32_t block_num) const;
+
+    /// @returns id of the first operation with timestamp not less than 'timestamp' (or next_id)
+    uint64_t lower_bound(const fc::time_point_sec& timestamp) const;
+
+    /// @returns the first operation of the transaction
+    optional<applied_operation> find_transaction(const transaction_id_type& trx_id) const;
+
+private:
+    std::unique_ptr<detail::operation_store_impl> my;
+};
+}
+}
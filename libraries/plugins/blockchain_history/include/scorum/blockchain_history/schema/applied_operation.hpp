@@ -34,6 +34,7 @@ struct applied_withdraw_operation : public applied_operation
 
     applied_withdraw_operation();
     applied_withdraw_operation(const operation_object& op_obj);
+    applied_withdraw_operation(const applied_operation& op);
 
     asset withdrawn = asset(0, SP_SYMBOL);
     withdraw_status status = active;
@@ -0,0 +1,729 @@
+#include <scorum/blockchain_history/operation_store.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace scorum {
+namespace blockchain_history {
+namespace detail {
+
+struct operation_record_header
+{
+    uint64_t id = 0;
+    transaction_id_type trx_id;
+    uint32_t block = 0;
+    uint32_t trx_in_block = 0;
+    uint16_t op_in_trx = 0;
+    fc::time_point_sec timestamp;
+};
+}
+}
+}
+
+FC_REFLECT(scorum::blockchain_history::detail::operation_record_header,
+           (id)(trx_id)(block)(trx_in_block)(op_in_trx)(timestamp))
+
+namespace scorum {
+namespace blockchain_history {
+namespace detail {
+
+namespace bip = boost::interprocess;
+
+static const uint32_t store_magic = 0x53504f53; // "SOPS"
+static const uint32_t store_version = 1;
+
+static const uint64_t initial_trx_capacity = 1 << 16;
+
+struct index_header
+{
+    uint32_t magic = store_magic;
+    uint32_t version = store_version;
+    uint64_t first_id = 0;
+};
+
+struct index_entry
+{
+    uint64_t position = 0;
+    uint32_t segment = 0;
+    uint32_t size = 0;
+    uint32_t block = 0;
+    uint32_t timestamp = 0;
+};
+
+struct trx_header
+{
+    uint32_t magic = store_magic;
+    uint32_t version = store_version;
+    uint64_t capacity = 0;
+    uint64_t count = 0;
+    uint64_t indexed_id = 0; ///< operations with less ids are in the table
+};
+
+struct trx_entry
+{
+    char trx_id[sizeof(transaction_id_type)];
+    uint32_t reserved = 0;
+    uint64_t op_id = 0; ///< id + 1, 0 for the empty slot
+};
+
+static_assert(sizeof(index_header) == 16, "index header must not be padded");
+static_assert(sizeof(index_entry) == 24, "index entry must not be padded");
+static_assert(sizeof(trx_entry) == 32, "transaction entry must not be padded");
+
+/// Read-only mapping of the file part that was flushed at the time of mapping
+struct mapped_file
+{
+    explicit mapped_file(const fc::path& file)
+    {
+        // empty file can't be mapped
+        if (!fc::exists(file) || fc::file_size(file) == 0)
+            return;
+
+        bip::file_mapping mapping(file.generic_string().c_str(), bip::read_only);
+        bip::mapped_region(mapping, bip::read_only).swap(region);
+    }
+
+    size_t size() const
+    {
+        return region.get_size();
+    }
+
+    const char* data() const
+    {
+        return static_cast<const char*>(region.get_address());
+    }
+
+    bip::mapped_region region;
+};
+
+class operation_store_impl
+{
+public:
+    fc::path dir;
+    fc::path index_file;
+    fc::path trx_file;
+    uint64_t segment_size = operation_store::default_segment_size;
+
+    index_header header;
+    uint64_t count = 0;
+    uint64_t readable_count = 0;
+
+    uint32_t segment = 0;
+    uint64_t segment_pos = 0;
+
+    std::ofstream segment_out;
+    std::ofstream index_out;
+
+    std::unique_ptr<mapped_file> index_mapping;
+    std::vector<std::unique_ptr<mapped_file>> segment_mappings;
+
+    bip::mapped_region trx_region;
+    transaction_id_type last_trx_id;
+
+    mutable std::mutex mutex;
+
+    fc::path segment_file(uint32_t num) const
+    {
+        std::ostringstream name;
+        name << "operations." << std::setw(6) << std::setfill('0') << num;
+        return dir / name.str();
+    }
+
+    uint64_t next_id() const
+    {
+        return header.first_id + count;
+    }
+
+    void open(const fc::path& store_dir, uint64_t new_segment_size)
+    {
+        FC_ASSERT(new_segment_size > 0, "Segment size must be positive.");
+
+        dir = store_dir;
+        index_file = dir / "operations.index";
+        trx_file = dir / "transactions.index";
+        segment_size = new_segment_size;
+
+        if (!fc::exists(dir))
+            fc::create_directories(dir);
+
+        load_index();
+
+        segment_out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        segment_out.open(segment_file(segment).generic_string().c_str(),
+                         std::ios::out | std::ios::binary | std::ios::app);
+
+        index_out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        index_out.open(index_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app);
+
+        readable_count = count;
+
+        load_trx_index();
+    }
+
+    void close()
+    {
+        if (segment_out.is_open())
+            flush();
+
+        segment_out.close();
+        index_out.close();
+        index_mapping.reset();
+        segment_mappings.clear();
+        bip::mapped_region().swap(trx_region);
+    }
+
+    void load_index()
+    {
+        count = 0;
+        segment = 0;
+        segment_pos = 0;
+
+        uint64_t entries = 0;
+        if (fc::exists(index_file) && fc::file_size(index_file) >= sizeof(index_header))
+        {
+            std::ifstream in(index_file.generic_string().c_str(), std::ios::in | std::ios::binary);
+            in.read((char*)&header, sizeof(header));
+
+            FC_ASSERT(header.magic == store_magic, "File is not an operation store index.", ("file", index_file));
+            FC_ASSERT(header.version == store_version, "Unsupported operation store version.",
+                      ("version", header.version));
+
+            entries = (fc::file_size(index_file) - sizeof(index_header)) / sizeof(index_entry);
+        }
+
+        // drop the entries whose operations were not completely written
+        index_entry last;
+        while (entries > 0)
+        {
+            last = read_entry_from_file(entries - 1);
+
+            auto file = segment_file(last.segment);
+            if (fc::exists(file) && fc::file_size(file) >= last.position + last.size)
+                break;
+
+            --entries;
+        }
+
+        if (entries == 0)
+        {
+            fc::remove_all(dir);
+            fc::create_directories(dir);
+            header = index_header();
+            return;
+        }
+
+        if (fc::file_size(index_file) != sizeof(index_header) + sizeof(index_entry) * entries)
+        {
+            wlog("Operation store index has incomplete tail, truncating it to ${n} operations", ("n", entries));
+            fc::resize_file(index_file, sizeof(index_header) + sizeof(index_entry) * entries);
+        }
+
+        count = entries;
+        segment = last.segment;
+        segment_pos = last.position + last.size;
+
+        if (fc::file_size(segment_file(segment)) != segment_pos)
+            fc::resize_file(segment_file(segment), segment_pos);
+
+        for (uint32_t next = segment + 1; fc::exists(segment_file(next)); ++next)
+            fc::remove(segment_file(next));
+    }
+
+    index_entry read_entry_from_file(uint64_t i) const
+    {
+        index_entry entry;
+        std::ifstream in(index_file.generic_string().c_str(), std::ios::in | std::ios::binary);
+        in.seekg(sizeof(index_header) + sizeof(index_entry) * i);
+        in.read((char*)&entry, sizeof(entry));
+        FC_ASSERT(in.good(), "Failed to read operation store index.", ("entry", i));
+        return entry;
+    }
+
+    void append(const operation_object& op)
+    {
+        const uint64_t id = (uint64_t)op.id._id;
+
+        if (count == 0)
+        {
+            header.first_id = id;
+            index_out.write((const char*)&header, sizeof(header));
+        }
+
+        FC_ASSERT(id == next_id(), "Operations must be appended without gaps.", ("id", id)("expected", next_id()));
+
+        detail::operation_record_header record;
+        record.id = id;
+        record.trx_id = op.trx_id;
+        record.block = op.block;
+        record.trx_in_block = op.trx_in_block;
+        record.op_in_trx = op.op_in_trx;
+        record.timestamp = op.timestamp;
+
+        auto packed = fc::raw::pack(record);
+        const uint64_t size = packed.size() + op.serialized_op.size();
+
+        if (segment_pos > 0 && segment_pos + size > segment_size)
+        {
+            segment_out.close();
+            ++segment;
+            segment_pos = 0;
+            segment_out.open(segment_file(segment).generic_string().c_str(),
+                             std::ios::out | std::ios::binary | std::ios::trunc);
+        }
+
+        segment_out.write(packed.data(), packed.size());
+        segment_out.write(op.serialized_op.data(), op.serialized_op.size());
+
+        index_entry entry;
+        entry.position = segment_pos;
+        entry.segment = segment;
+        entry.size = (uint32_t)size;
+        entry.block = op.block;
+        entry.timestamp = op.timestamp.sec_since_epoch();
+        index_out.write((const char*)&entry, sizeof(entry));
+
+        segment_pos += size;
+        ++count;
+
+        if (op.trx_id != transaction_id_type() && op.trx_id != last_trx_id)
+        {
+            insert_trx(op.trx_id, id);
+            last_trx_id = op.trx_id;
+        }
+    }
+
+    void flush()
+    {
+        segment_out.flush();
+        index_out.flush();
+
+        if (trx_region.get_size() > 0)
+        {
+            trx_table_header().indexed_id = next_id();
+            trx_region.flush();
+        }
+
+        readable_count = count;
+    }
+
+    void truncate(uint64_t new_next_id)
+    {
+        if (new_next_id >= next_id())
+            return;
+
+        const uint64_t entries = new_next_id > header.first_id ? new_next_id - header.first_id : 0;
+
+        close();
+
+        // the segments are cut to the remaining operations and the rest of the store is reset at the loading
+        fc::resize_file(index_file, sizeof(index_header) + sizeof(index_entry) * entries);
+        last_trx_id = transaction_id_type();
+
+        open(dir, segment_size);
+    }
+
+    // reads
+
+    index_entry get_entry(uint64_t i)
+    {
+        const size_t end = sizeof(index_header) + sizeof(index_entry) * (i + 1);
+        if (!index_mapping || index_mapping->size() < end)
+        {
+            index_mapping.reset(new mapped_file(index_file));
+            FC_ASSERT(index_mapping->size() >= end, "Operation store index is shorter than was written.");
+        }
+
+        index_entry entry;
+        memcpy(&entry, index_mapping->data() + end - sizeof(index_entry), sizeof(entry));
+        return entry;
+    }
+
+    const mapped_file& get_segment(uint32_t num, uint64_t end)
+    {
+        if (segment_mappings.size() <= num)
+            segment_mappings.resize(num + 1);
+
+        auto& mapping = segment_mappings[num];
+        if (!mapping || mapping->size() < end)
+        {
+            mapping.reset(new mapped_file(segment_file(num)));
+            FC_ASSERT(mapping->size() >= end, "Operation store segment is shorter than was written.",
+                      ("segment", num));
+        }
+
+        return *mapping;
+    }
+
+    bool contains(uint64_t id) const
+    {
+        return id >= header.first_id && id < header.first_id + readable_count;
+    }
+
+    applied_operation read(uint64_t id)
+    {
+        auto entry = get_entry(id - header.first_id);
+        const auto& data = get_segment(entry.segment, entry.position + entry.size);
+
+        fc::datastream<const char*> ds(data.data() + entry.position, entry.size);
+
+        detail::operation_record_header record;
+        fc::raw::unpack(ds, record);
+
+        FC_ASSERT(record.id == id, "Wrong operation was read from operation store.",
+                  ("returned", record.id)("expected", id));
+
+        applied_operation result;
+        result.trx_id = record.trx_id;
+        result.block = record.block;
+        result.trx_in_block = record.trx_in_block;
+        result.op_in_trx = record.op_in_trx;
+        result.timestamp = record.timestamp;
+        fc::raw::unpack(ds, result.op);
+
+        return result;
+    }
+
+    /// @returns index of the first entry for which 'less' is false, entries are partitioned by 'less'
+    template <typename Less> uint64_t partition_point(Less&& less)
+    {
+        uint64_t first = 0;
+        uint64_t n = readable_count;
+        while (n > 0)
+        {
+            uint64_t half = n / 2;
+            if (less(get_entry(first + half)))
+            {
+                first += half + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+        return first;
+    }
+
+    // transactions hash table
+
+    trx_header& trx_table_header()
+    {
+        return *static_cast<trx_header*>(trx_region.get_address());
+    }
+
+    trx_entry* trx_table()
+    {
+        return reinterpret_cast<trx_entry*>(static_cast<char*>(trx_region.get_address()) + sizeof(trx_header));
+    }
+
+    static uint64_t trx_hash(const transaction_id_type& trx_id)
+    {
+        uint64_t h;
+        memcpy(&h, trx_id.data(), sizeof(h));
+        return h;
+    }
+
+    static void map_trx_file(const fc::path& file, bip::mapped_region& region)
+    {
+        bip::file_mapping mapping(file.generic_string().c_str(), bip::read_write);
+        bip::mapped_region(mapping, bip::read_write).swap(region);
+    }
+
+    static void create_trx_file(const fc::path& file, uint64_t capacity, bip::mapped_region& region)
+    {
+        {
+            std::ofstream out(file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        }
+        fc::resize_file(file, sizeof(trx_header) + sizeof(trx_entry) * capacity);
+
+        map_trx_file(file, region);
+
+        trx_header h;
+        h.capacity = capacity;
+        memcpy(region.get_address(), &h, sizeof(h));
+    }
+
+    void load_trx_index()
+    {
+        bool valid = false;
+        if (fc::exists(trx_file) && fc::file_size(trx_file) >= sizeof(trx_header))
+        {
+            map_trx_file(trx_file, trx_region);
+
+            const auto& h = trx_table_header();
+            valid = h.magic == store_magic && h.version == store_version
+                && trx_region.get_size() == sizeof(trx_header) + sizeof(trx_entry) * h.capacity;
+        }
+
+        if (!valid)
+        {
+            create_trx_file(trx_file, initial_trx_capacity, trx_region);
+            trx_table_header().indexed_id = header.first_id;
+        }
+
+        // index operations appended after the last flush of the table
+        uint64_t from = std::max(trx_table_header().indexed_id, header.first_id);
+        if (from < next_id())
+            ilog("Reconstructing transactions index of the operation store from ${id}...", ("id", from));
+
+        for (uint64_t id = from; id < next_id(); ++id)
+        {
+            auto op = read(id);
+            if (op.trx_id != transaction_id_type() && op.trx_id != last_trx_id)
+            {
+                insert_trx(op.trx_id, id);
+                last_trx_id = op.trx_id;
+            }
+        }
+
+        trx_table_header().indexed_id = next_id();
+        trx_region.flush();
+    }
+
+    void insert_trx(const transaction_id_type& trx_id, uint64_t id)
+    {
+        if ((trx_table_header().count + 1) * 2 > trx_table_header().capacity)
+            grow_trx_table();
+
+        auto& h = trx_table_header();
+        auto* table = trx_table();
+
+        for (uint64_t i = trx_hash(trx_id) & (h.capacity - 1);; i = (i + 1) & (h.capacity - 1))
+        {
+            if (table[i].op_id == 0)
+            {
+                memcpy(table[i].trx_id, trx_id.data(), sizeof(table[i].trx_id));
+                table[i].op_id = id + 1;
+                ++h.count;
+                return;
+            }
+
+            // the same operations could be appended again after the store reopening
+            if (memcmp(table[i].trx_id, trx_id.data(), sizeof(table[i].trx_id)) == 0)
+            {
+                table[i].op_id = id + 1;
+                return;
+            }
+        }
+    }
+
+    void grow_trx_table()
+    {
+        const auto& old_header = trx_table_header();
+        const auto* old_table = trx_table();
+
+        fc::path tmp_file = trx_file.generic_string() + ".tmp";
+
+        bip::mapped_region region;
+        create_trx_file(tmp_file, old_header.capacity * 2, region);
+
+        auto& h = *static_cast<trx_header*>(region.get_address());
+        auto* table = reinterpret_cast<trx_entry*>(static_cast<char*>(region.get_address()) + sizeof(trx_header));
+
+        for (uint64_t j = 0; j < old_header.capacity; ++j)
+        {
+            if (old_table[j].op_id == 0)
+                continue;
+
+            uint64_t hash;
+            memcpy(&hash, old_table[j].trx_id, sizeof(hash));
+
+            uint64_t i = hash & (h.capacity - 1);
+            while (table[i].op_id != 0)
+                i = (i + 1) & (h.capacity - 1);
+
+            table[i] = old_table[j];
+        }
+
+        h.count = old_header.count;
+        h.indexed_id = old_header.indexed_id;
+        region.flush();
+
+        bip::mapped_region().swap(trx_region);
+        bip::mapped_region().swap(region);
+
+        fc::rename(tmp_file, trx_file);
+        map_trx_file(trx_file, trx_region);
+    }
+
+    optional<uint64_t> find_trx(const transaction_id_type& trx_id)
+    {
+        optional<uint64_t> result;
+        if (trx_region.get_size() == 0)
+            return result;
+
+        const auto& h = trx_table_header();
+        const auto* table = trx_table();
+
+        for (uint64_t i = trx_hash(trx_id) & (h.capacity - 1); table[i].op_id != 0; i = (i + 1) & (h.capacity - 1))
+        {
+            if (memcmp(table[i].trx_id, trx_id.data(), sizeof(table[i].trx_id)) == 0)
+            {
+                if (contains(table[i].op_id - 1))
+                    result = table[i].op_id - 1;
+                break;
+            }
+        }
+
+        return result;
+    }
+};
+}
+
+operation_store::operation_store()
+    : my(new detail::operation_store_impl())
+{
+}
+
+operation_store::~operation_store()
+{
+    close();
+}
+
+void operation_store::open(const fc::path& dir, uint64_t segment_size)
+{
+    try
+    {
+        close();
+
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->open(dir, segment_size);
+    }
+    FC_CAPTURE_AND_RETHROW((dir)(segment_size))
+}
+
+void operation_store::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->close();
+    }
+
+    my.reset(new detail::operation_store_impl());
+}
+
+bool operation_store::is_open() const
+{
+    return my->segment_out.is_open();
+}
+
+void operation_store::append(const operation_object& op)
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->append(op);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+void operation_store::flush()
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->flush();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+void operation_store::truncate(uint64_t next_id)
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(my->mutex);
+        my->truncate(next_id);
+    }
+    FC_CAPTURE_AND_RETHROW((next_id))
+}
+
+uint64_t operation_store::first_id() const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+    return my->header.first_id;
+}
+
+uint64_t operation_store::next_id() const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+    return my->next_id();
+}
+
+bool operation_store::contains(uint64_t id) const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+    return my->contains(id);
+}
+
+optional<applied_operation> operation_store::get(uint64_t id) const
+{
+    try
+    {
+        optional<applied_operation> result;
+
+        std::lock_guard<std::mutex> lock(my->mutex);
+        if (my->contains(id))
+            result = my->read(id);
+
+        return result;
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+uint32_t operation_store::get_block(uint64_t id) const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+    FC_ASSERT(id >= my->header.first_id && id < my->next_id(), "Operation is not in the store.", ("id", id));
+    if (!my->contains(id))
+        return my->read_entry_from_file(id - my->header.first_id).block;
+    return my->get_entry(id - my->header.first_id).block;
+}
+
+std::pair<uint64_t, uint64_t> operation_store::get_block_range(uint32_t block_num) const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+
+    uint64_t first = my->partition_point([&](const detail::index_entry& e) { return e.block < block_num; });
+    uint64_t last = my->partition_point([&](const detail::index_entry& e) { return e.block <= block_num; });
+
+    return { my->header.first_id + first, my->header.first_id + last };
+}
+
+uint64_t operation_store::lower_bound(const fc::time_point_sec& timestamp) const
+{
+    std::lock_guard<std::mutex> lock(my->mutex);
+
+    const uint32_t sec = timestamp.sec_since_epoch();
+    return my->header.first_id + my->partition_point([&](const detail::index_entry& e) { return e.timestamp < sec; });
+}
+
+optional<applied_operation> operation_store::find_transaction(const transaction_id_type& trx_id) const
+{
+    try
+    {
+        optional<applied_operation> result;
+
+        std::lock_guard<std::mutex> lock(my->mutex);
+        auto id = my->find_trx(trx_id);
+        if (id.valid())
+        {
+            result = my->read(*id);
+            if (result->trx_id != trx_id)
+                result.reset();
+        }
+
+        return result;
+    }
+    FC_LOG_AND_RETHROW()
+}
+}
+}
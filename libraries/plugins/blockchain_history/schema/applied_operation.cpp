@@ -20,5 +20,10 @@ applied_withdraw_operation::applied_withdraw_operation(const operation_object& o
     : applied_operation(op_obj)
 {
 }
+
+applied_withdraw_operation::applied_withdraw_operation(const applied_operation& op)
+    : applied_operation(op)
+{
+}
 }
 }
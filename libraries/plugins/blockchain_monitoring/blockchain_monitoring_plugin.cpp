@@ -59,7 +59,7 @@ public:
 };
 //////////////////////////////////////////////////////////////////////////
 class blockchain_monitoring_plugin_impl
-    : public common_statistics::common_statistics_plugin_impl<bucket_object, blockchain_monitoring_plugin>
+    : public common_statistics::common_statistics_plugin_impl<bucket_object, blockchain_monitoring_plugin, block_metric>
 {
 public:
     perfomance_timer _timer;
@@ -83,24 +83,26 @@ private:
 
     virtual void process_block(const bucket_object& bucket, const signed_block& b) override;
 
-    virtual void process_pre_operation(const bucket_object& bucket, const operation_notification& o) override;
+    virtual void process_pre_operation(block_metric& metric, const operation_notification& o) override;
 
-    virtual void process_post_operation(const bucket_object& bucket, const operation_notification& o) override;
+    virtual void process_post_operation(block_metric& metric, const operation_notification& o) override;
+
+    virtual void apply_metric(bucket_object& bucket, const block_metric& metric) override;
 
     template <typename TSourceId>
-    void collect_withdraw_stats(const bucket_object& bucket, const asset& vesting_shares, const TSourceId& source_id);
+    void collect_withdraw_stats(block_metric& metric, const asset& vesting_shares, const TSourceId& source_id);
 };
 
 class operation_process
 {
 private:
     chain::database& _db;
-    const bucket_object& _bucket;
+    block_metric& _metric;
 
 public:
-    operation_process(chain::database& db, const bucket_object& b)
+    operation_process(chain::database& db, block_metric& metric)
         : _db(db)
-        , _bucket(b)
+        , _metric(metric)
     {
     }
 
@@ -110,113 +112,101 @@ public:
 
     void operator()(const transfer_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.transfers++;
+        _metric.transfers++;
 
-            if (op.amount.symbol() == SCORUM_SYMBOL)
-                b.scorum_transferred += op.amount.amount;
-        });
+        if (op.amount.symbol() == SCORUM_SYMBOL)
+            _metric.scorum_transferred += op.amount.amount;
     }
 
     void operator()(const account_create_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.paid_accounts_created++; });
+        _metric.paid_accounts_created++;
     }
 
     void operator()(const account_create_with_delegation_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.paid_accounts_created++; });
+        _metric.paid_accounts_created++;
     }
 
     void operator()(const account_create_by_committee_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.free_accounts_created++; });
+        _metric.free_accounts_created++;
     }
 
     void operator()(const comment_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
 
-            if (comment.created == _db.head_block_time())
-            {
-                if (comment.parent_author.length())
-                    b.replies++;
-                else
-                    b.root_comments++;
-            }
+        if (comment.created == _db.head_block_time())
+        {
+            if (comment.parent_author.length())
+                _metric.replies++;
             else
-            {
-                if (comment.parent_author.length())
-                    b.reply_edits++;
-                else
-                    b.root_comment_edits++;
-            }
-        });
+                _metric.root_comments++;
+        }
+        else
+        {
+            if (comment.parent_author.length())
+                _metric.reply_edits++;
+            else
+                _metric.root_comment_edits++;
+        }
     }
 
     void operator()(const vote_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            const auto& cv_idx = _db.get_index<comment_vote_index>().indices().get<by_comment_voter>();
-            const auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
-            const auto& voter = _db.account_service().get_account(op.voter);
-            const auto itr = cv_idx.find(boost::make_tuple(comment.id, voter.id));
-
-            if (itr->num_changes)
-            {
-                if (comment.parent_author.size())
-                    b.new_reply_votes++;
-                else
-                    b.new_root_votes++;
-            }
+        const auto& cv_idx = _db.get_index<comment_vote_index>().indices().get<by_comment_voter>();
+        const auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& voter = _db.account_service().get_account(op.voter);
+        const auto itr = cv_idx.find(boost::make_tuple(comment.id, voter.id));
+
+        if (itr->num_changes)
+        {
+            if (comment.parent_author.size())
+                _metric.new_reply_votes++;
             else
-            {
-                if (comment.parent_author.size())
-                    b.changed_reply_votes++;
-                else
-                    b.changed_root_votes++;
-            }
-        });
+                _metric.new_root_votes++;
+        }
+        else
+        {
+            if (comment.parent_author.size())
+                _metric.changed_reply_votes++;
+            else
+                _metric.changed_root_votes++;
+        }
     }
 
     void operator()(const author_reward_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.payouts++;
-            auto reward_symbol = op.reward.symbol();
-            if (SCORUM_SYMBOL == reward_symbol)
-            {
-                b.scr_paid_to_authors += op.reward.amount;
-            }
-            else if (SP_SYMBOL == reward_symbol)
-            {
-                b.scorumpower_paid_to_authors += op.reward.amount;
-            }
-        });
+        _metric.payouts++;
+        auto reward_symbol = op.reward.symbol();
+        if (SCORUM_SYMBOL == reward_symbol)
+        {
+            _metric.scr_paid_to_authors += op.reward.amount;
+        }
+        else if (SP_SYMBOL == reward_symbol)
+        {
+            _metric.scorumpower_paid_to_authors += op.reward.amount;
+        }
     }
 
     void operator()(const curation_reward_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto reward_symbol = op.reward.symbol();
-            if (SCORUM_SYMBOL == reward_symbol)
-            {
-                b.scr_paid_to_curators += op.reward.amount;
-            }
-            else if (SP_SYMBOL == reward_symbol)
-            {
-                b.scorumpower_paid_to_curators += op.reward.amount;
-            }
-        });
+        auto reward_symbol = op.reward.symbol();
+        if (SCORUM_SYMBOL == reward_symbol)
+        {
+            _metric.scr_paid_to_curators += op.reward.amount;
+        }
+        else if (SP_SYMBOL == reward_symbol)
+        {
+            _metric.scorumpower_paid_to_curators += op.reward.amount;
+        }
     }
 
     void operator()(const transfer_to_scorumpower_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.transfers_to_scorumpower++;
-            b.scorum_transferred_to_scorumpower += op.amount.amount;
-        });
+        _metric.transfers_to_scorumpower++;
+        _metric.scorum_transferred_to_scorumpower += op.amount.amount;
     }
 
     void operator()(const acc_finished_vesting_withdraw_operation& op) const
@@ -256,18 +246,16 @@ public:
     void operator()(const proposal_virtual_operation& op) const
     {
         op.proposal_op.weak_visit([&](const development_committee_transfer_operation& op) {
-            _db.modify(_bucket, [&](bucket_object& b) {
-                b.transfers++;
+            _metric.transfers++;
 
-                if (op.amount.symbol() == SCORUM_SYMBOL)
-                    b.scorum_transferred += op.amount.amount;
-            });
+            if (op.amount.symbol() == SCORUM_SYMBOL)
+                _metric.scorum_transferred += op.amount.amount;
         });
     }
 
     void operator()(const witness_miss_block_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.missed_blocks[op.block_num] = op.owner; });
+        _metric.missed_blocks[op.block_num] = op.owner;
     }
 
     template <typename TSourceId> void collect_withdraw_stats(const TSourceId& source_id, const asset& source_sp) const
@@ -282,24 +270,19 @@ public:
             vesting_withdraw_rate = wvo.vesting_withdraw_rate;
         }
 
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.finished_vesting_withdrawals++;
+        _metric.finished_vesting_withdrawals++;
 
-            b.vesting_withdraw_rate_delta -= vesting_withdraw_rate.amount;
-        });
+        _metric.vesting_withdraw_rate_delta -= vesting_withdraw_rate.amount;
     }
 
     void collect_withdraw_stats(const asset& withdrawn) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
+        _metric.vesting_withdrawals_processed++;
 
-            b.vesting_withdrawals_processed++;
-
-            if (withdrawn.symbol() == SCORUM_SYMBOL)
-                b.scorumpower_withdrawn += withdrawn.amount;
-            else
-                b.scorumpower_transferred += withdrawn.amount;
-        });
+        if (withdrawn.symbol() == SCORUM_SYMBOL)
+            _metric.scorumpower_withdrawn += withdrawn.amount;
+        else
+            _metric.scorumpower_transferred += withdrawn.amount;
     }
 };
 
@@ -322,8 +305,7 @@ void blockchain_monitoring_plugin_impl::process_block(const bucket_object& bucke
     });
 }
 
-void blockchain_monitoring_plugin_impl::process_pre_operation(const bucket_object& bucket,
-                                                              const operation_notification& note)
+void blockchain_monitoring_plugin_impl::process_pre_operation(block_metric& metric, const operation_notification& note)
 {
     auto& db = _self.database();
 
@@ -331,37 +313,44 @@ void blockchain_monitoring_plugin_impl::process_pre_operation(const bucket_objec
         [&](const delete_comment_operation& op) {
             auto comment = db.obtain_service<dbs_comment>().get(op.author, op.permlink);
 
-            db.modify(bucket, [&](bucket_object& b) {
-                if (comment.parent_author.length())
-                    b.replies_deleted++;
-                else
-                    b.root_comments_deleted++;
-            });
+            if (comment.parent_author.length())
+                metric.replies_deleted++;
+            else
+                metric.root_comments_deleted++;
         },
         [&](const withdraw_scorumpower_operation& op) {
-            collect_withdraw_stats(bucket, op.scorumpower, db.account_service().get_account(op.account).id);
+            collect_withdraw_stats(metric, op.scorumpower, db.account_service().get_account(op.account).id);
         },
         [&](const proposal_virtual_operation& op) {
             op.proposal_op.weak_visit([&](const development_committee_withdraw_vesting_operation& proposal_op) {
-                collect_withdraw_stats(bucket, proposal_op.vesting_shares, db.dev_pool_service().get().id);
+                collect_withdraw_stats(metric, proposal_op.vesting_shares, db.dev_pool_service().get().id);
             });
         });
 }
 
-void blockchain_monitoring_plugin_impl::process_post_operation(const bucket_object& bucket,
-                                                               const operation_notification& o)
+void blockchain_monitoring_plugin_impl::process_post_operation(block_metric& metric, const operation_notification& o)
 {
     auto& db = _self.database();
 
     if (!is_virtual_operation(o.op))
     {
-        db.modify(bucket, [&](bucket_object& b) { b.operations++; });
+        metric.operations++;
+    }
+    o.op.visit(operation_process(db, metric));
+}
+
+void blockchain_monitoring_plugin_impl::apply_metric(bucket_object& bucket, const block_metric& metric)
+{
+    static_cast<base_metric&>(bucket) += metric;
+
+    for (const auto& item : metric.missed_blocks)
+    {
+        bucket.missed_blocks[item.first] = item.second;
     }
-    o.op.visit(operation_process(db, bucket));
 }
 
 template <typename TSourceId>
-void blockchain_monitoring_plugin_impl::collect_withdraw_stats(const bucket_object& bucket,
+void blockchain_monitoring_plugin_impl::collect_withdraw_stats(block_metric& metric,
                                                                const asset& vesting_shares,
                                                                const TSourceId& source_id)
 {
@@ -381,14 +370,12 @@ void blockchain_monitoring_plugin_impl::collect_withdraw_stats(const bucket_obje
         vesting_withdraw_rate = wvo.vesting_withdraw_rate;
     }
 
-    db.modify(bucket, [&](bucket_object& b) {
-        if (vesting_withdraw_rate.amount > 0)
-            b.modified_vesting_withdrawal_requests++;
-        else
-            b.new_vesting_withdrawal_requests++;
+    if (vesting_withdraw_rate.amount > 0)
+        metric.modified_vesting_withdrawal_requests++;
+    else
+        metric.new_vesting_withdrawal_requests++;
 
-        b.vesting_withdraw_rate_delta += new_vesting_withdrawal_rate - vesting_withdraw_rate.amount;
-    });
+    metric.vesting_withdraw_rate_delta += new_vesting_withdrawal_rate - vesting_withdraw_rate.amount;
 }
 
 } // detail
@@ -2,6 +2,9 @@
 
 #include <fc/api.hpp>
 
+#include <map>
+#include <string>
+
 #ifndef API_NODE_MONITORING
 #define API_NODE_MONITORING "node_monitoring_api"
 #endif
@@ -47,6 +50,11 @@ public:
     uint32_t get_free_shared_memory_mb() const;
     uint32_t get_total_shared_memory_mb() const;
 
+    /**
+    * @brief Returns number of the blocks that are not processed yet by each plugin working in asynchronous mode.
+    */
+    std::map<std::string, uint32_t> get_async_plugins_lag() const;
+
     /// @}
 
 private:
@@ -56,4 +64,5 @@ private:
 } // namespace scorum
 
 FC_API(scorum::blockchain_monitoring::node_monitoring_api,
-       (get_last_block_duration_microseconds)(get_free_shared_memory_mb)(get_total_shared_memory_mb))
+       (get_last_block_duration_microseconds)(get_free_shared_memory_mb)(get_total_shared_memory_mb)(
+           get_async_plugins_lag))
@@ -54,6 +54,8 @@ struct base_metric
     share_type scorumpower_paid_to_authors = 0; ///< Amount of SP paid to authors
     share_type scr_paid_to_curators = 0; ///< Amount of SCR paid to curators
     share_type scorumpower_paid_to_curators = 0; ///< Amount of SP paid to curators
+
+    base_metric& operator+=(const base_metric&);
 };
 
 struct total_metric
@@ -78,6 +80,14 @@ struct statistics : public base_metric, public total_metric
 
 /// @}
 
+/// Metrics collected during the block, they are added to the buckets once per block
+struct block_metric : public base_metric
+{
+    std::map<uint32_t, account_name_type> missed_blocks;
+
+    bool empty() const;
+};
+
 } // namespace blockchain_monitoring
 } // namespace scorum
 
@@ -54,5 +54,11 @@ uint32_t node_monitoring_api::get_total_shared_memory_mb() const
         [&]() { return uint32_t(_my->_app.chain_database()->get_size() / (1024 * 1024)); });
 }
 
+std::map<std::string, uint32_t> node_monitoring_api::get_async_plugins_lag() const
+{
+    // streams report their lag without the database lock
+    return _my->_app.chain_database()->get_async_streams_lag();
+}
+
 } // namespace blockchain_monitoring
 } // namespace scorum
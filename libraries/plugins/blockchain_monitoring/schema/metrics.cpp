@@ -1,10 +1,12 @@
 #include <scorum/blockchain_monitoring/schema/metrics.hpp>
 #include <scorum/blockchain_monitoring/schema/bucket_object.hpp>
 
+#include <fc/io/raw.hpp>
+
 namespace scorum {
 namespace blockchain_monitoring {
 
-statistics& statistics::operator+=(const bucket_object& b)
+base_metric& base_metric::operator+=(const base_metric& b)
 {
     this->blocks += b.blocks;
     this->bandwidth += b.bandwidth;
@@ -39,6 +41,21 @@ statistics& statistics::operator+=(const bucket_object& b)
     this->scorumpower_withdrawn += b.scorumpower_withdrawn;
     this->scorumpower_transferred += b.scorumpower_transferred;
 
+    return (*this);
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool block_metric::empty() const
+{
+    return missed_blocks.empty()
+        && fc::raw::pack(static_cast<const base_metric&>(*this)) == fc::raw::pack(base_metric());
+}
+
+//////////////////////////////////////////////////////////////////////////
+statistics& statistics::operator+=(const bucket_object& b)
+{
+    base_metric::operator+=(b);
+
     // total
     this->total_accounts_created += b.paid_accounts_created + b.free_accounts_created;
     this->total_comments += b.root_comments + b.replies;
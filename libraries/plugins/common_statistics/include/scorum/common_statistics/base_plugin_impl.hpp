@@ -15,7 +15,13 @@ using namespace scorum::chain;
 
 struct by_bucket;
 
-template <typename Bucket, typename Plugin> class common_statistics_plugin_impl
+/**
+ * Operations of the block are collected into the in-process Metric and the Metric is added to every current bucket
+ * once per block (in on_block), so there is a single bucket modification per block instead of one per operation.
+ *
+ * Metric should be default constructible and provide 'bool empty() const'.
+ */
+template <typename Bucket, typename Plugin, typename Metric> class common_statistics_plugin_impl
 {
     typedef typename chainbase::get_index_type<Bucket>::type bucket_index;
 
@@ -27,6 +33,8 @@ public:
     flat_set<typename Bucket::id_type> _current_buckets;
     uint32_t _maximum_history_per_bucket_size = 100;
 
+    Metric _block_metric;
+
 public:
     common_statistics_plugin_impl(Plugin& plugin)
         : _self(plugin)
@@ -42,10 +50,13 @@ public:
     virtual void process_block(const Bucket& bucket, const signed_block& b)
     {
     }
-    virtual void process_pre_operation(const Bucket& bucket, const operation_notification& o)
+    virtual void process_pre_operation(Metric& metric, const operation_notification& o)
+    {
+    }
+    virtual void process_post_operation(Metric& metric, const operation_notification& o)
     {
     }
-    virtual void process_post_operation(const Bucket& bucket, const operation_notification& o)
+    virtual void apply_metric(Bucket& bucket, const Metric& metric)
     {
     }
 
@@ -53,6 +64,7 @@ public:
     {
         auto& db = _self.database();
 
+        db.pre_applied_block.connect([&](const signed_block& b) { this->on_pre_block(b); });
         db.applied_block.connect([&](const signed_block& b) { this->on_block(b); });
         db.pre_apply_operation.connect([&](const operation_notification& o) { this->pre_operation(o); });
         db.post_apply_operation.connect([&](const operation_notification& o) { this->post_operation(o); });
@@ -62,36 +74,47 @@ public:
 
     void pre_operation(const operation_notification& o)
     {
-        auto& db = _self.database();
-
-        for (auto bucket_id : _current_buckets)
-        {
-            const auto& bucket = db.get(bucket_id);
-
-            process_pre_operation(bucket, o);
-        }
+        if (!_current_buckets.empty())
+            process_pre_operation(_block_metric, o);
     }
 
     void post_operation(const operation_notification& o)
     {
         try
         {
-            auto& db = _self.database();
+            if (!_current_buckets.empty())
+                process_post_operation(_block_metric, o);
+        }
+        FC_CAPTURE_AND_RETHROW()
+    }
 
+    void on_pre_block(const signed_block&)
+    {
+        // operations of the pending transactions are undone before the block is applied
+        _block_metric = Metric();
+    }
+
+    void flush_block_metric()
+    {
+        auto& db = _self.database();
+
+        if (!_block_metric.empty())
+        {
             for (auto bucket_id : _current_buckets)
             {
-                const auto& bucket = db.get(bucket_id);
-
-                process_post_operation(bucket, o);
+                db.modify(db.get(bucket_id), [&](Bucket& bucket) { apply_metric(bucket, _block_metric); });
             }
         }
-        FC_CAPTURE_AND_RETHROW()
+
+        _block_metric = Metric();
     }
 
     void on_block(const signed_block& block)
     {
         auto& db = _self.database();
 
+        flush_block_metric();
+
         _current_buckets.clear();
 
         const auto& bucket_idx = db.template get_index<bucket_index, common_statistics::by_bucket>();
@@ -45,6 +45,18 @@ get_raw_block_result raw_block_api::get_raw_block(get_raw_block_args args)
     get_raw_block_result result;
     std::shared_ptr<scorum::chain::database> db = my->app.chain_database();
 
+    // irreversible blocks are served as they are packed in the block log
+    fc::optional<chain::packed_block_view> packed = db->read_packed_block_by_number(args.block_num);
+    if (packed.valid())
+    {
+        chain::signed_block_header header = packed->header();
+        result.raw_block = fc::base64_encode(reinterpret_cast<const unsigned char*>(packed->data()), packed->size());
+        result.block_id = header.id();
+        result.previous = header.previous;
+        result.timestamp = header.timestamp;
+        return result;
+    }
+
     fc::optional<chain::signed_block> block = db->fetch_block_by_number(args.block_num);
     if (!block.valid())
     {
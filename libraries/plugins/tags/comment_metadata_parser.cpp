@@ -0,0 +1,276 @@
+#include <scorum/tags/comment_metadata_parser.hpp>
+
+#include <cstring>
+
+namespace scorum {
+namespace tags {
+
+namespace {
+
+/**
+ * Reads the json object from the buffer. The reading stops with false on anything the full parser may treat in a
+ * different way, nothing is allocated except the extracted strings.
+ */
+class comment_metadata_reader
+{
+public:
+    comment_metadata_reader(const char* begin, const char* end)
+        : _pos(begin)
+        , _end(end)
+    {
+    }
+
+    bool read(comment_metadata& meta)
+    {
+        skip_whitespace();
+        if (!consume('{'))
+            return false;
+
+        skip_whitespace();
+        if (!consume('}'))
+        {
+            uint32_t read_fields = 0;
+            do
+            {
+                skip_whitespace();
+
+                const char* key = nullptr;
+                size_t key_size = 0;
+                if (!read_string(key, key_size))
+                    return false;
+
+                skip_whitespace();
+                if (!consume(':'))
+                    return false;
+                skip_whitespace();
+
+                int field = find_field(key, key_size);
+                if (field < 0)
+                {
+                    if (!skip_value(0))
+                        return false;
+                }
+                else
+                {
+                    // it's up to the full parser which one of the duplicates is taken
+                    if (read_fields & (1u << field))
+                        return false;
+                    read_fields |= 1u << field;
+
+                    if (!read_string_array(get_field(meta, field)))
+                        return false;
+                }
+
+                skip_whitespace();
+            } while (consume(','));
+
+            if (!consume('}'))
+                return false;
+        }
+
+        skip_whitespace();
+        return _pos == _end;
+    }
+
+private:
+    static constexpr int max_depth = 64;
+
+    static int find_field(const char* key, size_t key_size)
+    {
+        static const char* const fields[] = { "domains", "categories", "locales", "tags" };
+
+        for (int i = 0; i < 4; ++i)
+        {
+            if (key_size == strlen(fields[i]) && memcmp(key, fields[i], key_size) == 0)
+                return i;
+        }
+        return -1;
+    }
+
+    static std::set<std::string>& get_field(comment_metadata& meta, int field)
+    {
+        switch (field)
+        {
+        case 0:
+            return meta.domains;
+        case 1:
+            return meta.categories;
+        case 2:
+            return meta.locales;
+        default:
+            return meta.tags;
+        }
+    }
+
+    void skip_whitespace()
+    {
+        while (_pos != _end && (*_pos == ' ' || *_pos == '\t' || *_pos == '\n' || *_pos == '\r'))
+            ++_pos;
+    }
+
+    bool consume(char c)
+    {
+        if (_pos == _end || *_pos != c)
+            return false;
+        ++_pos;
+        return true;
+    }
+
+    bool consume(const char* literal)
+    {
+        const size_t size = strlen(literal);
+        if (static_cast<size_t>(_end - _pos) < size || memcmp(_pos, literal, size) != 0)
+            return false;
+        _pos += size;
+        return true;
+    }
+
+    /// Reads the string having no escapes, the result points to the buffer
+    bool read_string(const char*& begin, size_t& size)
+    {
+        if (!consume('"'))
+            return false;
+
+        begin = _pos;
+        while (_pos != _end && *_pos != '"')
+        {
+            if (*_pos == '\\' || static_cast<unsigned char>(*_pos) < 0x20)
+                return false;
+            ++_pos;
+        }
+        size = _pos - begin;
+        return consume('"');
+    }
+
+    bool skip_string()
+    {
+        if (!consume('"'))
+            return false;
+
+        while (_pos != _end && *_pos != '"')
+        {
+            if (static_cast<unsigned char>(*_pos) < 0x20)
+                return false;
+            if (*_pos == '\\' && ++_pos == _end)
+                return false;
+            ++_pos;
+        }
+        return consume('"');
+    }
+
+    bool skip_digits()
+    {
+        const char* begin = _pos;
+        while (_pos != _end && *_pos >= '0' && *_pos <= '9')
+            ++_pos;
+        return _pos != begin;
+    }
+
+    /// Only the integers and the decimals without the exponent
+    bool skip_number()
+    {
+        consume('-');
+        if (!skip_digits())
+            return false;
+        if (consume('.') && !skip_digits())
+            return false;
+        return _pos == _end || (*_pos != 'e' && *_pos != 'E');
+    }
+
+    bool skip_value(int depth)
+    {
+        if (_pos == _end || depth > max_depth)
+            return false;
+
+        switch (*_pos)
+        {
+        case '"':
+            return skip_string();
+        case '{':
+            ++_pos;
+            skip_whitespace();
+            if (consume('}'))
+                return true;
+            do
+            {
+                skip_whitespace();
+                if (!skip_string())
+                    return false;
+                skip_whitespace();
+                if (!consume(':'))
+                    return false;
+                skip_whitespace();
+                if (!skip_value(depth + 1))
+                    return false;
+                skip_whitespace();
+            } while (consume(','));
+            return consume('}');
+        case '[':
+            ++_pos;
+            skip_whitespace();
+            if (consume(']'))
+                return true;
+            do
+            {
+                skip_whitespace();
+                if (!skip_value(depth + 1))
+                    return false;
+                skip_whitespace();
+            } while (consume(','));
+            return consume(']');
+        case 't':
+            return consume("true");
+        case 'f':
+            return consume("false");
+        case 'n':
+            return consume("null");
+        default:
+            return skip_number();
+        }
+    }
+
+    bool read_string_array(std::set<std::string>& result)
+    {
+        if (!consume('['))
+            return false;
+
+        skip_whitespace();
+        if (consume(']'))
+            return true;
+
+        do
+        {
+            skip_whitespace();
+
+            const char* value = nullptr;
+            size_t value_size = 0;
+            if (!read_string(value, value_size))
+                return false;
+            result.emplace(value, value_size);
+
+            skip_whitespace();
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    const char* _pos;
+    const char* const _end;
+};
+}
+
+comment_metadata parse_comment_metadata(const std::string& json_metadata)
+{
+    if (json_metadata.empty() || json_metadata.size() > TAG_JSON_METADATA_SIZE_MAX)
+        return comment_metadata();
+
+    comment_metadata meta;
+
+    comment_metadata_reader reader(json_metadata.data(), json_metadata.data() + json_metadata.size());
+    if (!reader.read(meta))
+        return comment_metadata::parse(json_metadata);
+
+    return meta;
+}
+}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <scorum/tags/tags_objects.hpp>
+
+#include <string>
+
+namespace scorum {
+namespace tags {
+
+/**
+ * Longer json_metadata isn't parsed, the comment has no tags then
+ */
+#define TAG_JSON_METADATA_SIZE_MAX (64 * 1024)
+
+/**
+ * Extracts the domains, categories, locales and tags from the json_metadata of the comment in one pass without
+ * building the variant tree, the rest of the json is skipped.
+ *
+ * The result is the same as of comment_metadata::parse. The json the extractor doesn't handle itself (escapes in the
+ * extracted strings, values of other types in the extracted fields, duplicate fields or anything that isn't plain
+ * json) is passed to comment_metadata::parse.
+ */
+comment_metadata parse_comment_metadata(const std::string& json_metadata);
+}
+}
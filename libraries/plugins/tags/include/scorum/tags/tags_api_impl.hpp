@@ -1,18 +1,14 @@
 #pragma once
 
 #include <boost/algorithm/string.hpp>
-#include <boost/range/numeric.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/set_algorithm.hpp>
-#include <boost/range/algorithm/copy.hpp>
 #include <boost/range/algorithm/transform.hpp>
-#include <boost/range/algorithm/sort.hpp>
-#include <boost/range/algorithm/max_element.hpp>
-#include <boost/range/algorithm/lower_bound.hpp>
-#include <boost/range/join.hpp>
 
+#include <algorithm>
 #include <stack>
 #include <set>
+#include <unordered_set>
 
 #include <scorum/protocol/types.hpp>
 
@@ -62,8 +58,6 @@ template <typename Fund> asset calc_pending_payout(const discussion& d, const Fu
 class tags_api_impl
 {
 public:
-    using posts_crefs = std::vector<std::reference_wrapper<const tag_object>>;
-
     tags_api_impl(scorum::chain::database& db)
         : _db(db)
         , _services(_db)
@@ -77,7 +71,8 @@ public:
 
     discussion create_discussion(const comment_object& comment) const
     {
-        return discussion(comment, _services.comment_statistic_scr_service(), _services.comment_statistic_sp_service());
+        return discussion(comment, _services.comment_service().get_content(comment),
+                          _services.comment_statistic_scr_service(), _services.comment_statistic_sp_service());
     }
 
     std::vector<api::tag_api_obj> get_trending_tags(const std::string& after_tag, uint32_t limit) const
@@ -146,10 +141,15 @@ public:
 
     std::vector<discussion> get_discussions_by_trending(const discussion_query& query) const
     {
-        auto ordering = [](const tag_object& lhs, const tag_object& rhs) { return lhs.trending > rhs.trending; };
+        auto ordering = [](const tag_object& lhs, const tag_object& rhs) {
+            return std::tie(lhs.trending, lhs.comment) > std::tie(rhs.trending, rhs.comment);
+        };
+        auto position = [](const tag_name_type& tag, const tag_object& t) {
+            return boost::make_tuple(tag, t.trending, t.comment);
+        };
         auto filter = [](const tag_object& t) { return t.net_rshares > 0; };
 
-        return get_discussions(query, ordering, filter);
+        return get_discussions<tags::by_tag_trending>(query, ordering, position, filter);
     }
 
     std::vector<discussion> get_discussions_by_created(const discussion_query& query) const
@@ -157,16 +157,25 @@ public:
         auto ordering = [](const tag_object& lhs, const tag_object& rhs) {
             return std::tie(lhs.created, lhs.comment) > std::tie(rhs.created, rhs.comment);
         };
+        auto position = [](const tag_name_type& tag, const tag_object& t) {
+            return boost::make_tuple(tag, t.created, t.comment);
+        };
+        auto filter = [](const tag_object&) { return true; };
 
-        return get_discussions(query, ordering);
+        return get_discussions<tags::by_tag_created>(query, ordering, position, filter);
     }
 
     std::vector<discussion> get_discussions_by_hot(const discussion_query& query) const
     {
-        auto ordering = [](const tag_object& lhs, const tag_object& rhs) { return lhs.hot > rhs.hot; };
+        auto ordering = [](const tag_object& lhs, const tag_object& rhs) {
+            return std::tie(lhs.hot, lhs.comment) > std::tie(rhs.hot, rhs.comment);
+        };
+        auto position = [](const tag_name_type& tag, const tag_object& t) {
+            return boost::make_tuple(tag, t.hot, t.comment);
+        };
         auto filter = [](const tag_object& t) { return t.net_rshares > 0; };
 
-        return get_discussions(query, ordering, filter);
+        return get_discussions<tags::by_tag_hot>(query, ordering, position, filter);
     }
 
     std::vector<discussion> get_discussions_by_author(const discussion_query& query) const
@@ -287,14 +296,10 @@ private:
     scorum::chain::data_service_factory_i& _services;
     tags_service _tags_service;
 
-    static bool tag_filter_default(const tags::tag_object&)
-    {
-        return true;
-    }
-
     void set_url(discussion& d) const
     {
-        const api::comment_api_obj root(_services.comment_service().get(d.root_comment));
+        const auto& root_comment = _services.comment_service().get(d.root_comment);
+        const api::comment_api_obj root(root_comment, _services.comment_service().get_content(root_comment));
         d.url = "/" + root.category + "/@" + root.author + "/" + root.permlink;
         d.root_title = root.title;
         if (root.id != d.id)
@@ -380,127 +385,51 @@ private:
         return result;
     }
 
-    posts_crefs get_posts(const std::string& tag,
-                          const std::function<bool(const tag_object&)>& tag_filter = &tag_filter_default) const
+    /// Tag with the least number of posts, it drives the tags intersection
+    tag_name_type get_rarest_tag(const std::set<std::string>& tags) const
     {
-        std::string tag_lower = utils::to_lower_copy(tag);
-
-        const auto& tag_idx = _db.get_index<tags::tag_index, tags::by_tag>();
+        const auto& stats_idx = _db.get_index<tags::tag_stats_index, tags::by_tag>();
 
-        auto rng = tag_idx.equal_range(tag_lower) | boost::adaptors::filtered(tag_filter);
-
-        posts_crefs posts;
-        boost::copy(rng, std::back_inserter(posts));
+        auto posts = [&](const std::string& tag) -> uint32_t {
+            auto it = stats_idx.find(tag_name_type(tag));
+            return it != stats_idx.end() ? it->posts : 0u;
+        };
 
-        return posts;
+        return *std::min_element(tags.begin(), tags.end(), [&](const std::string& lhs, const std::string& rhs) {
+            return posts(lhs) < posts(rhs);
+        });
     }
 
-    posts_crefs intersect(const std::vector<posts_crefs>& posts_by_tags) const
+    bool has_all_tags(comment_id_type comment, const std::set<std::string>& tags) const
     {
-        using post_cref = posts_crefs::value_type;
-
-        auto from = posts_by_tags.begin();
-        auto to = posts_by_tags.end();
-
-        posts_crefs start(from->begin(), from->end());
-        auto tail = boost::make_iterator_range(std::next(from), to);
+        const auto& tag_idx = _db.get_index<tags::tag_index, tags::by_tag>();
 
-        /// Each collection in 'posts_by_tags' is already sorted by comment id (see 'tag_index/by_comment').
-        /// Intersect collections in 'posts_by_tags' each with other.
-        /// [[a,b,c],[b,c,d],[c,d,e]] => start: [a,b,c]; tail: [[b,c,d], [c,d,e]]
-        /// 1. [a,b,c] /\ [b,c,d] = [b,c] (i.e. 'intersection' = [b,c])
-        /// 2. [b,c] /\ [c,d,e] = [c] (i.e 'intersection' = [c])
-        // clang-format off
-        posts_crefs intersection = boost::accumulate(tail, start, [](posts_crefs& intersection, const posts_crefs& posts) {
-            /// intersect 'intersection' with 'posts' and put result back into 'intersection'
-            auto upper_bound = boost::set_intersection(intersection, posts, intersection.begin(), [](post_cref lhs, post_cref rhs) {
-                return lhs.get().comment < rhs.get().comment;
-            });
-            intersection.erase(upper_bound, intersection.end());
-
-            return intersection;
+        return std::all_of(tags.begin(), tags.end(), [&](const std::string& tag) {
+            return tag_idx.find(boost::make_tuple(tag_name_type(tag), comment)) != tag_idx.end();
         });
-        // clang-format on
-
-        return intersection;
     }
 
-    posts_crefs union_all(const std::vector<posts_crefs>& posts_by_tags) const
+    bool has_any_tag(comment_id_type comment, const std::unordered_set<std::string>& tags) const
     {
-        using post_cref = posts_crefs::value_type;
-
-        struct less_by_comment
-        {
-            bool operator()(post_cref lhs, post_cref rhs) const
-            {
-                return lhs.get().comment < rhs.get().comment;
-            }
-        };
-
-        std::set<post_cref, less_by_comment> set;
-        for (const auto& posts : posts_by_tags)
-            boost::copy(posts, std::inserter(set, end(set)));
+        const auto& comment_idx = _db.get_index<tags::tag_index, tags::by_comment>();
+        auto rng = comment_idx.equal_range(comment);
 
-        posts_crefs result;
-        result.reserve(set.size());
-        result.assign(set.begin(), set.end());
-
-        return result;
-    }
-
-    posts_crefs exclude(const posts_crefs& filtering_posts,
-                        const discussion_query& query,
-                        const std::function<bool(const tag_object&)>& tag_filter) const
-    {
-        if (filtering_posts.empty())
-            return filtering_posts;
-
-        // clang-format off
-        auto rng_exclude = query.exclude_tags |
-                boost::adaptors::transformed(utils::to_lower_copy) |
-                boost::adaptors::transformed([](const std::string& s) { return utils::substring(s, 0, TAG_LENGTH_MAX); });
-        // clang-format on
-
-        std::set<std::string> tags_exclude(rng_exclude.begin(), rng_exclude.end());
-        if (tags_exclude.empty())
-            return filtering_posts;
-
-        std::vector<posts_crefs> exclude_posts_by_tags;
-        exclude_posts_by_tags.reserve(tags_exclude.size());
-
-        boost::transform(tags_exclude, std::back_inserter(exclude_posts_by_tags),
-                         [&](const std::string& t) { return get_posts(t, tag_filter); });
-
-        if (exclude_posts_by_tags.empty())
-            return filtering_posts;
-
-        using post_cref = posts_crefs::value_type;
-
-        struct less_by_comment
-        {
-            bool operator()(post_cref lhs, post_cref rhs) const
-            {
-                return lhs.get().comment < rhs.get().comment;
-            }
-        };
-
-        std::set<post_cref, less_by_comment> exclude_set;
-        for (const auto& posts : exclude_posts_by_tags)
-            boost::copy(posts, std::inserter(exclude_set, end(exclude_set)));
-
-        posts_crefs result;
-        result.reserve(filtering_posts.size());
-
-        std::copy_if(begin(filtering_posts), end(filtering_posts), std::back_inserter(result),
-                     [&](post_cref post) { return exclude_set.find(post) == exclude_set.end(); });
-
-        return result;
+        return std::any_of(rng.first, rng.second,
+                           [&](const tag_object& t) { return tags.find(std::string(t.tag)) != tags.end(); });
     }
 
+    /**
+     * Merges per tag ranges of the IndexTag index (every range is already sorted by 'ordering') with a heap
+     * and stops as soon as 'limit' discussions are collected, so the cost depends on the page size
+     * rather than on the number of posts with the requested tags.
+     *
+     * 'position' maps tag and start tag_object to the key of the IndexTag index.
+     */
+    template <typename IndexTag, typename Ordering, typename Position, typename TagFilter>
     std::vector<discussion> get_discussions(const discussion_query& query,
-                                            const std::function<bool(const tag_object&, const tag_object&)>& ordering,
-                                            const std::function<bool(const tag_object&)>& tag_filter
-                                            = &tag_filter_default) const
+                                            Ordering&& ordering,
+                                            Position&& position,
+                                            TagFilter&& tag_filter) const
     {
         // clang-format off
         FC_ASSERT(query.limit <= get_api_config(TAGS_API_NAME).max_discussions_list_size,
@@ -513,51 +442,99 @@ private:
         boost::set_intersection(query.tags, query.exclude_tags, std::back_inserter(diff));
         FC_ASSERT(diff.empty(), "include_tags and exclude_tags can't have intersection");
 
-        auto rng = query.tags
-            | boost::adaptors::transformed(utils::to_lower_copy)
-            | boost::adaptors::transformed([](const std::string& s) { return utils::substring(s, 0, TAG_LENGTH_MAX); });
+        auto normalize = [](const std::string& s) {
+            return utils::substring(utils::to_lower_copy(s), 0, TAG_LENGTH_MAX);
+        };
+
+        auto rng = query.tags | boost::adaptors::transformed(normalize);
+        auto rng_exclude = query.exclude_tags | boost::adaptors::transformed(normalize);
         // clang-format on
 
         std::set<std::string> tags(rng.begin(), rng.end());
         if (tags.empty())
             tags.insert("");
 
-        std::vector<posts_crefs> posts_by_tags;
-        posts_by_tags.reserve(tags.size());
+        std::unordered_set<std::string> tags_exclude(rng_exclude.begin(), rng_exclude.end());
 
-        boost::transform(tags, std::back_inserter(posts_by_tags),
-                         [&](const std::string& t) { return get_posts(t, tag_filter); });
+        const tag_object* threshold = nullptr;
+        if (query.start_author && query.start_permlink)
+        {
+            auto id = _services.comment_service().get(*query.start_author, *query.start_permlink).id;
+            const auto& comment_idx = _db.get_index<tags::tag_index, tags::by_comment>();
+            auto it = comment_idx.find(id);
+            FC_ASSERT(it != comment_idx.end(), "start_author/start_permlink is not a tagged post");
+            threshold = &(*it);
+        }
 
-        // clang-format off
-        posts_crefs posts = query.tags_logical_and
-                ? intersect(posts_by_tags)
-                : union_all(posts_by_tags);
-        // clang-format on
+        const auto& idx = _db.get_index<tags::tag_index, IndexTag>();
 
-        std::vector<discussion> result;
+        using iterator = typename std::decay<decltype(idx)>::type::const_iterator;
 
-        posts = exclude(posts, query, tag_filter);
-        if (posts.empty())
-            return result;
+        struct tag_stream
+        {
+            iterator it;
+            iterator end;
+        };
 
-        boost::sort(posts, ordering);
+        // the intersection is driven by the rarest tag, others are checked per candidate
+        std::vector<tag_name_type> stream_tags;
+        if (query.tags_logical_and)
+            stream_tags.push_back(get_rarest_tag(tags));
+        else
+            stream_tags.assign(tags.begin(), tags.end());
+
+        auto skip_filtered = [&](tag_stream& s) {
+            while (s.it != s.end && !tag_filter(*s.it))
+                ++s.it;
+            return s.it != s.end;
+        };
 
-        posts_crefs::value_type threshold = *(posts.begin());
-        if (query.start_author && query.start_permlink)
+        std::vector<tag_stream> streams;
+        streams.reserve(stream_tags.size());
+        for (const auto& tag : stream_tags)
         {
-            auto id = _services.comment_service().get(*query.start_author, *query.start_permlink).id;
-            const auto& comment_idx = _db.get_index<tags::tag_index, tags::by_comment>();
-            threshold = *(comment_idx.find(id));
+            iterator from = threshold ? idx.lower_bound(position(tag, *threshold))
+                                      : idx.lower_bound(boost::make_tuple(tag));
+
+            tag_stream s{ from, idx.upper_bound(boost::make_tuple(tag)) };
+            if (skip_filtered(s))
+                streams.push_back(s);
         }
 
-        auto it = boost::lower_bound(posts, threshold.get(), ordering);
+        auto stream_less = [&](const tag_stream& lhs, const tag_stream& rhs) { return ordering(*rhs.it, *lhs.it); };
+        std::make_heap(streams.begin(), streams.end(), stream_less);
 
-        for (; it != posts.end() && result.size() < query.limit; ++it)
+        std::vector<discussion> result;
+        result.reserve(query.limit);
+
+        // the same post has equal keys in all streams, so its duplicates are popped one after another
+        fc::optional<comment_id_type> last_comment;
+
+        while (!streams.empty() && result.size() < query.limit)
         {
+            std::pop_heap(streams.begin(), streams.end(), stream_less);
+            const tag_object& t = *streams.back().it;
+
+            ++streams.back().it;
+            if (skip_filtered(streams.back()))
+                std::push_heap(streams.begin(), streams.end(), stream_less);
+            else
+                streams.pop_back();
+
+            if (last_comment && *last_comment == t.comment)
+                continue;
+            last_comment = t.comment;
+
+            if (query.tags_logical_and && !has_all_tags(t.comment, tags))
+                continue;
+
+            if (!tags_exclude.empty() && has_any_tag(t.comment, tags_exclude))
+                continue;
+
             try
             {
-                result.push_back(get_discussion(it->get().comment, query.truncate_body));
-                result.back().promoted = asset(it->get().promoted_balance, SCORUM_SYMBOL);
+                result.push_back(get_discussion(t.comment, query.truncate_body));
+                result.back().promoted = asset(t.promoted_balance, SCORUM_SYMBOL);
             }
             catch (const fc::exception& e)
             {
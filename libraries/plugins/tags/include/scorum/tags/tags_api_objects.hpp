@@ -38,9 +38,10 @@ struct comment_api_obj
     {
     }
 
-    comment_api_obj(const scorum::chain::comment_object& o);
+    comment_api_obj(const scorum::chain::comment_object& o, const chain::comment_content& content);
 
     comment_api_obj(const chain::comment_object& o,
+                    const chain::comment_content& content,
                     const comment_statistic_scr_service_i&,
                     const comment_statistic_sp_service_i&);
 
@@ -104,7 +105,7 @@ struct comment_api_obj
     std::vector<beneficiary_route_type> beneficiaries;
 
 private:
-    void set_comment(const chain::comment_object& o);
+    void set_comment(const chain::comment_object& o, const chain::comment_content& content);
     void set_comment_statistic(const chain::comment_statistic_scr_object& stat);
     void set_comment_statistic(const chain::comment_statistic_sp_object& stat);
     void initialize(const chain::comment_object& o);
@@ -137,9 +138,10 @@ struct tag_api_obj
 struct discussion : public comment_api_obj
 {
     discussion(const chain::comment_object& o,
+               const chain::comment_content& content,
                const comment_statistic_scr_service_i& stat_scr,
                const comment_statistic_sp_service_i& stat_sp)
-        : comment_api_obj(o, stat_scr, stat_sp)
+        : comment_api_obj(o, content, stat_scr, stat_sp)
     {
     }
 
@@ -37,6 +37,12 @@ using chainbase::oid;
 #define TAGS_PLUGIN_NAME "tags"
 #define TAG_LENGTH_MAX 24
 
+/**
+ * Hot and trending scores are kept in the fixed point with this number of units in 1, so the ranking indices
+ * compare integers
+ */
+#define TAG_SCORE_PRECISION 1000000000ll
+
 #define TAGS_API_NAME "tags_api"
 
 typedef fc::fixed_utf8_string_24 tag_name_type;
@@ -79,8 +85,8 @@ public:
     int64_t net_rshares = 0;
     int32_t net_votes = 0;
     int32_t children = 0;
-    double hot = 0;
-    double trending = 0;
+    int64_t hot = 0; ///< in 1/TAG_SCORE_PRECISION units
+    int64_t trending = 0; ///< in 1/TAG_SCORE_PRECISION units
     share_type promoted_balance = 0;
 
     account_id_type author;
@@ -93,6 +99,9 @@ struct by_cashout; /// all posts regardless of depth
 struct by_author_comment;
 struct by_comment;
 struct by_tag;
+struct by_tag_trending; /// posts of the tag from the most trending
+struct by_tag_hot; /// posts of the tag from the hottest
+struct by_tag_created; /// posts of the tag from the newest
 
 // clang-format off
 typedef shared_multi_index_container<
@@ -112,7 +121,37 @@ typedef shared_multi_index_container<
                        composite_key<tag_object,
                                      member<tag_object, tag_name_type, &tag_object::tag>,
                                      member<tag_object, comment_id_type, &tag_object::comment>,
-                                     member<tag_object, tag_id_type, &tag_object::id>>>>
+                                     member<tag_object, tag_id_type, &tag_object::id>>>,
+        ordered_unique<tag<by_tag_trending>,
+                       composite_key<tag_object,
+                                     member<tag_object, tag_name_type, &tag_object::tag>,
+                                     member<tag_object, int64_t, &tag_object::trending>,
+                                     member<tag_object, comment_id_type, &tag_object::comment>,
+                                     member<tag_object, tag_id_type, &tag_object::id>>,
+                       composite_key_compare<std::less<tag_name_type>,
+                                             std::greater<int64_t>,
+                                             std::greater<comment_id_type>,
+                                             std::less<tag_id_type>>>,
+        ordered_unique<tag<by_tag_hot>,
+                       composite_key<tag_object,
+                                     member<tag_object, tag_name_type, &tag_object::tag>,
+                                     member<tag_object, int64_t, &tag_object::hot>,
+                                     member<tag_object, comment_id_type, &tag_object::comment>,
+                                     member<tag_object, tag_id_type, &tag_object::id>>,
+                       composite_key_compare<std::less<tag_name_type>,
+                                             std::greater<int64_t>,
+                                             std::greater<comment_id_type>,
+                                             std::less<tag_id_type>>>,
+        ordered_unique<tag<by_tag_created>,
+                       composite_key<tag_object,
+                                     member<tag_object, tag_name_type, &tag_object::tag>,
+                                     member<tag_object, time_point_sec, &tag_object::created>,
+                                     member<tag_object, comment_id_type, &tag_object::comment>,
+                                     member<tag_object, tag_id_type, &tag_object::id>>,
+                       composite_key_compare<std::less<tag_name_type>,
+                                             std::greater<time_point_sec>,
+                                             std::greater<comment_id_type>,
+                                             std::less<tag_id_type>>>>
     >
     tag_index;
 // clang-format on
@@ -375,7 +414,7 @@ struct comment_metadata
         return truncated_meta;
     }
 
-    static comment_metadata parse(const fc::shared_string& json_metadata)
+    static comment_metadata parse(const std::string& json_metadata)
     {
         comment_metadata meta;
 
@@ -383,7 +422,7 @@ struct comment_metadata
         {
             try
             {
-                meta = fc::json::from_string(fc::to_string(json_metadata)).as<comment_metadata>();
+                meta = fc::json::from_string(json_metadata).as<comment_metadata>();
             }
             catch (const fc::exception&)
             {
@@ -6,23 +6,24 @@ namespace scorum {
 namespace tags {
 namespace api {
 
-comment_api_obj::comment_api_obj(const chain::comment_object& o)
+comment_api_obj::comment_api_obj(const chain::comment_object& o, const chain::comment_content& content)
 {
-    set_comment(o);
+    set_comment(o, content);
     initialize(o);
 }
 
 comment_api_obj::comment_api_obj(const chain::comment_object& o,
+                                 const chain::comment_content& content,
                                  const comment_statistic_scr_service_i& statistic_scr_service,
                                  const comment_statistic_sp_service_i& statistic_sp_service)
 {
-    set_comment(o);
+    set_comment(o, content);
     set_comment_statistic(statistic_scr_service.get(o.id));
     set_comment_statistic(statistic_sp_service.get(o.id));
     initialize(o);
 }
 
-void comment_api_obj::set_comment(const chain::comment_object& o)
+void comment_api_obj::set_comment(const chain::comment_object& o, const chain::comment_content& content)
 {
     id = o.id;
     category = fc::to_string(o.category);
@@ -30,9 +31,9 @@ void comment_api_obj::set_comment(const chain::comment_object& o)
     parent_permlink = fc::to_string(o.parent_permlink);
     author = o.author;
     permlink = fc::to_string(o.permlink);
-    title = fc::to_string(o.title);
-    body = fc::to_string(o.body);
-    json_metadata = fc::to_string(o.json_metadata);
+    title = content.title;
+    body = content.body;
+    json_metadata = content.json_metadata;
     last_update = o.last_update;
     created = o.created;
     active = o.active;
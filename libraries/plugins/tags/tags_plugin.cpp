@@ -1,6 +1,7 @@
 #include <scorum/tags/tags_plugin.hpp>
 #include <scorum/tags/tags_api.hpp>
 #include <scorum/tags/tags_objects.hpp>
+#include <scorum/tags/comment_metadata_parser.hpp>
 
 #include <scorum/protocol/config.hpp>
 #include <scorum/common_api/config_api.hpp>
@@ -26,6 +27,8 @@
 #include <boost/range/join.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <cmath>
+
 namespace scorum {
 namespace tags {
 
@@ -147,18 +150,23 @@ struct category_stats_pre_operation_visitor
 
     void operator()(const comment_operation& op) const
     {
-        const comment_object* c
-            = _db.obtain_service<dbs_comment>().find_by<by_permlink>(std::make_tuple(op.author, op.permlink));
+        auto& comment_service = _db.obtain_service<dbs_comment>();
+
+        const comment_object* c = comment_service.find_by<by_permlink>(std::make_tuple(op.author, op.permlink));
 
         if (c != nullptr)
-            _category_stats_service.exclude_from_category_stats(comment_metadata::parse(c->json_metadata));
+            _category_stats_service.exclude_from_category_stats(
+                parse_comment_metadata(comment_service.get_content(*c).json_metadata));
     }
 
     void operator()(const delete_comment_operation& op) const
     {
-        const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        auto& comment_service = _db.obtain_service<dbs_comment>();
 
-        _category_stats_service.exclude_from_category_stats(comment_metadata::parse(c.json_metadata));
+        const comment_object& c = comment_service.get(op.author, op.permlink);
+
+        _category_stats_service.exclude_from_category_stats(
+            parse_comment_metadata(comment_service.get_content(c).json_metadata));
     }
 
     template <typename Op> void operator()(Op&&) const
@@ -166,14 +174,43 @@ struct category_stats_pre_operation_visitor
     } /// ignore all other ops
 };
 
+/**
+ * Parses the metadata of the comment once for all the visitors of the operation
+ */
+class comment_metadata_cache
+{
+public:
+    explicit comment_metadata_cache(database& db)
+        : _db(db)
+    {
+    }
+
+    const comment_metadata& get(const comment_object& c)
+    {
+        if (!_metadata || _comment != c.id)
+        {
+            _metadata = parse_comment_metadata(_db.obtain_service<dbs_comment>().get_content(c).json_metadata);
+            _comment = c.id;
+        }
+        return *_metadata;
+    }
+
+private:
+    database& _db;
+    comment_id_type _comment;
+    fc::optional<comment_metadata> _metadata;
+};
+
 struct category_stats_post_operation_visitor
 {
     database& _db;
     category_stats_service& _category_stats_service;
+    comment_metadata_cache& _metadata;
 
-    category_stats_post_operation_visitor(database& db)
+    category_stats_post_operation_visitor(database& db, comment_metadata_cache& metadata)
         : _db(db)
         , _category_stats_service(_db.obtain_service<category_stats_service>())
+        , _metadata(metadata)
     {
     }
 
@@ -181,7 +218,7 @@ struct category_stats_post_operation_visitor
     {
         const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
 
-        _category_stats_service.include_into_category_stats(comment_metadata::parse(c.json_metadata));
+        _category_stats_service.include_into_category_stats(_metadata.get(c));
     }
 
     template <typename Op> void operator()(Op&&) const
@@ -192,38 +229,51 @@ struct category_stats_post_operation_visitor
 struct post_operation_visitor
 {
     database& _db;
+    comment_metadata_cache& _metadata;
 
-    post_operation_visitor(database& db)
+    post_operation_visitor(database& db, comment_metadata_cache& metadata)
         : _db(db)
+        , _metadata(metadata)
     {
     }
 
-    void remove_stats(const tag_object& tag, const tag_stats_object& stats) const
+    /// @returns integer part of the trending score summed up in the stats of the tag
+    static uint32_t get_stats_trending(int64_t trending)
     {
-        _db.modify(stats, [&](tag_stats_object& s) {
-            s.posts--;
-            s.total_trending -= static_cast<uint32_t>(tag.trending);
-            s.net_votes -= tag.net_votes;
-        });
+        return static_cast<uint32_t>(trending / TAG_SCORE_PRECISION);
     }
 
     void add_stats(const tag_object& tag, const tag_stats_object& stats) const
     {
         _db.modify(stats, [&](tag_stats_object& s) {
             s.posts++;
-            s.total_trending += static_cast<uint32_t>(tag.trending);
+            s.total_trending += get_stats_trending(tag.trending);
             s.net_votes += tag.net_votes;
         });
     }
 
+    void remove_stats(const tag_object& tag, const tag_stats_object& stats) const
+    {
+        _db.modify(stats, [&](tag_stats_object& s) {
+            s.posts--;
+            s.total_trending -= get_stats_trending(tag.trending);
+            s.net_votes -= tag.net_votes;
+        });
+    }
+
     void remove_tag(const tag_object& tag) const
     {
-        /// TODO: update tag stats object
+        remove_stats(tag, get_stats(tag.tag));
+
+        // the object is invalid after the removal
+        const account_id_type author = tag.author;
+        const tag_name_type tag_name = tag.tag;
+
         _db.remove(tag);
 
         const auto& idx = _db.get_index<author_tag_stats_index, by_author_tag_posts>();
 
-        auto it_pair = idx.equal_range(boost::make_tuple(tag.author, tag.tag));
+        auto it_pair = idx.equal_range(boost::make_tuple(author, tag_name));
         for (const auto& stat : boost::make_iterator_range(it_pair))
         {
             _db.modify(stat, [&](author_tag_stats_object& stats) { stats.total_posts--; });
@@ -266,14 +316,28 @@ struct post_operation_visitor
         return tags_in_lower;
     }
 
-    void update_tag(const tag_object& current, const comment_object& comment, double hot, double trending) const
+    void update_tag(const tag_object& current,
+                    const comment_object& comment,
+                    const time_point_sec& cashout,
+                    int64_t hot,
+                    int64_t trending) const
     {
-        const auto& stats = get_stats(current.tag);
-        remove_stats(current, stats);
+        const uint32_t old_stats_trending = get_stats_trending(current.trending);
+        const uint32_t new_stats_trending = get_stats_trending(trending);
+
+        // the stats are changed by the difference only, the number of posts stays the same
+        if (old_stats_trending != new_stats_trending || current.net_votes != comment.net_votes)
+        {
+            _db.modify(get_stats(current.tag), [&](tag_stats_object& s) {
+                s.total_trending -= old_stats_trending;
+                s.total_trending += new_stats_trending;
+                s.net_votes += comment.net_votes - current.net_votes;
+            });
+        }
 
         _db.modify(current, [&](tag_object& obj) {
             obj.active = comment.active;
-            obj.cashout = _db.calculate_discussion_payout_time(comment);
+            obj.cashout = cashout;
             obj.children = comment.children;
             obj.net_rshares = comment.net_rshares.value;
             obj.net_votes = comment.net_votes;
@@ -282,11 +346,9 @@ struct post_operation_visitor
             if (obj.cashout == fc::time_point_sec())
                 obj.promoted_balance = 0;
         });
-
-        add_stats(current, stats);
     }
 
-    void create_tag(const std::string& tag, const comment_object& comment, double hot, double trending) const
+    void create_tag(const std::string& tag, const comment_object& comment, int64_t hot, int64_t trending) const
     {
         account_id_type author = _db.account_service().get_account(comment.author).id;
 
@@ -323,29 +385,32 @@ struct post_operation_visitor
 
     /**
      * https://medium.com/hacking-and-gonzo/how-reddit-ranking-algorithms-work-ef111e33d0d9#.lcbj6auuw
+     *
+     * The score is in 1/TAG_SCORE_PRECISION units. The time part doesn't change and the newer posts start higher,
+     * so the older ones decay without updating them.
      */
-    template <int64_t S, int32_t T> double calculate_score(const share_type& score, const time_point_sec& created) const
+    template <int64_t S, int32_t T>
+    int64_t calculate_score(const share_type& score, const time_point_sec& created) const
     {
         /// new algorithm
         auto mod_score = score.value / S;
 
         /// reddit algorithm
-        double order = log10(std::max<int64_t>(std::abs(mod_score), 1));
-        int sign = 0;
-        if (mod_score > 0)
-            sign = 1;
-        else if (mod_score < 0)
-            sign = -1;
+        int64_t order = 0;
+        if (mod_score > 1 || mod_score < -1)
+            order = std::llround(std::log10(static_cast<double>(std::abs(mod_score))) * TAG_SCORE_PRECISION);
+        if (mod_score < 0)
+            order = -order;
 
-        return sign * order + double(created.sec_since_epoch()) / double(T);
+        return order + int64_t(created.sec_since_epoch()) * TAG_SCORE_PRECISION / T;
     }
 
-    inline double calculate_hot(const share_type& score, const time_point_sec& created) const
+    inline int64_t calculate_hot(const share_type& score, const time_point_sec& created) const
     {
         return calculate_score<10000000, 10000>(score, created);
     }
 
-    inline double calculate_trending(const share_type& score, const time_point_sec& created) const
+    inline int64_t calculate_trending(const share_type& score, const time_point_sec& created) const
     {
         return calculate_score<10000000, 480000>(score, created);
     }
@@ -355,14 +420,16 @@ struct post_operation_visitor
     {
         try
         {
-            auto hot = calculate_hot(c.net_rshares, c.created);
-            auto trending = calculate_trending(c.net_rshares, c.created);
+            // computed once for all tags of the comment
+            const auto hot = calculate_hot(c.net_rshares, c.created);
+            const auto trending = calculate_trending(c.net_rshares, c.created);
+            const auto cashout = _db.calculate_discussion_payout_time(c);
 
             const auto& comment_idx = _db.get_index<scorum::tags::tag_index, by_comment>();
 
             if (parse_tags)
             {
-                auto tags = collect_tags(comment_metadata::parse(c.json_metadata));
+                auto tags = collect_tags(_metadata.get(c));
                 auto citr = comment_idx.lower_bound(c.id);
 
                 std::map<std::string, const tag_object*> existing_tags;
@@ -393,7 +460,7 @@ struct post_operation_visitor
                     }
                     else
                     {
-                        update_tag(*existing->second, c, hot, trending);
+                        update_tag(*existing->second, c, cashout, hot, trending);
                     }
                 }
 
@@ -406,7 +473,7 @@ struct post_operation_visitor
 
                 while (citr != comment_idx.end() && citr->comment == c.id)
                 {
-                    update_tag(*citr, c, hot, trending);
+                    update_tag(*citr, c, cashout, hot, trending);
                     ++citr;
                 }
             }
@@ -505,17 +572,20 @@ struct post_operation_visitor
 
     void operator()(const comment_reward_operation& op) const
     {
-        const comment_object& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        auto& comment_service = _db.obtain_service<dbs_comment>();
+
+        const comment_object& comment = comment_service.get(op.author, op.permlink);
         if (comment.parent_author != SCORUM_ROOT_POST_PARENT_ACCOUNT)
             return;
 
         update_tags(comment);
 
-        auto tags = collect_tags(comment_metadata::parse(comment.json_metadata));
+        // the tag objects of the post are the tags collected from its metadata by the last edit
+        const auto& comment_idx = _db.get_index<scorum::tags::tag_index, by_comment>();
 
-        for (const std::string& tag : tags)
+        for (const tag_object& tag : boost::make_iterator_range(comment_idx.equal_range(comment.id)))
         {
-            _db.modify(get_stats(tag), [&](tag_stats_object& ts) {
+            _db.modify(get_stats(tag.tag), [&](tag_stats_object& ts) {
                 if (op.total_payout.symbol() == SCORUM_SYMBOL)
                 {
                     ts.total_payout_scr += op.total_payout;
@@ -563,8 +633,9 @@ void tags_plugin_impl::post_operation(const operation_notification& note)
     try
     {
         /// plugins shouldn't ever throw
-        note.op.visit(post_operation_visitor(database()));
-        note.op.visit(category_stats_post_operation_visitor(database()));
+        comment_metadata_cache metadata(database());
+        note.op.visit(post_operation_visitor(database(), metadata));
+        note.op.visit(category_stats_post_operation_visitor(database(), metadata));
     }
     catch (const fc::exception& e)
     {
@@ -444,7 +444,10 @@ void witness_plugin::plugin_initialize(const boost::program_options::variables_m
         chain::database& db = database();
 
         db.on_pre_apply_transaction.connect([&](const signed_transaction& tx) { _my->pre_transaction(tx); });
-        db.pre_apply_operation.connect([&](const operation_notification& note) { _my->pre_operation(note); });
+        auto on_pre_operation = [&](const operation_notification& note) { _my->pre_operation(note); };
+        db.pre_apply_operation_of<comment_options_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<comment_operation>().connect(on_pre_operation);
+        db.pre_apply_operation_of<transfer_operation>().connect(on_pre_operation);
         db.applied_block.connect([&](const signed_block& b) { _my->on_block(b); });
 
         db.add_plugin_index<account_bandwidth_index>();
@@ -42,6 +42,17 @@ bool signed_block_header::validate_signee(const fc::ecc::public_key& expected_si
     return signee() == expected_signee;
 }
 
+public_key_type signed_block_header::signee(signature_keys_cache& keys_cache) const
+{
+    return keys_cache.get_key(witness_signature, digest());
+}
+
+bool signed_block_header::validate_signee(const fc::ecc::public_key& expected_signee,
+                                          signature_keys_cache& keys_cache) const
+{
+    return signee(keys_cache) == expected_signee;
+}
+
 checksum_type signed_block::calculate_merkle_root() const
 {
     if (transactions.size() == 0)
@@ -68,6 +79,18 @@ checksum_type signed_block::calculate_merkle_root() const
     }
     return checksum_type::hash(ids[0]);
 }
+
+immutable_block::immutable_block(signed_block b)
+    : signed_block(std::move(b))
+    , _id(signed_block::id())
+    , _packed_size(fc::raw::pack_size(static_cast<const signed_block&>(*this)))
+{
+}
+
+immutable_block_ptr make_immutable_block(signed_block b)
+{
+    return std::make_shared<const immutable_block>(std::move(b));
+}
 }
 
 block_info::block_info(uint32_t block_num, std::string block_id, fc::time_point_sec when, std::string block_witness)
@@ -86,6 +109,14 @@ block_info::block_info(const scorum::protocol::signed_block& block)
 {
 }
 
+block_info::block_info(const scorum::protocol::immutable_block& block)
+    : _block_num(block.block_num())
+    , _block_id(block.id().str())
+    , _when(block.timestamp)
+    , _block_witness(block.witness)
+{
+}
+
 block_info::block_info(const fc::time_point_sec& when, const std::string& witness_owner)
     : _when(when)
     , _block_witness(witness_owner)
@@ -100,3 +131,16 @@ block_info::operator std::string() const
     return store.str();
 }
 } // scorum::protocol
+
+namespace fc {
+void to_variant(const scorum::protocol::immutable_block_ptr& b, fc::variant& v)
+{
+    FC_ASSERT(b, "Null block can't be converted");
+    to_variant(static_cast<const scorum::protocol::signed_block&>(*b), v);
+}
+
+void from_variant(const fc::variant& v, scorum::protocol::immutable_block_ptr& b)
+{
+    b = scorum::protocol::make_immutable_block(v.as<scorum::protocol::signed_block>());
+}
+}
@@ -2,6 +2,7 @@
 #include <scorum/protocol/block_header.hpp>
 #include <scorum/protocol/transaction.hpp>
 
+#include <memory>
 #include <string>
 
 namespace scorum {
@@ -12,6 +13,35 @@ struct signed_block : public signed_block_header
     checksum_type calculate_merkle_root() const;
     std::vector<signed_transaction> transactions;
 };
+
+/**
+ * Block that is not changed after it has been received or generated. It's shared by the network, the fork database
+ * and the block log, so it's copied, hashed and measured once.
+ */
+class immutable_block : public signed_block
+{
+public:
+    explicit immutable_block(signed_block b);
+
+    /// hides signed_block_header::id(), the id is calculated once on creation
+    const block_id_type& id() const
+    {
+        return _id;
+    }
+
+    uint32_t packed_size() const
+    {
+        return _packed_size;
+    }
+
+private:
+    block_id_type _id;
+    uint32_t _packed_size = 0;
+};
+
+using immutable_block_ptr = std::shared_ptr<const immutable_block>;
+
+immutable_block_ptr make_immutable_block(signed_block b);
 }
 
 // use for context in logs
@@ -20,6 +50,7 @@ class block_info
 public:
     block_info(uint32_t block_num, std::string block_id, fc::time_point_sec when, std::string block_witness);
     block_info(const scorum::protocol::signed_block&);
+    block_info(const scorum::protocol::immutable_block&);
     block_info(const fc::time_point_sec& when, const std::string& witness_owner);
     block_info()
     {
@@ -37,3 +68,24 @@ private:
 } // scorum::protocol
 
 FC_REFLECT_DERIVED(scorum::protocol::signed_block, (scorum::protocol::signed_block_header), (transactions))
+
+namespace fc {
+// immutable block is serialized as the signed block, the id and the size are calculated on unpacking
+namespace raw {
+template <typename Stream> void pack(Stream& s, const scorum::protocol::immutable_block_ptr& b)
+{
+    FC_ASSERT(b, "Null block can't be packed");
+    fc::raw::pack(s, static_cast<const scorum::protocol::signed_block&>(*b));
+}
+
+template <typename Stream> void unpack(Stream& s, scorum::protocol::immutable_block_ptr& b)
+{
+    scorum::protocol::signed_block tmp;
+    fc::raw::unpack(s, tmp);
+    b = scorum::protocol::make_immutable_block(std::move(tmp));
+}
+}
+
+void to_variant(const scorum::protocol::immutable_block_ptr& b, fc::variant& v);
+void from_variant(const fc::variant& v, scorum::protocol::immutable_block_ptr& b);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <scorum/protocol/base.hpp>
+#include <scorum/protocol/signature_keys_cache.hpp>
 
 namespace scorum {
 namespace protocol {
@@ -29,6 +30,10 @@ struct signed_block_header : public block_header
     void sign(const fc::ecc::private_key& signer);
     bool validate_signee(const fc::ecc::public_key& expected_signee) const;
 
+    /// signee is taken from (or recovered into) the cache
+    public_key_type signee(signature_keys_cache& keys_cache) const;
+    bool validate_signee(const fc::ecc::public_key& expected_signee, signature_keys_cache& keys_cache) const;
+
     signature_type witness_signature;
 };
 }
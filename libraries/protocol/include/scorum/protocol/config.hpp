@@ -88,7 +88,7 @@ namespace detail {
 
 #define DAYS_TO_SECONDS(X)                     (60u*60u*24u*X)
 
-#define SCORUM_BLOCKCHAIN_VERSION              ( version(0, 7, 0) )
+#define SCORUM_BLOCKCHAIN_VERSION              ( version(0, 8, 0) )
 
 #define SCORUM_BLOCKCHAIN_HARDFORK_VERSION     ( hardfork_version( SCORUM_BLOCKCHAIN_VERSION ) )
 
@@ -125,6 +125,9 @@ namespace detail {
 
 #define SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD           (scorum::protocol::detail::get_config().active_sp_holders_reward_period)
 
+// scale of active SP holders reward-per-share indices (accumulator mode since hardfork #8)
+#define SCORUM_ACTIVE_SP_HOLDERS_REWARD_PRECISION        uint64_t(1000000000000000000ull)
+
 #define SCORUM_MIN_BET_STAKE_FOR_MATCHING      share_type(1)
 
 
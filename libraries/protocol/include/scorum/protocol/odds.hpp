@@ -9,6 +9,8 @@ namespace protocol {
 
 using odds_value_type = int32_t;
 using odds_fraction_type = utils::fraction<odds_value_type, odds_value_type>;
+// (numerator, denominator) pair, suitable as ordered index key
+using odds_key_type = std::tuple<odds_value_type, odds_value_type>;
 
 class odds
 {
@@ -51,6 +53,16 @@ public:
 
     odds_fraction_type inverted() const;
 
+    const odds_key_type& simplified_key() const
+    {
+        return _simplified;
+    }
+
+    const odds_key_type& inverted_key() const
+    {
+        return _inverted;
+    }
+
     operator odds_fraction_type() const
     {
         return simplified();
@@ -65,9 +77,9 @@ public:
     std::string to_string() const;
 
 private:
-    std::tuple<odds_value_type, odds_value_type> _base;
-    std::tuple<odds_value_type, odds_value_type> _simplified;
-    std::tuple<odds_value_type, odds_value_type> _inverted;
+    odds_key_type _base;
+    odds_key_type _simplified;
+    odds_key_type _inverted;
 };
 
 template <typename Stream> Stream& operator<<(Stream& stream, const scorum::protocol::odds& o)
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <scorum/protocol/types.hpp>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace scorum {
+namespace protocol {
+
+/**
+ * Thread safe cache of public keys recovered from signatures.
+ *
+ * Recovery is deterministic for (digest, signature), so the cache can be filled by worker threads before
+ * the signatures are checked. The oldest keys are evicted when the capacity is exceeded.
+ */
+class signature_keys_cache
+{
+public:
+    explicit signature_keys_cache(size_t capacity = 1 << 16);
+
+    /// returns cached key or recovers (and caches) it. Throws like fc::ecc::public_key(sig, digest)
+    public_key_type get_key(const signature_type& sig, const digest_type& digest);
+
+    bool contains(const signature_type& sig, const digest_type& digest) const;
+
+    size_t size() const;
+    void clear();
+
+private:
+    struct key_type
+    {
+        digest_type digest;
+        signature_type sig;
+
+        bool operator==(const key_type& other) const
+        {
+            return digest == other.digest && sig == other.sig;
+        }
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key_type& k) const
+        {
+            // digest is already a hash
+            return static_cast<size_t>(k.digest._hash[0] ^ k.digest._hash[3]);
+        }
+    };
+
+    const size_t _capacity;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<key_type, public_key_type, key_hash> _keys;
+    std::deque<key_type> _order;
+};
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <scorum/protocol/operations.hpp>
 #include <scorum/protocol/sign_state.hpp>
+#include <scorum/protocol/signature_keys_cache.hpp>
 #include <scorum/protocol/types.hpp>
 
 #include <numeric>
@@ -71,6 +72,14 @@ struct signed_transaction : public transaction
                           const authority_getter& get_posting,
                           uint32_t max_recursion = SCORUM_MAX_SIG_CHECK_DEPTH) const;
 
+    /// same as verify_authority above but signature keys are taken from (or recovered into) the cache
+    void verify_authority(const chain_id_type& chain_id,
+                          signature_keys_cache& keys_cache,
+                          const authority_getter& get_active,
+                          const authority_getter& get_owner,
+                          const authority_getter& get_posting,
+                          uint32_t max_recursion = SCORUM_MAX_SIG_CHECK_DEPTH) const;
+
     std::set<public_key_type> minimize_required_signatures(const chain_id_type& chain_id,
                                                            const flat_set<public_key_type>& available_keys,
                                                            const authority_getter& get_active,
@@ -79,6 +88,8 @@ struct signed_transaction : public transaction
                                                            uint32_t max_recursion = SCORUM_MAX_SIG_CHECK_DEPTH) const;
 
     flat_set<public_key_type> get_signature_keys(const chain_id_type& chain_id) const;
+    flat_set<public_key_type> get_signature_keys(const chain_id_type& chain_id,
+                                                 signature_keys_cache& keys_cache) const;
 
     std::vector<signature_type> signatures;
 
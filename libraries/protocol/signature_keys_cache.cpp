@@ -0,0 +1,58 @@
+#include <scorum/protocol/signature_keys_cache.hpp>
+
+namespace scorum {
+namespace protocol {
+
+signature_keys_cache::signature_keys_cache(size_t capacity)
+    : _capacity(capacity > 0 ? capacity : 1)
+{
+}
+
+public_key_type signature_keys_cache::get_key(const signature_type& sig, const digest_type& digest)
+{
+    key_type key{ digest, sig };
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto itr = _keys.find(key);
+        if (itr != _keys.end())
+            return itr->second;
+    }
+
+    // recovery is slow, it is done without lock
+    public_key_type result = fc::ecc::public_key(sig, digest);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_keys.emplace(key, result).second)
+    {
+        _order.push_back(key);
+        while (_order.size() > _capacity)
+        {
+            _keys.erase(_order.front());
+            _order.pop_front();
+        }
+    }
+
+    return result;
+}
+
+bool signature_keys_cache::contains(const signature_type& sig, const digest_type& digest) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keys.find(key_type{ digest, sig }) != _keys.end();
+}
+
+size_t signature_keys_cache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keys.size();
+}
+
+void signature_keys_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _keys.clear();
+    _order.clear();
+}
+}
+}
@@ -182,6 +182,23 @@ flat_set<public_key_type> signed_transaction::get_signature_keys(const chain_id_
     FC_CAPTURE_AND_RETHROW()
 }
 
+flat_set<public_key_type> signed_transaction::get_signature_keys(const chain_id_type& chain_id,
+                                                                 signature_keys_cache& keys_cache) const
+{
+    try
+    {
+        auto d = sig_digest(chain_id);
+        flat_set<public_key_type> result;
+        for (const auto& sig : signatures)
+        {
+            SCORUM_ASSERT(result.insert(keys_cache.get_key(sig, d)).second, tx_duplicate_sig,
+                          "Duplicate Signature detected");
+        }
+        return result;
+    }
+    FC_CAPTURE_AND_RETHROW()
+}
+
 std::set<public_key_type> signed_transaction::get_required_signatures(const chain_id_type& chain_id,
                                                                       const flat_set<public_key_type>& available_keys,
                                                                       const authority_getter& get_active,
@@ -288,5 +305,20 @@ void signed_transaction::verify_authority(const chain_id_type& chain_id,
     }
     FC_CAPTURE_AND_RETHROW((*this))
 }
+
+void signed_transaction::verify_authority(const chain_id_type& chain_id,
+                                          signature_keys_cache& keys_cache,
+                                          const authority_getter& get_active,
+                                          const authority_getter& get_owner,
+                                          const authority_getter& get_posting,
+                                          uint32_t max_recursion) const
+{
+    try
+    {
+        scorum::protocol::verify_authority(operations, get_signature_keys(chain_id, keys_cache), get_active,
+                                           get_owner, get_posting, max_recursion);
+    }
+    FC_CAPTURE_AND_RETHROW((*this))
+}
 }
 } // scorum::protocol
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace scorum {
+namespace utils {
+
+/**
+ * Blocking FIFO queue with limited capacity to connect producer and consumer threads.
+ *
+ * push() waits while the queue is full, pop() waits while it is empty. After close() pushes are rejected
+ * and pop() returns remaining items and then false.
+ */
+template <typename T> class bounded_queue
+{
+public:
+    explicit bounded_queue(size_t capacity)
+        : _capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+
+    bounded_queue(const bounded_queue&) = delete;
+    bounded_queue& operator=(const bounded_queue&) = delete;
+
+    /// @returns false if the queue has been closed
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_full.wait(lock, [&] { return _closed || _items.size() < _capacity; });
+
+        if (_closed)
+            return false;
+
+        _items.push_back(std::move(item));
+        _not_empty.notify_one();
+
+        return true;
+    }
+
+    /// @returns false if the queue has been closed and there are no more items
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_empty.wait(lock, [&] { return _closed || !_items.empty(); });
+
+        if (_items.empty())
+            return false;
+
+        item = std::move(_items.front());
+        _items.pop_front();
+        _not_full.notify_one();
+
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+        }
+        _not_full.notify_all();
+        _not_empty.notify_all();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size();
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+private:
+    const size_t _capacity;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _not_full;
+    std::condition_variable _not_empty;
+    std::deque<T> _items;
+    bool _closed = false;
+};
+}
+}
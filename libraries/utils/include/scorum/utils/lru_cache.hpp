@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace scorum {
+namespace utils {
+
+/**
+ * Cache of limited capacity evicting the least recently used item. It's not thread safe.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class lru_cache
+{
+public:
+    explicit lru_cache(size_t capacity)
+        : _capacity(capacity)
+    {
+    }
+
+    /// @returns cached value (and marks it as the most recently used one) or nullptr
+    const Value* find(const Key& key)
+    {
+        auto it = _map.find(key);
+        if (it == _map.end())
+            return nullptr;
+
+        _items.splice(_items.begin(), _items, it->second);
+
+        return &it->second->second;
+    }
+
+    void insert(const Key& key, Value value)
+    {
+        if (_capacity == 0)
+            return;
+
+        auto it = _map.find(key);
+        if (it != _map.end())
+        {
+            it->second->second = std::move(value);
+            _items.splice(_items.begin(), _items, it->second);
+            return;
+        }
+
+        _items.emplace_front(key, std::move(value));
+        _map.emplace(key, _items.begin());
+
+        if (_items.size() > _capacity)
+        {
+            _map.erase(_items.back().first);
+            _items.pop_back();
+        }
+    }
+
+    void set_capacity(size_t capacity)
+    {
+        _capacity = capacity;
+
+        while (_items.size() > _capacity)
+        {
+            _map.erase(_items.back().first);
+            _items.pop_back();
+        }
+    }
+
+    size_t size() const
+    {
+        return _items.size();
+    }
+
+    void clear()
+    {
+        _map.clear();
+        _items.clear();
+    }
+
+private:
+    using items_type = std::list<std::pair<Key, Value>>;
+
+    size_t _capacity;
+    items_type _items;
+    std::unordered_map<Key, typename items_type::iterator, Hash> _map;
+};
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <scorum/utils/bounded_queue.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace scorum {
+namespace utils {
+
+/**
+ * Fixed number of worker threads executing posted tasks in the posting order.
+ *
+ * Tasks must not post to the same pool and wait for the result (the queue is bounded).
+ */
+class thread_pool
+{
+public:
+    /// @param threads  number of workers, 0 - by hardware concurrency
+    explicit thread_pool(size_t threads = 0, size_t queue_size = 4096)
+        : _tasks(queue_size)
+    {
+        if (threads == 0)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        for (size_t i = 0; i < threads; ++i)
+            _threads.emplace_back([this] { work(); });
+    }
+
+    ~thread_pool()
+    {
+        _tasks.close();
+        for (auto& t : _threads)
+            t.join();
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /// @returns future to wait for the task or to get its exception
+    template <typename Task> std::future<void> post(Task&& task)
+    {
+        auto packaged = std::make_shared<std::packaged_task<void()>>(std::forward<Task>(task));
+        auto result = packaged->get_future();
+
+        _tasks.push([packaged] { (*packaged)(); });
+
+        return result;
+    }
+
+    size_t size() const
+    {
+        return _threads.size();
+    }
+
+private:
+    void work()
+    {
+        std::function<void()> task;
+        while (_tasks.pop(task))
+            task();
+    }
+
+    bounded_queue<std::function<void()>> _tasks;
+    std::vector<std::thread> _threads;
+};
+}
+}
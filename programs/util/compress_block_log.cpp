@@ -0,0 +1,130 @@
+#include <scorum/chain/block_log.hpp>
+#include <scorum/chain/compressed_block_log.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Converts the block log to the compressed block log and compares them by size and by random read latency
+//
+// compress_block_log <block_log> <compressed_block_log> [blocks_per_chunk] [samples]
+
+namespace {
+
+struct latency
+{
+    int64_t avg_us = 0;
+    int64_t p50_us = 0;
+    int64_t p99_us = 0;
+};
+
+template <typename ReadBlock> latency measure(const std::vector<uint32_t>& block_nums, ReadBlock&& read_block)
+{
+    std::vector<int64_t> times;
+    times.reserve(block_nums.size());
+
+    for (uint32_t block_num : block_nums)
+    {
+        auto started = fc::time_point::now();
+        auto b = read_block(block_num);
+        times.push_back((fc::time_point::now() - started).count());
+
+        FC_ASSERT(b.valid() && b->block_num() == block_num, "Block ${n} was not read", ("n", block_num));
+    }
+
+    latency result;
+    if (times.empty())
+        return result;
+
+    std::sort(times.begin(), times.end());
+
+    int64_t total = 0;
+    for (auto t : times)
+        total += t;
+
+    result.avg_us = total / (int64_t)times.size();
+    result.p50_us = times[times.size() / 2];
+    result.p99_us = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    return result;
+}
+
+uint64_t files_size(const fc::path& file)
+{
+    auto index = fc::path(file.generic_string() + ".index");
+    return fc::file_size(file) + (fc::exists(index) ? fc::file_size(index) : 0);
+}
+
+void print(const std::string& name, const latency& l)
+{
+    std::cout << name << " random read: avg " << l.avg_us << " us, p50 " << l.p50_us << " us, p99 " << l.p99_us
+              << " us" << std::endl;
+}
+}
+
+int main(int argc, char** argv, char** envp)
+{
+    try
+    {
+        if (argc < 3)
+        {
+            std::cerr << "Usage: " << argv[0] << " <block_log> <compressed_block_log> [blocks_per_chunk] [samples]"
+                      << std::endl;
+            return 1;
+        }
+
+        fc::path source(argv[1]);
+        fc::path target(argv[2]);
+        uint32_t blocks_per_chunk
+            = argc > 3 ? std::stoul(argv[3]) : scorum::chain::compressed_block_log::default_blocks_per_chunk;
+        uint32_t samples = argc > 4 ? std::stoul(argv[4]) : 10000;
+
+        auto started = fc::time_point::now();
+        uint32_t blocks = scorum::chain::compressed_block_log::convert(source, target, blocks_per_chunk);
+        auto converted = fc::time_point::now();
+
+        uint64_t source_size = files_size(source);
+        uint64_t target_size = files_size(target);
+
+        std::cout << "Converted " << blocks << " blocks in " << (converted - started).count() / 1000000 << " s"
+                  << std::endl;
+        std::cout << "block log: " << source_size << " bytes, compressed block log: " << target_size << " bytes"
+                  << std::endl;
+        std::cout << "compression ratio: " << (target_size ? double(source_size) / target_size : 0) << std::endl;
+
+        if (blocks == 0)
+            return 0;
+
+        std::mt19937 gen(blocks);
+        std::uniform_int_distribution<uint32_t> distribution(1, blocks);
+
+        std::vector<uint32_t> block_nums(samples);
+        for (auto& block_num : block_nums)
+            block_num = distribution(gen);
+
+        scorum::chain::block_log log;
+        log.open(source);
+        print("block log", measure(block_nums, [&](uint32_t block_num) { return log.read_block_by_num(block_num); }));
+
+        scorum::chain::compressed_block_log compressed_log;
+        compressed_log.open(target);
+        print("compressed block log",
+              measure(block_nums, [&](uint32_t block_num) { return compressed_log.read_block_by_num(block_num); }));
+    }
+    catch (const fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        return 1;
+    }
+    catch (const std::exception& e)
+    {
+        edump((std::string(e.what())));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/services/game.hpp>
+#include <scorum/chain/schema/game_object.hpp>
+
+#include "defines.hpp"
+#include "database_default_integration.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+
+namespace {
+using namespace scorum;
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+struct game_service_fixture : public database_fixture::database_default_integration_fixture
+{
+    game_service_fixture()
+        : game_service(db.obtain_service<dbs_game>())
+    {
+    }
+
+    const game_object& create_game(const uuid_type& uuid, fc::time_point_sec start, game_status status)
+    {
+        const auto& game = game_service.create_game(uuid, "{}", start, 0, soccer_game{}, {});
+        game_service.update(game, [&](game_object& g) { g.status = status; });
+        return game;
+    }
+
+    std::vector<uuid_type> get_games_to_start(fc::time_point_sec start)
+    {
+        std::vector<uuid_type> result;
+        for (const game_object& game : game_service.get_games_to_start(start))
+            result.push_back(game.uuid);
+        return result;
+    }
+
+    dbs_game& game_service;
+};
+
+BOOST_FIXTURE_TEST_SUITE(game_service_tests, game_service_fixture)
+
+SCORUM_TEST_CASE(get_games_to_start_returns_only_created_games_with_passed_start_time)
+{
+    const auto now = db.head_block_time();
+
+    create_game(uuid_type{ 1 }, now + 10, game_status::created);
+    create_game(uuid_type{ 2 }, now - 10, game_status::created);
+    create_game(uuid_type{ 3 }, now - 20, game_status::started);
+    create_game(uuid_type{ 4 }, now, game_status::created);
+    create_game(uuid_type{ 5 }, now - 30, game_status::finished);
+    create_game(uuid_type{ 6 }, now - 30, game_status::cancelled);
+
+    BOOST_CHECK(get_games_to_start(now) == std::vector<uuid_type>({ uuid_type{ 2 }, uuid_type{ 4 } }));
+    BOOST_CHECK(get_games_to_start(now - 15).empty());
+    BOOST_CHECK(get_games_to_start(now + 10)
+                == std::vector<uuid_type>({ uuid_type{ 2 }, uuid_type{ 4 }, uuid_type{ 1 } }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
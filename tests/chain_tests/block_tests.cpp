@@ -26,6 +26,10 @@
 #include <scorum/protocol/exceptions.hpp>
 
 #include <scorum/chain/database/database.hpp>
+#include <scorum/chain/block_replay_pipeline.hpp>
+#include <scorum/chain/async_block_stream.hpp>
+#include <scorum/chain/compressed_block_log.hpp>
+#include <scorum/chain/comment_content_store.hpp>
 #include <scorum/chain/schema/scorum_objects.hpp>
 #include <scorum/blockchain_history/schema/operation_objects.hpp>
 #include <scorum/chain/genesis/genesis_state.hpp>
@@ -43,6 +47,9 @@
 
 #include <boost/make_unique.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace {
 
 using namespace scorum::chain;
@@ -143,6 +150,549 @@ BOOST_AUTO_TEST_CASE(generate_empty_blocks)
     }
 }
 
+BOOST_AUTO_TEST_CASE(reindex_through_replay_pipeline)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        signed_block cutoff_block;
+        {
+            database db(database::opt_default);
+            db_setup_and_open(db, data_dir.path());
+
+            while (db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num < 50)
+            {
+                db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                                  database::skip_nothing);
+            }
+
+            cutoff_block = *db.fetch_block_by_number(
+                db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num);
+            db.close();
+        }
+        {
+            block_replay_pipeline pipeline(database::block_log_path(data_dir.path()), cutoff_block.block_num(), 2, 4);
+            pipeline.start();
+
+            uint32_t expected_num = 1;
+            while (auto replayed = pipeline.next())
+            {
+                BOOST_REQUIRE_EQUAL(replayed->block.block_num(), expected_num++);
+                BOOST_CHECK(replayed->block_id == replayed->block.id());
+                BOOST_CHECK(replayed->merkle_root == replayed->block.transaction_merkle_root);
+                BOOST_CHECK_EQUAL(replayed->transaction_ids.size(), replayed->block.transactions.size());
+            }
+            BOOST_CHECK_EQUAL(expected_num, cutoff_block.block_num() + 1);
+
+            for (const auto& stage : pipeline.stats())
+                BOOST_CHECK_EQUAL(stage.items, cutoff_block.block_num());
+        }
+        {
+            database db(database::opt_default);
+            db.reindex(data_dir.path(), data_dir.path(), TEST_SHARED_MEM_SIZE_10MB, db.get_reindex_skip_flags(),
+                       database_integration_fixture::create_default_genesis_state());
+
+            BOOST_CHECK_EQUAL(db.head_block_num(), cutoff_block.block_num());
+            BOOST_CHECK(db.head_block_id() == cutoff_block.id());
+            BOOST_CHECK_NO_THROW(db.validate_invariants());
+        }
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(read_packed_blocks_from_block_log)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        database db(database::opt_default);
+        db_setup_and_open(db, data_dir.path());
+
+        auto last_irreversible_block_num
+            = [&]() { return db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num; };
+
+        while (last_irreversible_block_num() < 20)
+        {
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+        }
+
+        for (uint32_t num = 1; num <= last_irreversible_block_num(); ++num)
+        {
+            auto packed = db.read_packed_block_by_number(num);
+            BOOST_REQUIRE(packed.valid());
+
+            auto block = db.read_block_by_number(num);
+            BOOST_REQUIRE(block.valid());
+
+            auto expected = fc::raw::pack(*block);
+            BOOST_REQUIRE_EQUAL(packed->size(), expected.size());
+            BOOST_CHECK(std::equal(expected.begin(), expected.end(), packed->data()));
+            BOOST_CHECK(packed->header().id() == block->id());
+        }
+
+        BOOST_CHECK(!db.read_packed_block_by_number(0).valid());
+        BOOST_CHECK(!db.read_packed_block_by_number(last_irreversible_block_num() + 1).valid());
+
+        // readers don't use the block log stream, so they can work while blocks are being appended
+        std::atomic<bool> done{ false };
+        std::atomic<uint32_t> readable{ last_irreversible_block_num() };
+        std::atomic<uint32_t> errors{ 0 };
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 2; ++i)
+        {
+            readers.emplace_back([&]() {
+                while (!done)
+                {
+                    for (uint32_t num = 1; num <= readable; ++num)
+                    {
+                        auto packed = db.read_packed_block_by_number(num);
+                        if (!packed.valid() || packed->unpack().block_num() != num)
+                            ++errors;
+                    }
+                }
+            });
+        }
+
+        while (last_irreversible_block_num() < 40)
+        {
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+            readable = last_irreversible_block_num();
+        }
+
+        done = true;
+        for (auto& t : readers)
+            t.join();
+
+        BOOST_CHECK_EQUAL(errors.load(), 0u);
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(convert_block_log_to_compressed_block_log)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        {
+            database db(database::opt_default);
+            db_setup_and_open(db, data_dir.path());
+
+            while (db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num < 30)
+            {
+                db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                                  database::skip_nothing);
+            }
+            db.close();
+        }
+
+        block_log legacy;
+        legacy.open(database::block_log_path(data_dir.path()));
+        uint32_t last_block_num = legacy.head()->block_num();
+
+        auto compressed_file = data_dir.path() / "compressed_block_log";
+        BOOST_REQUIRE_EQUAL(compressed_block_log::convert(database::block_log_path(data_dir.path()), compressed_file, 8),
+                            last_block_num);
+
+        auto check_blocks = [&](const compressed_block_log& log) {
+            BOOST_REQUIRE_EQUAL(log.head_block_num(), last_block_num);
+            for (uint32_t num = last_block_num; num > 0; --num)
+            {
+                auto block = log.read_block_by_num(num);
+                BOOST_REQUIRE(block.valid());
+                BOOST_CHECK(block->id() == legacy.read_block_by_num(num)->id());
+            }
+            BOOST_CHECK(!log.read_block_by_num(0).valid());
+            BOOST_CHECK(!log.read_block_by_num(last_block_num + 1).valid());
+        };
+
+        {
+            compressed_block_log log;
+            log.open(compressed_file);
+            BOOST_CHECK_EQUAL(log.blocks_per_chunk(), 8u);
+            check_blocks(log);
+        }
+
+        // incomplete last chunk is rewritten by each flush and continued after reopening
+        auto appended_file = data_dir.path() / "appended_block_log";
+        {
+            compressed_block_log log;
+            log.open(appended_file, 8);
+            for (uint32_t num = 1; num <= last_block_num / 2 + 3; ++num)
+            {
+                log.append(*legacy.read_block_by_num(num));
+                log.flush();
+            }
+        }
+        {
+            compressed_block_log log;
+            log.open(appended_file);
+            for (uint32_t num = log.head_block_num() + 1; num <= last_block_num; ++num)
+                log.append(*legacy.read_block_by_num(num));
+            check_blocks(log);
+        }
+
+        // the index is reconstructed from the chunk headers
+        fc::remove_all(compressed_block_log::block_log_index_path(compressed_file));
+        {
+            compressed_block_log log;
+            log.open(compressed_file);
+            check_blocks(log);
+        }
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(async_block_stream_delivers_applied_and_popped_blocks)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+
+        database db(database::opt_default);
+        db_setup_and_open(db, data_dir.path());
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        std::vector<std::pair<async_block_notification::event_type, uint32_t>> events;
+        std::thread::id handler_thread;
+
+        // small queue makes block applying wait for the handler
+        async_block_stream stream(db, "test",
+                                  [&](const async_block_notification& note) {
+                                      handler_thread = std::this_thread::get_id();
+                                      events.emplace_back(note.event, note.block_num);
+                                  },
+                                  2);
+
+        for (uint32_t i = 0; i < 5; ++i)
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+
+        db.pop_block();
+
+        stream.wait();
+
+        BOOST_CHECK_EQUAL(stream.lag(), 0u);
+        BOOST_CHECK_EQUAL(stream.last_handled_block_num(), 4u);
+        BOOST_CHECK_EQUAL(db.get_async_streams_lag().at("test"), 0u);
+        BOOST_CHECK(handler_thread != std::this_thread::get_id());
+
+        BOOST_REQUIRE_EQUAL(events.size(), 6u);
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            BOOST_CHECK_EQUAL(events[i].first, async_block_notification::applied_block);
+            BOOST_CHECK_EQUAL(events[i].second, i + 1);
+        }
+        BOOST_CHECK_EQUAL(events[5].first, async_block_notification::popped_block);
+        BOOST_CHECK_EQUAL(events[5].second, 5u);
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(operation_notifications_are_delivered_to_subscribers_of_operation_type)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+
+        database db(database::opt_default);
+        db_setup_and_open(db, data_dir.path());
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        const operation reward_op = producer_reward_operation();
+        const operation transfer_op = transfer_operation();
+
+        BOOST_CHECK(!db.is_operation_observed(reward_op));
+        BOOST_CHECK(!db.is_operation_observed(transfer_op));
+
+        std::vector<int> notified;
+        auto conn = db.post_apply_operation_of<producer_reward_operation>().connect(
+            [&](const operation_notification& note) { notified.push_back(note.op.which()); });
+
+        BOOST_CHECK(db.is_operation_observed(reward_op));
+        BOOST_CHECK(!db.is_operation_observed(transfer_op));
+
+        for (uint32_t i = 0; i < 3; ++i)
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+
+        BOOST_REQUIRE(!notified.empty());
+        for (int which : notified)
+            BOOST_CHECK_EQUAL(which, reward_op.which());
+
+        conn.disconnect();
+
+        BOOST_CHECK(!db.is_operation_observed(reward_op));
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(import_exported_state_snapshot)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        fc::temp_directory imported_shared_mem_dir(graphene::utilities::temp_directory_path());
+        fc::path snapshot_file = data_dir.path() / "state.snapshot";
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        {
+            database db(database::opt_default);
+            db_setup_and_open(db, data_dir.path());
+
+            while (db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num < 50)
+                db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                                  database::skip_nothing);
+
+            // reversible changes must not be exported
+            BOOST_CHECK_THROW(db.export_state_snapshot(snapshot_file), fc::exception);
+
+            db.close();
+        }
+
+        block_id_type head_block_id;
+        uint64_t accounts_count = 0;
+        asset total_supply;
+        {
+            database db(database::opt_default);
+            db_setup_and_open(db, data_dir.path());
+
+            db.export_state_snapshot(snapshot_file);
+
+            head_block_id = db.head_block_id();
+            accounts_count = db.get_index<account_index>().indices().size();
+            total_supply = db.obtain_service<dbs_dynamic_global_property>().get().total_supply;
+
+            db.close();
+        }
+        {
+            auto genesis = database_integration_fixture::create_default_genesis_state();
+
+            database db(database::opt_default);
+            db.import_state_snapshot(snapshot_file, data_dir.path(), imported_shared_mem_dir.path(),
+                                     TEST_SHARED_MEM_SIZE_10MB, genesis);
+
+            BOOST_CHECK(db.head_block_id() == head_block_id);
+            BOOST_CHECK_EQUAL(db.get_index<account_index>().indices().size(), accounts_count);
+            BOOST_CHECK_EQUAL(db.obtain_service<dbs_dynamic_global_property>().get().total_supply, total_supply);
+
+            auto head_block_num = db.head_block_num();
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+            BOOST_CHECK_EQUAL(db.head_block_num(), head_block_num + 1);
+        }
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(comment_content_store_reads_appended_contents_after_reopen)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        const auto file = data_dir.path() / "comment_content";
+
+        comment_content first;
+        first.title = "title";
+        first.body = std::string(1024, 'b');
+
+        comment_content second;
+        second.json_metadata = R"({"tags":["test"]})";
+
+        comment_content_ref first_ref, second_ref;
+        {
+            comment_content_store store;
+            store.open(file);
+
+            BOOST_CHECK_EQUAL(store.append(comment_content()).size, 0u);
+
+            first_ref = store.append(first);
+            second_ref = store.append(second);
+
+            BOOST_CHECK_EQUAL(second_ref.position, first_ref.position + first_ref.size);
+            BOOST_CHECK_EQUAL(store.read(first_ref).body, first.body);
+
+            store.close();
+        }
+
+        comment_content_store store(0);
+        store.open(file, true);
+
+        BOOST_CHECK_EQUAL(store.read(first_ref).title, first.title);
+        BOOST_CHECK_EQUAL(store.read(first_ref).body, first.body);
+        BOOST_CHECK_EQUAL(store.read(second_ref).json_metadata, second.json_metadata);
+        BOOST_CHECK_EQUAL(store.read(comment_content_ref()).body, "");
+
+        auto modified_ref = first_ref;
+        modified_ref.hash = second_ref.hash;
+        BOOST_CHECK_THROW(store.read(modified_ref), fc::exception);
+
+        auto beyond_ref = second_ref;
+        beyond_ref.position += second_ref.size;
+        BOOST_CHECK_THROW(store.read(beyond_ref), fc::exception);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE(comment_content_store_does_not_append_same_content_twice)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+
+        comment_content content;
+        content.title = "title";
+        content.body = "body";
+
+        comment_content other;
+        other.body = "other body";
+
+        comment_content_store store;
+        store.open(data_dir.path() / "comment_content");
+
+        const auto ref = store.append(content);
+        const auto size = store.size();
+
+        const auto same_ref = store.append(content);
+
+        BOOST_CHECK_EQUAL(store.size(), size);
+        BOOST_CHECK_EQUAL(same_ref.position, ref.position);
+        BOOST_CHECK_EQUAL(same_ref.size, ref.size);
+        BOOST_CHECK(same_ref.hash == ref.hash);
+
+        const auto other_ref = store.append(other);
+
+        BOOST_CHECK_EQUAL(other_ref.position, size);
+        BOOST_CHECK_EQUAL(store.size(), size + other_ref.size);
+        BOOST_CHECK_EQUAL(store.read(same_ref).body, content.body);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE(grow_shared_file_between_blocks)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+
+        database db(database::opt_default);
+        db_setup_and_open(db, data_dir.path());
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+        auto generate_block = [&]() {
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+        };
+
+        generate_block();
+        BOOST_REQUIRE_EQUAL(db.grow_count(), 0u);
+
+        const uint64_t grow_step = 1024 * 1024;
+        const auto size = db.get_size();
+
+        // each block finds the file full
+        db.set_shared_file_growth(size * 2, grow_step);
+
+        generate_block();
+        generate_block();
+
+        BOOST_REQUIRE_EQUAL(db.grow_count(), 2u);
+        BOOST_REQUIRE_EQUAL(db.get_size(), size + 2 * grow_step);
+
+        db.set_shared_file_growth(0, grow_step);
+
+        generate_block();
+        db.pop_block();
+        generate_block();
+
+        BOOST_REQUIRE_EQUAL(db.grow_count(), 2u);
+        BOOST_REQUIRE_EQUAL(db.head_block_num(), 4u);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE(import_state_snapshot_exported_after_reopen)
+{
+    try
+    {
+        fc::temp_directory data_dir(graphene::utilities::temp_directory_path());
+        fc::temp_directory imported_shared_mem_dir(graphene::utilities::temp_directory_path());
+        fc::path snapshot_file = data_dir.path() / "state.snapshot";
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+
+        block_id_type head_block_id;
+        {
+            database db(database::opt_default);
+            db_setup_and_open(db, data_dir.path());
+
+            while (db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num < 50)
+                db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                                  database::skip_nothing);
+
+            db.close();
+
+            // the same database is opened again, indices must not be registered twice
+            db_setup_and_open(db, data_dir.path());
+
+            db.export_state_snapshot(snapshot_file);
+
+            head_block_id = db.head_block_id();
+
+            db.close();
+        }
+        {
+            auto genesis = database_integration_fixture::create_default_genesis_state();
+
+            database db(database::opt_default);
+            db.import_state_snapshot(snapshot_file, data_dir.path(), imported_shared_mem_dir.path(),
+                                     TEST_SHARED_MEM_SIZE_10MB, genesis);
+
+            BOOST_CHECK(db.head_block_id() == head_block_id);
+        }
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
 BOOST_AUTO_TEST_CASE(undo_block)
 {
     try
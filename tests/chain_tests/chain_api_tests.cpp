@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <scorum/app/api_context.hpp>
+#include <scorum/app/api_snapshot.hpp>
 
 #include <scorum/app/chain_api.hpp>
 
@@ -216,4 +217,24 @@ SCORUM_TEST_CASE(get_reward_fund_test)
     BOOST_REQUIRE(reward.curation_reward_curve == fund.curation_reward_curve);
 }
 
+SCORUM_TEST_CASE(chain_properties_are_read_from_snapshot_of_last_applied_block)
+{
+    BOOST_REQUIRE(app.get_api_snapshot());
+
+    generate_blocks(3);
+
+    auto props = _api_call.get_chain_properties();
+
+    BOOST_CHECK_EQUAL(props.head_block_number, db.head_block_num());
+    BOOST_CHECK(props.head_block_id == db.head_block_id());
+    BOOST_CHECK(props.time == db.head_block_time());
+
+    db.pop_block();
+
+    props = _api_call.get_chain_properties();
+
+    BOOST_CHECK_EQUAL(props.head_block_number, db.head_block_num());
+    BOOST_CHECK(props.head_block_id == db.head_block_id());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
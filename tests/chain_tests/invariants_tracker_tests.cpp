@@ -0,0 +1,60 @@
+#include <boost/test/unit_test.hpp>
+
+#include "database_blog_integration.hpp"
+
+#include "actor.hpp"
+
+#include <scorum/chain/schema/invariant_totals_object.hpp>
+
+namespace invariants_tracker_tests {
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+struct invariants_tracker_fixture : public database_fixture::database_blog_integration_fixture
+{
+    Actor alice = "alice";
+
+    invariants_tracker_fixture()
+    {
+        open_database();
+
+        actor(initdelegate).create_account(alice);
+    }
+
+    invariant_totals totals() const
+    {
+        return db.get<invariant_totals_object>().totals;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(invariants_tracker_tests, invariants_tracker_fixture)
+
+SCORUM_TEST_CASE(tracked_totals_match_calculated_after_blocks)
+{
+    actor(initdelegate).give_sp(alice, 1e+3);
+    actor(initdelegate).give_scr(alice, 1e+3);
+
+    generate_blocks(5);
+
+    BOOST_REQUIRE_NO_THROW(db.validate_tracked_invariants());
+    // full audit also compares tracked totals with calculated ones
+    BOOST_REQUIRE_NO_THROW(db.validate_invariants());
+}
+
+SCORUM_TEST_CASE(pop_block_reverts_tracked_totals)
+{
+    const auto totals_before = totals();
+
+    actor(initdelegate).give_sp(alice, 1e+3);
+
+    BOOST_CHECK_GT(totals().accounts_sp, totals_before.accounts_sp);
+
+    db.pop_block();
+
+    BOOST_CHECK(totals() == totals_before);
+    BOOST_REQUIRE_NO_THROW(db.validate_invariants());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -466,14 +466,15 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(alice_comment.cashout_time
                       == fc::time_point_sec(db.head_block_time() + fc::seconds(SCORUM_CASHOUT_WINDOW_SECONDS)));
 
+        const auto alice_content = db.obtain_service<dbs_comment>().get_content(alice_comment);
 #ifndef IS_LOW_MEM
-        BOOST_REQUIRE(fc::to_string(alice_comment.title) == op.title);
-        BOOST_REQUIRE(fc::to_string(alice_comment.body) == op.body);
-// BOOST_REQUIRE( alice_comment.json_metadata == op.json_metadata );
+        BOOST_REQUIRE(alice_content.title == op.title);
+        BOOST_REQUIRE(alice_content.body == op.body);
+// BOOST_REQUIRE( alice_content.json_metadata == op.json_metadata );
 #else
-        BOOST_REQUIRE(fc::to_string(alice_comment.title) == "");
-        BOOST_REQUIRE(fc::to_string(alice_comment.body) == "");
-// BOOST_REQUIRE( alice_comment.json_metadata == "" );
+        BOOST_REQUIRE(alice_content.title == "");
+        BOOST_REQUIRE(alice_content.body == "");
+// BOOST_REQUIRE( alice_content.json_metadata == "" );
 #endif
 
         validate_database();
@@ -570,6 +571,12 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(mod_sam_comment.last_update == db.head_block_time());
         BOOST_REQUIRE(mod_sam_comment.created == created);
         BOOST_REQUIRE(mod_sam_comment.cashout_time == mod_sam_comment.created + SCORUM_CASHOUT_WINDOW_SECONDS);
+#ifndef IS_LOW_MEM
+        const auto mod_sam_content = db.obtain_service<dbs_comment>().get_content(mod_sam_comment);
+        BOOST_REQUIRE(mod_sam_content.title == op.title);
+        BOOST_REQUIRE(mod_sam_content.body == op.body);
+        BOOST_REQUIRE(mod_sam_content.json_metadata == op.json_metadata);
+#endif
         validate_database();
 
         BOOST_TEST_MESSAGE("--- Test failure posting withing 1 minute");
@@ -603,6 +610,49 @@ BOOST_AUTO_TEST_CASE(comment_apply)
     FC_LOG_AND_RETHROW()
 }
 
+#ifndef IS_LOW_MEM
+BOOST_AUTO_TEST_CASE(comment_applied_again_does_not_grow_content_store)
+{
+    try
+    {
+        BOOST_TEST_MESSAGE("Testing: comment_applied_again_does_not_grow_content_store");
+
+        ACTORS((alice))
+        generate_blocks(60 / SCORUM_BLOCK_INTERVAL);
+
+        comment_operation op;
+        op.author = "alice";
+        op.permlink = "lorem";
+        op.parent_permlink = "ipsum";
+        op.title = "Lorem Ipsum";
+        op.body = "Lorem ipsum dolor sit amet";
+        op.json_metadata = "{\"foo\":\"bar\"}";
+
+        signed_transaction tx;
+        tx.set_expiration(db.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+        tx.operations.push_back(op);
+        tx.sign(alice_private_key, db.get_chain_id());
+
+        const auto& store = db.get_comment_content_store();
+
+        db.push_transaction(tx, 0);
+
+        const auto store_size = store.size();
+
+        // the pending transaction is applied again in the block and after the block
+        generate_block();
+
+        BOOST_CHECK_EQUAL(store.size(), store_size);
+
+        const auto& comment = db.obtain_service<dbs_comment>().get("alice", std::string("lorem"));
+        BOOST_CHECK_EQUAL(db.obtain_service<dbs_comment>().get_content(comment).body, op.body);
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(comment_operation_category_changed_should_throw)
 {
     BOOST_TEST_MESSAGE("Testing: comment_operation category changing");
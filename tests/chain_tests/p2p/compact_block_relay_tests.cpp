@@ -0,0 +1,303 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/core_messages.hpp>
+#include <graphene/net/node.hpp>
+#include <graphene/utilities/tempdir.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace compact_block_relay_tests {
+
+using namespace graphene::net;
+using scorum::protocol::block_header;
+using scorum::protocol::block_id_type;
+using scorum::protocol::chain_id_type;
+using scorum::protocol::signed_block;
+using scorum::protocol::signed_transaction;
+
+// Chain of the blocks received from the network without validation. Callbacks are made in the test thread.
+class test_node_delegate : public node_delegate
+{
+public:
+    bool has_item(const item_id& id) override
+    {
+        if (id.item_type == block_message_type)
+            return _blocks.count(id.item_hash) > 0;
+
+        return _transactions.count(id.item_hash) > 0;
+    }
+
+    bool handle_block(const block_message& blk_msg,
+                      bool sync_mode,
+                      std::vector<fc::uint160_t>& contained_transaction_message_ids) override
+    {
+        FC_ASSERT(blk_msg.block->previous == get_head_block_id(), "Block doesn't link to the head");
+
+        _chain.push_back(blk_msg.block_id);
+        _blocks[blk_msg.block_id] = message(blk_msg);
+        _blocks[message(blk_msg).id()] = message(blk_msg);
+
+        for (const auto& trx : blk_msg.block->transactions)
+            contained_transaction_message_ids.push_back(message(trx_message(trx)).id());
+
+        return false;
+    }
+
+    void handle_transaction(const trx_message& trx_msg) override
+    {
+        _transactions[trx_msg.trx.id()] = message(trx_msg);
+        _transactions[message(trx_msg).id()] = message(trx_msg);
+    }
+
+    void handle_message(const message& message_to_process) override
+    {
+    }
+
+    std::vector<item_hash_t> get_block_ids(const std::vector<item_hash_t>& blockchain_synopsis,
+                                           uint32_t& remaining_item_count,
+                                           uint32_t limit) override
+    {
+        remaining_item_count = 0;
+
+        // both nodes start from the same empty chain, blocks are relayed during normal operation only
+        return std::vector<item_hash_t>();
+    }
+
+    message get_item(const item_id& id) override
+    {
+        const auto& items = id.item_type == block_message_type ? _blocks : _transactions;
+
+        auto iter = items.find(id.item_hash);
+        if (iter == items.end())
+            FC_THROW_EXCEPTION(fc::key_not_found_exception, "Item ${id} is not found", ("id", id.item_hash));
+
+        return iter->second;
+    }
+
+    chain_id_type get_chain_id() const override
+    {
+        return chain_id_type();
+    }
+
+    std::vector<item_hash_t> get_blockchain_synopsis(const item_hash_t& reference_point,
+                                                     uint32_t number_of_blocks_after_reference_point) override
+    {
+        if (_chain.empty())
+            return std::vector<item_hash_t>();
+
+        return std::vector<item_hash_t>{ _chain.back() };
+    }
+
+    void sync_status(uint32_t item_type, uint32_t item_count) override
+    {
+    }
+
+    void connection_count_changed(uint32_t c) override
+    {
+    }
+
+    uint32_t get_block_number(const item_hash_t& block_id) override
+    {
+        return block_header::num_from_id(block_id);
+    }
+
+    fc::time_point_sec get_block_time(const item_hash_t& block_id) override
+    {
+        if (block_id == item_hash_t())
+            return _genesis_time;
+
+        auto iter = _blocks.find(block_id);
+        if (iter == _blocks.end())
+            return fc::time_point_sec::min();
+
+        return iter->second.as<block_message>().block->timestamp;
+    }
+
+    fc::time_point_sec get_blockchain_now() override
+    {
+        return fc::time_point::now();
+    }
+
+    item_hash_t get_head_block_id() const override
+    {
+        return _chain.empty() ? item_hash_t() : _chain.back();
+    }
+
+    uint32_t estimate_last_known_fork_from_git_revision_timestamp(uint32_t unix_timestamp) const override
+    {
+        return 0;
+    }
+
+    void error_encountered(const std::string& message, const fc::oexception& error) override
+    {
+    }
+
+    bool has_block(const block_id_type& id) const
+    {
+        return _blocks.count(id) > 0;
+    }
+
+    bool has_transaction(const signed_transaction& trx) const
+    {
+        return _transactions.count(trx.id()) > 0;
+    }
+
+    const block_message& get_block(const block_id_type& id) const
+    {
+        return _blocks.at(id).as<block_message>();
+    }
+
+private:
+    fc::time_point_sec _genesis_time = fc::time_point::now();
+
+    std::vector<block_id_type> _chain;
+    std::map<item_hash_t, message> _blocks; /// by block id and by message id
+    std::map<item_hash_t, message> _transactions; /// by transaction id and by message id
+};
+
+struct test_node
+{
+    explicit test_node(const std::string& name)
+        : data_dir(graphene::utilities::temp_directory_path())
+        , node(std::make_shared<graphene::net::node>(name))
+    {
+        node->load_configuration(data_dir.path());
+        node->set_node_delegate(&delegate);
+        node->listen_on_endpoint(fc::ip::endpoint(fc::ip::address("127.0.0.1"), 0), false);
+        node->accept_incoming_connections(true);
+        node->listen_to_p2p_network();
+        node->connect_to_p2p_network();
+        node->sync_from(item_id(block_message_type, item_hash_t()), std::vector<uint32_t>());
+    }
+
+    ~test_node()
+    {
+        node->close();
+    }
+
+    fc::temp_directory data_dir;
+    test_node_delegate delegate;
+    std::shared_ptr<graphene::net::node> node;
+};
+
+template <typename Condition> bool wait_for(Condition condition, fc::microseconds timeout = fc::seconds(10))
+{
+    const auto deadline = fc::time_point::now() + timeout;
+    while (!condition())
+    {
+        if (fc::time_point::now() > deadline)
+            return false;
+
+        // the nodes call the delegates in this thread
+        fc::usleep(fc::milliseconds(10));
+    }
+    return true;
+}
+
+// items advertised before the peers finish the initial sync aren't fetched, so they are broadcast until they arrive
+template <typename Condition> bool broadcast_until(test_node& from, const message& item, Condition condition)
+{
+    for (int attempt = 0; attempt < 10; ++attempt)
+    {
+        from.node->broadcast(item);
+
+        if (wait_for(condition, fc::seconds(1)))
+            return true;
+    }
+    return false;
+}
+
+signed_transaction make_transaction(uint16_t ref_block_num)
+{
+    signed_transaction trx;
+    trx.ref_block_num = ref_block_num;
+    trx.set_expiration(fc::time_point::now() + fc::minutes(1));
+    return trx;
+}
+
+signed_block make_block(const block_id_type& previous, std::vector<signed_transaction> transactions)
+{
+    signed_block block;
+    block.previous = previous;
+    block.timestamp = fc::time_point::now();
+    block.witness = "initdelegate";
+    block.transactions = std::move(transactions);
+    block.transaction_merkle_root = block.calculate_merkle_root();
+    return block;
+}
+
+struct compact_block_relay_fixture
+{
+    compact_block_relay_fixture()
+        : producer("producer")
+        , receiver("receiver")
+    {
+        receiver.node->connect_to_endpoint(producer.node->get_actual_listening_endpoint());
+
+        BOOST_REQUIRE(wait_for([&]() {
+            return producer.node->get_connection_count() == 1 && receiver.node->get_connection_count() == 1;
+        }));
+    }
+
+    test_node producer;
+    test_node receiver;
+};
+
+BOOST_FIXTURE_TEST_SUITE(compact_block_relay_tests, compact_block_relay_fixture)
+
+BOOST_AUTO_TEST_CASE(block_is_restored_from_the_transactions_the_peer_has_seen)
+{
+    try
+    {
+        auto trx = make_transaction(1);
+
+        BOOST_REQUIRE(
+            broadcast_until(producer, trx_message(trx), [&]() { return receiver.delegate.has_transaction(trx); }));
+
+        block_message block(make_block(block_id_type(), { trx }));
+
+        BOOST_REQUIRE(broadcast_until(producer, block, [&]() { return receiver.delegate.has_block(block.block_id); }));
+
+        const auto& received = receiver.delegate.get_block(block.block_id);
+        BOOST_REQUIRE_EQUAL(received.block->transactions.size(), 1u);
+        BOOST_CHECK(received.block->transactions[0].id() == trx.id());
+        BOOST_CHECK(message(received).id() == message(block).id());
+
+        // the peer isn't disconnected for the compact block
+        BOOST_CHECK_EQUAL(receiver.node->get_connection_count(), 1u);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE(missing_transactions_of_the_block_are_fetched_from_the_peer)
+{
+    try
+    {
+        auto seen_trx = make_transaction(1);
+        auto unseen_trx = make_transaction(2);
+
+        BOOST_REQUIRE(broadcast_until(producer, trx_message(seen_trx),
+                                      [&]() { return receiver.delegate.has_transaction(seen_trx); }));
+
+        block_message block(make_block(block_id_type(), { unseen_trx, seen_trx }));
+
+        BOOST_REQUIRE(broadcast_until(producer, block, [&]() { return receiver.delegate.has_block(block.block_id); }));
+
+        const auto& received = receiver.delegate.get_block(block.block_id);
+        BOOST_REQUIRE_EQUAL(received.block->transactions.size(), 2u);
+        BOOST_CHECK(received.block->transactions[0].id() == unseen_trx.id());
+        BOOST_CHECK(received.block->transactions[1].id() == seen_trx.id());
+        BOOST_CHECK(message(received).id() == message(block).id());
+
+        BOOST_CHECK_EQUAL(receiver.node->get_connection_count(), 1u);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -18,6 +18,8 @@
 #include <scorum/protocol/operations.hpp>
 #include <scorum/common_api/config_api.hpp>
 
+#include <graphene/utilities/tempdir.hpp>
+
 #include "database_trx_integration.hpp"
 #include "devcommittee_fixture.hpp"
 #include "operation_check.hpp"
@@ -1633,5 +1635,171 @@ BOOST_FIXTURE_TEST_CASE(get_first_and_last_operation, two_operations_fixture)
     FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+
+struct operation_store_history_fixture : public database_fixture::database_trx_integration_fixture
+{
+    operation_store_history_fixture()
+        : alice("alice")
+        , bob("bob")
+        , store_dir(graphene::utilities::temp_directory_path())
+        , _blockchain_history_api_ctx(app, API_BLOCKCHAIN_HISTORY, std::make_shared<api_session_data>())
+        , _account_history_api_ctx(app, API_ACCOUNT_HISTORY, std::make_shared<api_session_data>())
+        , blockchain_history_api_call(_blockchain_history_api_ctx)
+        , account_history_api_call(_account_history_api_ctx)
+    {
+        namespace bpo = boost::program_options;
+
+        bpo::variables_map options;
+        options.insert(std::make_pair("history-operation-store-dir",
+                                      bpo::variable_value(boost::filesystem::path(store_dir.path().string()), false)));
+
+        auto plugin = app.register_plugin<scorum::blockchain_history::blockchain_history_plugin>();
+        app.enable_plugin(plugin->plugin_name());
+        plugin->plugin_initialize(options);
+        plugin->plugin_startup();
+
+        open_database();
+        generate_block();
+        validate_database();
+
+        actor(initdelegate).create_account(alice);
+        actor(initdelegate).give_scr(alice, feed_amount);
+
+        actor(initdelegate).create_account(bob);
+    }
+
+    uint32_t last_irreversible_block_num()
+    {
+        return db.obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num;
+    }
+
+    void generate_irreversible_block(uint32_t block_num)
+    {
+        for (uint32_t ci = 0; ci < SCORUM_MAX_WITNESSES * 2 && last_irreversible_block_num() < block_num; ++ci)
+            generate_block();
+
+        BOOST_REQUIRE_GE(last_irreversible_block_num(), block_num);
+    }
+
+    const int feed_amount = 99000;
+
+    Actor alice;
+    Actor bob;
+
+    fc::temp_directory store_dir;
+
+    api_context _blockchain_history_api_ctx;
+    api_context _account_history_api_ctx;
+    blockchain_history::blockchain_history_api blockchain_history_api_call;
+    blockchain_history::account_history_api account_history_api_call;
+};
+
+BOOST_FIXTURE_TEST_SUITE(operation_store_history_tests, operation_store_history_fixture)
+
+SCORUM_TEST_CASE(irreversible_operations_are_moved_out_of_shared_memory)
+{
+    transfer_operation op;
+    op.from = alice.name;
+    op.to = bob.name;
+    op.amount = ASSET_SCR(feed_amount / 10);
+    push_operation(op, alice.private_key);
+
+    const uint32_t block_num = db.head_block_num();
+
+    generate_irreversible_block(block_num);
+
+    const auto& idx = db.get_index<blockchain_history::operation_index, blockchain_history::by_location>();
+    BOOST_CHECK(idx.equal_range(block_num).first == idx.equal_range(block_num).second);
+    BOOST_CHECK(idx.begin() == idx.end() || idx.begin()->block > last_irreversible_block_num());
+}
+
+SCORUM_TEST_CASE(stored_operations_are_returned_by_apis)
+{
+    transfer_operation op;
+    op.from = alice.name;
+    op.to = bob.name;
+    op.amount = ASSET_SCR(feed_amount / 10);
+    push_operation(op, alice.private_key);
+
+    const uint32_t block_num = db.head_block_num();
+
+    generate_irreversible_block(block_num);
+
+    auto ops
+        = blockchain_history_api_call.get_ops_in_block(block_num, blockchain_history::applied_operation_type::not_virt);
+    BOOST_REQUIRE_EQUAL(ops.size(), 1u);
+    ops.begin()->second.op.visit(check_opetation_visitor(op));
+
+    auto history = account_history_api_call.get_account_scr_to_scr_transfers(alice, -1, 100);
+    BOOST_REQUIRE_EQUAL(history.size(), 1u);
+    history.begin()->second.op.visit(check_opetation_visitor(op));
+
+    auto all_ops
+        = blockchain_history_api_call.get_ops_history(-1, 100, blockchain_history::applied_operation_type::all);
+    BOOST_CHECK(all_ops.count(ops.begin()->first));
+
+    auto trx = blockchain_history_api_call.get_transaction(ops.begin()->second.trx_id);
+    BOOST_CHECK_EQUAL(trx.block_num, block_num);
+    BOOST_REQUIRE_EQUAL(trx.operations.size(), 1u);
+}
+
+SCORUM_TEST_CASE(stored_operations_are_kept_after_reopening)
+{
+    transfer_operation op;
+    op.from = alice.name;
+    op.to = bob.name;
+    op.amount = ASSET_SCR(feed_amount / 10);
+    push_operation(op, alice.private_key);
+
+    const uint32_t block_num = db.head_block_num();
+
+    generate_irreversible_block(block_num);
+
+    // the last blocks are undone at the opening, the last irreversible block of the restored state is behind the
+    // stored operations
+    db.close();
+    db.open(data_dir->path(), data_dir->path(), TEST_SHARED_MEM_SIZE_10MB, chainbase::database::read_write,
+            genesis_state);
+
+    transfer_operation next_op;
+    next_op.from = alice.name;
+    next_op.to = bob.name;
+    next_op.amount = ASSET_SCR(feed_amount / 20);
+    push_operation(next_op, alice.private_key);
+
+    const uint32_t next_block_num = db.head_block_num();
+
+    generate_irreversible_block(next_block_num);
+
+    auto ops
+        = blockchain_history_api_call.get_ops_in_block(block_num, blockchain_history::applied_operation_type::not_virt);
+    BOOST_REQUIRE_EQUAL(ops.size(), 1u);
+    ops.begin()->second.op.visit(check_opetation_visitor(op));
+
+    auto next_ops = blockchain_history_api_call.get_ops_in_block(next_block_num,
+                                                                 blockchain_history::applied_operation_type::not_virt);
+    BOOST_REQUIRE_EQUAL(next_ops.size(), 1u);
+    next_ops.begin()->second.op.visit(check_opetation_visitor(next_op));
+
+    auto history = account_history_api_call.get_account_scr_to_scr_transfers(alice, -1, 100);
+    BOOST_CHECK_EQUAL(history.size(), 2u);
+}
+
+SCORUM_TEST_CASE(reversible_operations_are_kept_in_shared_memory)
+{
+    generate_irreversible_block(db.head_block_num());
+
+    transfer_operation op;
+    op.from = alice.name;
+    op.to = bob.name;
+    op.amount = ASSET_SCR(feed_amount / 10);
+    push_operation(op, alice.private_key, false);
+
+    const auto& idx = db.get_index<blockchain_history::operation_index, blockchain_history::by_id>();
+    BOOST_REQUIRE(idx.rbegin() != idx.rend());
+    BOOST_CHECK_GT(idx.rbegin()->block, last_irreversible_block_num());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace blockchain_history_tests
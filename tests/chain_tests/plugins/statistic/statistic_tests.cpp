@@ -251,6 +251,31 @@ SCORUM_TEST_CASE(transfers_stat_test)
     BOOST_REQUIRE_EQUAL(bucket.scorum_transferred, orig_val_scr + 1);
 }
 
+SCORUM_TEST_CASE(block_operations_are_added_to_bucket_with_block_test)
+{
+    const bucket_object& bucket = get_lifetime_bucket();
+
+    auto orig_val = bucket.transfers;
+    auto orig_val_scr = bucket.scorum_transferred;
+
+    transfer_operation op;
+    op.from = TEST_INIT_DELEGATE_NAME;
+    op.to = alice;
+    op.amount = asset(1, SCORUM_SYMBOL);
+
+    push_operation(op, fc::ecc::private_key(), false);
+
+    op.amount = asset(2, SCORUM_SYMBOL);
+    push_operation(op, fc::ecc::private_key(), false);
+
+    BOOST_REQUIRE_EQUAL(bucket.transfers, orig_val);
+
+    generate_block();
+
+    BOOST_REQUIRE_EQUAL(bucket.transfers, orig_val + 2);
+    BOOST_REQUIRE_EQUAL(bucket.scorum_transferred, orig_val_scr + 3);
+}
+
 SCORUM_TEST_CASE(transfers_to_scorumpower_stat_test)
 {
     const bucket_object& bucket = get_lifetime_bucket();
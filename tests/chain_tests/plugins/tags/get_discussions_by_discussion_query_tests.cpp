@@ -435,6 +435,36 @@ SCORUM_TEST_CASE(should_return_two_posts_from_same_block_ordered_by_id_desc)
     BOOST_REQUIRE_EQUAL(discussions[1].permlink, p1.permlink());
 }
 
+SCORUM_TEST_CASE(check_union_pagination_returns_post_with_several_tags_once)
+{
+    auto p1
+        = create_post(alice).set_json(R"({"domains": ["com"], "categories": ["cat"], "tags":["A","B"]})").in_block();
+    auto p2 = create_post(bob).set_json(R"({"domains": ["com"], "categories": ["cat"], "tags":["B"]})").in_block();
+    auto p3 = create_post(sam).set_json(R"({"domains": ["com"], "categories": ["cat"], "tags":["A","B"]})").in_block();
+
+    discussion_query q;
+    q.limit = 2;
+    q.tags_logical_and = false;
+    q.tags = { "A", "B" };
+    {
+        std::vector<discussion> discussions = _api.get_discussions_by_created(q);
+
+        BOOST_REQUIRE_EQUAL(discussions.size(), 2u);
+        BOOST_REQUIRE_EQUAL(discussions[0].permlink, p3.permlink());
+        BOOST_REQUIRE_EQUAL(discussions[1].permlink, p2.permlink());
+
+        q.start_author = discussions[1].author;
+        q.start_permlink = discussions[1].permlink;
+    }
+    {
+        std::vector<discussion> discussions = _api.get_discussions_by_created(q);
+
+        BOOST_REQUIRE_EQUAL(discussions.size(), 2u);
+        BOOST_REQUIRE_EQUAL(discussions[0].permlink, p2.permlink());
+        BOOST_REQUIRE_EQUAL(discussions[1].permlink, p1.permlink());
+    }
+}
+
 SCORUM_TEST_CASE(check_tag_should_be_truncated_to_24symbols)
 {
     auto json
@@ -0,0 +1,204 @@
+#ifndef IS_LOW_MEM
+
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/services/comment.hpp>
+
+#include "tags_common.hpp"
+
+#include <map>
+#include <vector>
+
+using namespace scorum::tags;
+
+namespace database_fixture {
+
+struct tag_scores_fixture : public tags_fixture
+{
+    tag_scores_fixture()
+    {
+        actor(initdelegate).give_sp(alice, 1e9);
+        actor(initdelegate).give_sp(bob, 1e9);
+        actor(initdelegate).give_sp(sam, 1e9);
+        actor(initdelegate).give_sp(dave, 1e9);
+    }
+
+    comment_id_type get_comment_id(const comment_op& c)
+    {
+        return db.obtain_service<dbs_comment>().get(c.author(), c.permlink()).id;
+    }
+
+    /// @returns posts of the tag in the order of the index
+    template <typename Index> std::vector<comment_id_type> get_posts_order(const std::string& tag)
+    {
+        const auto& idx = db.get_index<tag_index, Index>();
+
+        std::vector<comment_id_type> result;
+        for (const auto& t : boost::make_iterator_range(idx.equal_range(boost::make_tuple(tag_name_type(tag)))))
+            result.push_back(t.comment);
+
+        return result;
+    }
+
+    const tag_stats_object* find_stats(const std::string& tag)
+    {
+        const auto& idx = db.get_index<tag_stats_index, by_tag>();
+        auto it = idx.find(tag_name_type(tag));
+        return it != idx.end() ? &*it : nullptr;
+    }
+
+    /// compares the stats with the ones counted over all tag objects
+    void check_stats_match_recount()
+    {
+        struct recount
+        {
+            uint32_t posts = 0;
+            fc::uint128 total_trending = 0;
+            int32_t net_votes = 0;
+        };
+
+        std::map<std::string, recount> expected;
+        for (const tag_object& t : db.get_index<tag_index, by_comment>())
+        {
+            auto& r = expected[t.tag];
+            ++r.posts;
+            r.total_trending += static_cast<uint32_t>(t.trending / TAG_SCORE_PRECISION);
+            r.net_votes += t.net_votes;
+        }
+
+        for (const tag_stats_object& stats : db.get_index<tag_stats_index, by_tag>())
+        {
+            const auto it = expected.find(stats.tag);
+            const recount r = it != expected.end() ? it->second : recount();
+
+            BOOST_TEST_MESSAGE("tag '" << std::string(stats.tag) << "'");
+            BOOST_CHECK_EQUAL(stats.posts, r.posts);
+            BOOST_CHECK(stats.total_trending == r.total_trending);
+            BOOST_CHECK_EQUAL(stats.net_votes, r.net_votes);
+        }
+
+        for (const auto& item : expected)
+            BOOST_CHECK(find_stats(item.first) != nullptr);
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(tag_scores_tests, database_fixture::tag_scores_fixture)
+
+SCORUM_TEST_CASE(posts_are_ordered_by_hot_and_trending_after_votes)
+{
+    // the posts are created at the same time, so only the votes make the difference
+    auto alice_post = create_post(alice).set_json(R"({"tags":["X"]})").push();
+    auto bob_post = create_post(bob).set_json(R"({"tags":["X"]})").push();
+    auto sam_post = create_post(sam).set_json(R"({"tags":["X"]})").push();
+    generate_block();
+
+    bob_post.vote(alice).in_block();
+    bob_post.vote(bob).in_block();
+    bob_post.vote(sam).in_block();
+    alice_post.vote(dave).in_block();
+
+    {
+        const std::vector<comment_id_type> expected
+            = { get_comment_id(bob_post), get_comment_id(alice_post), get_comment_id(sam_post) };
+
+        BOOST_CHECK(get_posts_order<by_tag_trending>("x") == expected);
+        BOOST_CHECK(get_posts_order<by_tag_hot>("x") == expected);
+    }
+
+    alice_post.vote(alice).in_block();
+    alice_post.vote(bob).in_block();
+    alice_post.vote(sam).in_block();
+
+    {
+        const std::vector<comment_id_type> expected
+            = { get_comment_id(alice_post), get_comment_id(bob_post), get_comment_id(sam_post) };
+
+        BOOST_CHECK(get_posts_order<by_tag_trending>("x") == expected);
+        BOOST_CHECK(get_posts_order<by_tag_hot>("x") == expected);
+    }
+}
+
+SCORUM_TEST_CASE(newer_post_is_hotter_without_votes)
+{
+    auto old_post = create_post(alice).set_json(R"({"tags":["X"]})").in_block();
+    auto new_post = create_post(bob).set_json(R"({"tags":["X"]})").in_block();
+
+    const std::vector<comment_id_type> expected = { get_comment_id(new_post), get_comment_id(old_post) };
+
+    BOOST_CHECK(get_posts_order<by_tag_hot>("x") == expected);
+    BOOST_CHECK(get_posts_order<by_tag_trending>("x") == expected);
+}
+
+SCORUM_TEST_CASE(stats_match_recount_after_votes_edits_and_tag_removal)
+{
+    auto alice_post = create_post(alice).set_json(R"({"tags":["A","B"]})").in_block();
+    auto bob_post = create_post(bob).set_json(R"({"tags":["B","C"]})").in_block();
+    auto sam_post = create_post(sam).set_json(R"({"tags":["C"]})").in_block();
+
+    check_stats_match_recount();
+
+    alice_post.vote(sam).in_block();
+    alice_post.vote(dave).in_block();
+    bob_post.vote(alice, -SCORUM_PERCENT(100)).in_block();
+
+    check_stats_match_recount();
+    BOOST_REQUIRE(find_stats("a") != nullptr);
+    BOOST_CHECK_EQUAL(find_stats("a")->net_votes, 2);
+    BOOST_CHECK_EQUAL(find_stats("b")->net_votes, 1);
+
+    // 'a' is removed, 'd' is added
+    alice_post.set_json(R"({"tags":["B","D"]})").push();
+    generate_block();
+
+    check_stats_match_recount();
+    BOOST_CHECK_EQUAL(find_stats("a")->posts, 0u);
+    BOOST_CHECK_EQUAL(find_stats("a")->net_votes, 0);
+    BOOST_REQUIRE(find_stats("d") != nullptr);
+    BOOST_CHECK_EQUAL(find_stats("d")->posts, 1u);
+    BOOST_CHECK_EQUAL(find_stats("d")->net_votes, 2);
+
+    alice_post.vote(bob).in_block();
+
+    check_stats_match_recount();
+
+    sam_post.remove();
+
+    check_stats_match_recount();
+    BOOST_CHECK_EQUAL(find_stats("c")->posts, 1u);
+}
+
+SCORUM_TEST_CASE(payout_is_added_to_stats_of_tags_of_last_edit)
+{
+    auto start = db.head_block_time() + 1; // start_time should be greater than head_block_time
+    auto deadline = db.head_block_time() + fc::minutes(1);
+    actor(initdelegate).create_budget(R"j({"tag": 1})j", asset::from_string("5.000000000 SCR"), start, deadline);
+
+    auto post = create_post(alice).set_json(R"({"tags":["A","B"]})").in_block();
+
+    post.vote(bob).in_block();
+    post.vote(sam).in_block();
+
+    // the payout is counted by the tag objects of the post, 'b' is not among them anymore
+    post.set_json(R"({"tags":["A","C"]})").push();
+    generate_block();
+
+    generate_blocks(post.cashout_time());
+
+    auto total_payout = [&](const std::string& tag) {
+        const auto* stats = find_stats(tag);
+        BOOST_REQUIRE(stats != nullptr);
+        return stats->total_payout_scr.amount + stats->total_payout_sp.amount;
+    };
+
+    BOOST_CHECK_GT(total_payout("a").value, 0);
+    BOOST_CHECK_EQUAL(total_payout("c").value, total_payout("a").value);
+    BOOST_CHECK_EQUAL(total_payout("").value, total_payout("a").value);
+    BOOST_CHECK_EQUAL(total_payout("b").value, 0);
+
+    check_stats_match_recount();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
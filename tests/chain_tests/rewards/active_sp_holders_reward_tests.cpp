@@ -19,8 +19,9 @@ using namespace database_fixture;
 class active_sp_holders_reward_fixture : public database_blog_integration_fixture
 {
 public:
-    active_sp_holders_reward_fixture()
-        : budget_service(db.fund_budget_service())
+    explicit active_sp_holders_reward_fixture(uint32_t hardfork)
+        : _hardfork(hardfork)
+        , budget_service(db.fund_budget_service())
         , account_service(db.account_service())
         , dprops_service(db.obtain_service<dbs_dynamic_global_property>())
         , voters_reward_sp_service(db.obtain_service<dbs_voters_reward_sp>())
@@ -48,7 +49,7 @@ public:
     {
         database_integration_fixture::open_database_impl(genesis);
 
-        db.set_hardfork(SCORUM_NUM_HARDFORKS);
+        db.set_hardfork(_hardfork);
     }
 
     inline asset get_active_voters_reward(const asset& total)
@@ -56,6 +57,259 @@ public:
         return total * SCORUM_ACTIVE_SP_HOLDERS_PER_BLOCK_REWARD_PERCENT / SCORUM_100_PERCENT;
     }
 
+    bool is_accumulator_enabled() const
+    {
+        return dprops_service.get().active_sp_holders_reward.enabled;
+    }
+
+    // Accumulator rounds reward per share down every block and accrued reward down on every settlement,
+    // so it may pay a unit less per block and per settlement than per block distribution.
+    asset rounding_tolerance(uint32_t blocks, uint32_t settlements = 1) const
+    {
+        if (!is_accumulator_enabled())
+            return asset(0, SP_SYMBOL);
+
+        return asset(blocks + settlements, SP_SYMBOL);
+    }
+
+    void check_reward(const asset& actual, const asset& expected, uint32_t blocks)
+    {
+        BOOST_REQUIRE_LE(actual, expected);
+        BOOST_REQUIRE_GE(actual + rounding_tolerance(blocks), expected);
+    }
+
+    struct voting_history_rewards
+    {
+        asset alice = asset(0, SP_SYMBOL);
+        asset bob = asset(0, SP_SYMBOL);
+        uint32_t blocks = 0;
+    };
+
+    // Alice and Bob vote a few times and their rewards are cashed out
+    voting_history_rewards reward_voting_history()
+    {
+        asset alice_sp_before = account_service.get_account(alice.name).scorumpower;
+        asset bob_sp_before = account_service.get_account(bob.name).scorumpower;
+
+        auto start = db.head_block_time();
+        auto initial_blocks = db.head_block_num();
+
+        auto post = create_post(alice).push();
+        post.vote(bob).push();
+        post.vote(alice, SCORUM_PERCENT(50)).in_block();
+
+        generate_blocks(5);
+
+        auto other_post = create_post(bob).push();
+        other_post.vote(alice).in_block();
+
+        generate_blocks(2);
+
+        other_post.vote(bob, SCORUM_PERCENT(30)).in_block();
+
+        generate_blocks(start + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        voting_history_rewards rewards;
+        rewards.alice = account_service.get_account(alice.name).scorumpower - alice_sp_before;
+        rewards.bob = account_service.get_account(bob.name).scorumpower - bob_sp_before;
+        rewards.blocks = db.head_block_num() - initial_blocks;
+
+        return rewards;
+    }
+
+    void check_per_block_sp_payment_from_fund_budget()
+    {
+        asset bob_sp_before = account_service.get_account(bob.name).scorumpower;
+
+        auto post = create_post(alice).push();
+        post.vote(bob).in_block();
+
+        auto initial_blocks = db.head_block_num();
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+        auto pass_blocks = db.head_block_num() - initial_blocks;
+
+        auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+        active_sp_holders_reward *= pass_blocks;
+
+        check_reward(account_service.get_account(bob.name).scorumpower - bob_sp_before, active_sp_holders_reward,
+                     pass_blocks);
+    }
+
+    void check_per_block_sp_payment_from_fund_budget_if_no_active_voters_exist()
+    {
+        generate_block();
+
+        auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+
+        auto& balancer = voters_reward_sp_service.get();
+
+        BOOST_REQUIRE_EQUAL(balancer.balance, active_sp_holders_reward);
+    }
+
+    void check_per_block_sp_payment_division_from_fund_budget()
+    {
+        asset alice_sp_before = account_service.get_account(alice.name).scorumpower;
+        asset bob_sp_before = account_service.get_account(bob.name).scorumpower;
+
+        auto post = create_post(alice).push();
+        post.vote(bob).push();
+        post.vote(alice).in_block();
+
+        auto initial_blocks = db.head_block_num();
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+        auto pass_blocks = db.head_block_num() - initial_blocks;
+
+        auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+        active_sp_holders_reward *= pass_blocks;
+
+        auto alice_reward = active_sp_holders_reward * alice.sp_percent / 100;
+        auto bob_reward = active_sp_holders_reward - alice_reward;
+
+        check_reward(account_service.get_account(alice.name).scorumpower - alice_sp_before, alice_reward,
+                     pass_blocks);
+
+        check_reward(account_service.get_account(bob.name).scorumpower - bob_sp_before, bob_reward, pass_blocks);
+    }
+
+    void check_per_block_payments_are_stopped_after_battary_restored()
+    {
+        const auto& voter = account_service.get_account(bob.name);
+        asset bob_sp_before = voter.scorumpower;
+
+        const auto vote_weight = SCORUM_PERCENT(100);
+
+        uint16_t current_power = scorum::rewards_math::calculate_restoring_power(
+            voter.voting_power, dprops_service.head_block_time(), voter.last_vote_time,
+            SCORUM_VOTE_REGENERATION_SECONDS);
+
+        uint16_t used_power
+            = scorum::rewards_math::calculate_used_power(current_power, vote_weight, SCORUM_VOTING_POWER_DECAY_PERCENT);
+
+        auto voting_power_restoring_time = scorum::rewards_math::calculate_expected_restoring_time(
+            current_power - used_power, dprops_service.head_block_time(), SCORUM_VOTE_REGENERATION_SECONDS);
+
+        auto post = create_post(alice).push();
+        post.vote(bob, vote_weight).in_block();
+
+        auto initial_blocks = db.head_block_num();
+        generate_blocks(voting_power_restoring_time + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+        auto pass_blocks = db.head_block_num() - initial_blocks;
+
+        auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+
+        check_reward(voter.scorumpower - bob_sp_before, active_sp_holders_reward * pass_blocks, pass_blocks);
+
+        initial_blocks = db.head_block_num();
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+        pass_blocks = db.head_block_num() - initial_blocks;
+
+        check_reward(voter.scorumpower - bob_sp_before, active_sp_holders_reward * pass_blocks, pass_blocks);
+
+        auto& balancer = voters_reward_sp_service.get();
+
+        pass_blocks += 1; // in_block
+
+        // rounding remainder of the accumulator is returned to the fund
+        BOOST_REQUIRE_GE(balancer.balance, active_sp_holders_reward * pass_blocks);
+        BOOST_REQUIRE_LE(balancer.balance, active_sp_holders_reward * pass_blocks + rounding_tolerance(pass_blocks));
+    }
+
+    void check_payments_from_sp_balancer_arter_fund_budget_is_over()
+    {
+        const auto fund_budget_period_in_blocks = 2;
+
+        auto& fund_budget = budget_service.get();
+
+        budget_service.update(fund_budget, [&](fund_budget_object& b) {
+            b.per_block = b.balance / fund_budget_period_in_blocks;
+            b.deadline = dprops_service.head_block_time() + fund_budget_period_in_blocks * SCORUM_BLOCK_INTERVAL;
+        });
+
+        generate_blocks(fund_budget_period_in_blocks);
+
+        BOOST_REQUIRE(!budget_service.is_exists());
+
+        const auto& voter = account_service.get_account(bob.name);
+        asset bob_sp_before = voter.scorumpower;
+
+        auto post = create_post(alice).push();
+        post.vote(bob).in_block();
+
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        auto& balancer = voters_reward_sp_service.get();
+
+        BOOST_REQUIRE(balancer.current_per_block_reward.amount != 0);
+
+        BOOST_REQUIRE_GT(voter.scorumpower, bob_sp_before);
+    }
+
+    void check_active_sp_holders_op_notifications()
+    {
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        set_voter(bob);
+
+        auto post = create_post(alice).push();
+        post.vote(bob, SCORUM_PERCENT(30)).in_block();
+
+        BOOST_CHECK_EQUAL(op_times(), 0);
+
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        BOOST_CHECK_EQUAL(op_times(), 1);
+
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        BOOST_CHECK_EQUAL(op_times(), 1);
+
+        post.vote(bob, SCORUM_PERCENT(90)).in_block();
+
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        BOOST_CHECK_EQUAL(op_times(), 2);
+    }
+
+    void check_second_cashout_if_no_vote_after_first_cashout()
+    {
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        set_voter(bob);
+
+        auto start = db.head_block_time();
+
+        auto post = create_post(alice).push();
+        post.vote(bob).in_block();
+
+        generate_blocks(start
+                        + fc::seconds(SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD.to_seconds() - SCORUM_BLOCK_INTERVAL * 2));
+
+        post = create_post(bob).push();
+        post.vote(bob).in_block();
+
+        BOOST_CHECK_EQUAL(op_times(), 0);
+
+        generate_blocks(start + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        const auto& bob_obj = account_service.get_account(bob.name);
+        BOOST_REQUIRE_GT(bob_obj.voting_power_restoring_time.to_iso_string(), db.head_block_time().to_iso_string());
+        BOOST_REQUIRE_LT(bob_obj.voting_power, SCORUM_100_PERCENT);
+
+        BOOST_CHECK_NE(bob_obj.active_sp_holders_cashout_time.to_iso_string(),
+                       fc::time_point_sec::maximum().to_iso_string());
+
+        BOOST_CHECK_EQUAL(op_times(), 1);
+
+        generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+
+        BOOST_CHECK_EQUAL(bob_obj.active_sp_holders_cashout_time.to_iso_string(),
+                          fc::time_point_sec::maximum().to_iso_string());
+
+        BOOST_CHECK_EQUAL(op_times(), 2);
+    }
+
+    uint32_t _hardfork;
+
     fund_budget_service_i& budget_service;
     account_service_i& account_service;
     dynamic_global_property_service_i& dprops_service;
@@ -91,195 +345,266 @@ private:
     int _op_times = 0;
 };
 
+struct active_sp_holders_reward_hardfork_0_7_fixture : public active_sp_holders_reward_fixture
+{
+    active_sp_holders_reward_hardfork_0_7_fixture()
+        : active_sp_holders_reward_fixture(SCORUM_HARDFORK_0_7)
+    {
+    }
+};
+
+struct active_sp_holders_reward_hardfork_0_8_fixture : public active_sp_holders_reward_fixture
+{
+    active_sp_holders_reward_hardfork_0_8_fixture()
+        : active_sp_holders_reward_fixture(SCORUM_HARDFORK_0_8)
+    {
+    }
+};
+
 using namespace scorum::chain;
 using namespace scorum::protocol;
 
-BOOST_FIXTURE_TEST_SUITE(active_sp_holders_reward_tests, active_sp_holders_reward_fixture)
+// per block distribution to every active SP holder
+BOOST_FIXTURE_TEST_SUITE(active_sp_holders_reward_tests, active_sp_holders_reward_hardfork_0_7_fixture)
 
 SCORUM_TEST_CASE(per_block_sp_payment_from_fund_budget)
 {
-    asset bob_sp_before = account_service.get_account(bob.name).scorumpower;
-
-    auto post = create_post(alice).push();
-    post.vote(bob).in_block();
-
-    auto initial_blocks = db.head_block_num();
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
-    auto pass_blocks = db.head_block_num() - initial_blocks;
-
-    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
-    active_sp_holders_reward *= pass_blocks;
-
-    BOOST_REQUIRE_EQUAL(account_service.get_account(bob.name).scorumpower, bob_sp_before + active_sp_holders_reward);
+    check_per_block_sp_payment_from_fund_budget();
 }
 
 SCORUM_TEST_CASE(per_block_sp_payment_from_fund_budget_if_no_active_voters_exist)
 {
-    generate_block();
+    check_per_block_sp_payment_from_fund_budget_if_no_active_voters_exist();
+}
 
-    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+SCORUM_TEST_CASE(per_block_sp_payment_division_from_fund_budget)
+{
+    check_per_block_sp_payment_division_from_fund_budget();
+}
 
-    auto& balancer = voters_reward_sp_service.get();
+SCORUM_TEST_CASE(per_block_payments_are_stopped_after_battary_restored)
+{
+    check_per_block_payments_are_stopped_after_battary_restored();
+}
 
-    BOOST_REQUIRE_EQUAL(balancer.balance, active_sp_holders_reward);
+SCORUM_TEST_CASE(payments_from_sp_balancer_arter_fund_budget_is_over)
+{
+    check_payments_from_sp_balancer_arter_fund_budget_is_over();
 }
 
-SCORUM_TEST_CASE(per_block_sp_payment_division_from_fund_budget)
+SCORUM_TEST_CASE(active_sp_holders_op_notifications_check)
 {
-    asset alice_sp_before = account_service.get_account(alice.name).scorumpower;
-    asset bob_sp_before = account_service.get_account(bob.name).scorumpower;
+    check_active_sp_holders_op_notifications();
+}
 
-    auto post = create_post(alice).push();
-    post.vote(bob).push();
-    post.vote(alice).in_block();
+SCORUM_TEST_CASE(second_cashout_if_no_vote_after_first_cashout_check)
+{
+    check_second_cashout_if_no_vote_after_first_cashout();
+}
 
-    auto initial_blocks = db.head_block_num();
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
-    auto pass_blocks = db.head_block_num() - initial_blocks;
+BOOST_AUTO_TEST_SUITE_END()
 
-    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
-    active_sp_holders_reward *= pass_blocks;
+// reward-per-share accumulator
+BOOST_FIXTURE_TEST_SUITE(active_sp_holders_reward_accumulator_tests, active_sp_holders_reward_hardfork_0_8_fixture)
 
-    auto alice_reward = active_sp_holders_reward * alice.sp_percent / 100;
-    auto bob_reward = active_sp_holders_reward - alice_reward;
+SCORUM_TEST_CASE(per_block_sp_payment_from_fund_budget)
+{
+    check_per_block_sp_payment_from_fund_budget();
+}
 
-    BOOST_REQUIRE_EQUAL(account_service.get_account(alice.name).scorumpower, alice_sp_before + alice_reward);
+SCORUM_TEST_CASE(per_block_sp_payment_from_fund_budget_if_no_active_voters_exist)
+{
+    check_per_block_sp_payment_from_fund_budget_if_no_active_voters_exist();
+}
 
-    BOOST_REQUIRE_EQUAL(account_service.get_account(bob.name).scorumpower, bob_sp_before + bob_reward);
+SCORUM_TEST_CASE(per_block_sp_payment_division_from_fund_budget)
+{
+    check_per_block_sp_payment_division_from_fund_budget();
 }
 
 SCORUM_TEST_CASE(per_block_payments_are_stopped_after_battary_restored)
 {
-    const auto& voter = account_service.get_account(bob.name);
-    asset bob_sp_before = voter.scorumpower;
+    check_per_block_payments_are_stopped_after_battary_restored();
+}
 
-    const auto vote_weight = SCORUM_PERCENT(100);
+SCORUM_TEST_CASE(payments_from_sp_balancer_arter_fund_budget_is_over)
+{
+    check_payments_from_sp_balancer_arter_fund_budget_is_over();
+}
 
-    uint16_t current_power = scorum::rewards_math::calculate_restoring_power(
-        voter.voting_power, dprops_service.head_block_time(), voter.last_vote_time, SCORUM_VOTE_REGENERATION_SECONDS);
+SCORUM_TEST_CASE(active_sp_holders_op_notifications_check)
+{
+    check_active_sp_holders_op_notifications();
+}
 
-    uint16_t used_power
-        = scorum::rewards_math::calculate_used_power(current_power, vote_weight, SCORUM_VOTING_POWER_DECAY_PERCENT);
+SCORUM_TEST_CASE(second_cashout_if_no_vote_after_first_cashout_check)
+{
+    check_second_cashout_if_no_vote_after_first_cashout();
+}
 
-    auto voting_power_restoring_time = scorum::rewards_math::calculate_expected_restoring_time(
-        current_power - used_power, dprops_service.head_block_time(), SCORUM_VOTE_REGENERATION_SECONDS);
+SCORUM_TEST_CASE(accrued_reward_is_settled_on_vote)
+{
+    BOOST_REQUIRE(is_accumulator_enabled());
 
-    auto post = create_post(alice).push();
-    post.vote(bob, vote_weight).in_block();
+    const auto& voter = account_service.get_account(bob.name);
 
-    auto initial_blocks = db.head_block_num();
-    generate_blocks(voting_power_restoring_time + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
-    auto pass_blocks = db.head_block_num() - initial_blocks;
+    auto post = create_post(alice).push();
+    post.vote(bob).in_block();
 
-    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+    generate_blocks(5);
 
-    BOOST_REQUIRE_EQUAL(voter.scorumpower, bob_sp_before + active_sp_holders_reward * pass_blocks);
+    // reward is accrued in the pool only
+    BOOST_CHECK_EQUAL(voter.active_sp_holders_pending_sp_reward, asset(0, SP_SYMBOL));
+    BOOST_CHECK_GT(dprops_service.get().active_sp_holders_reward.sp_pool, asset(0, SP_SYMBOL));
 
-    initial_blocks = db.head_block_num();
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
-    pass_blocks = db.head_block_num() - initial_blocks;
+    auto other_post = create_post(bob).push();
+    other_post.vote(bob).in_block();
 
-    BOOST_REQUIRE_EQUAL(voter.scorumpower, bob_sp_before + active_sp_holders_reward * pass_blocks);
+    // the block of the first vote and the blocks after it
+    const uint32_t accrued_blocks = 1 + 5;
 
-    auto& balancer = voters_reward_sp_service.get();
+    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
 
-    pass_blocks += 1; // in_block
+    check_reward(voter.active_sp_holders_pending_sp_reward, active_sp_holders_reward * accrued_blocks,
+                 accrued_blocks);
 
-    BOOST_REQUIRE_EQUAL(balancer.balance, active_sp_holders_reward * pass_blocks);
+    // the vote block reward is accrued with the new checkpoint
+    const auto& accumulator = dprops_service.get().active_sp_holders_reward;
+    BOOST_CHECK(voter.active_sp_holders_sp_reward_per_share < accumulator.sp_reward_per_share);
+    BOOST_CHECK_GT(voter.active_sp_holders_reward_weight.value, 0);
 }
 
-SCORUM_TEST_CASE(payments_from_sp_balancer_arter_fund_budget_is_over)
+SCORUM_TEST_CASE(accrued_reward_is_settled_when_voting_power_is_restored)
 {
-    const auto fund_budget_period_in_blocks = 2;
-
-    auto& fund_budget = budget_service.get();
-
-    budget_service.update(fund_budget, [&](fund_budget_object& b) {
-        b.per_block = b.balance / fund_budget_period_in_blocks;
-        b.deadline = dprops_service.head_block_time() + fund_budget_period_in_blocks * SCORUM_BLOCK_INTERVAL;
-    });
-
-    generate_blocks(fund_budget_period_in_blocks);
-
-    BOOST_REQUIRE(!budget_service.is_exists());
+    BOOST_REQUIRE(is_accumulator_enabled());
 
     const auto& voter = account_service.get_account(bob.name);
-    asset bob_sp_before = voter.scorumpower;
 
     auto post = create_post(alice).push();
     post.vote(bob).in_block();
 
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    const auto voting_power_restoring_time = voter.voting_power_restoring_time;
 
-    auto& balancer = voters_reward_sp_service.get();
+    // the block at voting power restoring time settles the account before the reward is accrued
+    uint32_t accrued_blocks = 1;
+    while (db.head_block_time() + SCORUM_BLOCK_INTERVAL < voting_power_restoring_time)
+    {
+        generate_block();
+        ++accrued_blocks;
+    }
+
+    BOOST_CHECK_EQUAL(voter.active_sp_holders_pending_sp_reward, asset(0, SP_SYMBOL));
 
-    BOOST_REQUIRE(balancer.current_per_block_reward.amount != 0);
+    generate_block();
 
-    BOOST_REQUIRE_GT(voter.scorumpower, bob_sp_before);
+    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
+
+    check_reward(voter.active_sp_holders_pending_sp_reward, active_sp_holders_reward * accrued_blocks,
+                 accrued_blocks);
+
+    BOOST_CHECK_EQUAL(voter.active_sp_holders_reward_weight.value, 0);
+    BOOST_CHECK_EQUAL(dprops_service.get().active_sp_holders_reward.total_weight.value, 0);
 }
 
-SCORUM_TEST_CASE(active_sp_holders_op_notifications_check)
+SCORUM_TEST_CASE(accrued_reward_is_settled_before_cashout)
 {
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    BOOST_REQUIRE(is_accumulator_enabled());
 
-    set_voter(bob);
-
-    auto post = create_post(alice).push();
-    post.vote(bob, SCORUM_PERCENT(30)).in_block();
+    const auto& voter = account_service.get_account(bob.name);
 
-    BOOST_CHECK_EQUAL(op_times(), 0);
+    auto start = db.head_block_time();
 
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    auto post = create_post(alice).push();
+    post.vote(bob).in_block();
 
-    BOOST_CHECK_EQUAL(op_times(), 1);
+    generate_blocks(start
+                    + fc::seconds(SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD.to_seconds() - SCORUM_BLOCK_INTERVAL * 2));
 
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    // Bob is in the pool at cashout time
+    auto other_post = create_post(bob).push();
+    other_post.vote(bob).in_block();
 
-    BOOST_CHECK_EQUAL(op_times(), 1);
+    asset settled_on_vote = voter.active_sp_holders_pending_sp_reward;
+    asset sp_before = voter.scorumpower;
 
-    post.vote(bob, SCORUM_PERCENT(90)).in_block();
+    generate_blocks(start + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
 
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    BOOST_REQUIRE_GT(voter.voting_power_restoring_time.to_iso_string(), db.head_block_time().to_iso_string());
+    BOOST_REQUIRE_GT(voter.active_sp_holders_reward_weight.value, 0);
 
-    BOOST_CHECK_EQUAL(op_times(), 2);
+    // reward accrued since the last vote is paid too
+    BOOST_CHECK_GT(voter.scorumpower - sp_before, settled_on_vote);
+    BOOST_CHECK_EQUAL(voter.active_sp_holders_pending_sp_reward, asset(0, SP_SYMBOL));
+    BOOST_CHECK(voter.active_sp_holders_sp_reward_per_share
+                == dprops_service.get().active_sp_holders_reward.sp_reward_per_share);
 }
 
-SCORUM_TEST_CASE(second_cashout_if_no_vote_after_first_cashout_check)
+SCORUM_TEST_CASE(rounding_remainder_is_returned_to_fund_when_pool_is_empty)
 {
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    BOOST_REQUIRE(is_accumulator_enabled());
 
-    set_voter(bob);
+    const auto& voter = account_service.get_account(bob.name);
 
-    auto start = db.head_block_time();
+    asset fund_before = voters_reward_sp_service.get().balance;
 
     auto post = create_post(alice).push();
-    post.vote(bob).in_block();
+    post.vote(bob, SCORUM_PERCENT(30)).in_block();
 
-    generate_blocks(start
-                    + fc::seconds(SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD.to_seconds() - SCORUM_BLOCK_INTERVAL * 2));
+    uint32_t blocks = 1;
+    while (dprops_service.get().active_sp_holders_reward.total_weight > 0)
+    {
+        generate_block();
+        ++blocks;
+    }
 
-    post = create_post(bob).push();
-    post.vote(bob).in_block();
+    const auto& accumulator = dprops_service.get().active_sp_holders_reward;
+    BOOST_CHECK_EQUAL(accumulator.sp_pool, asset(0, SP_SYMBOL));
+    BOOST_CHECK_EQUAL(accumulator.scr_pool, asset(0, SCORUM_SYMBOL));
 
-    BOOST_CHECK_EQUAL(op_times(), 0);
+    // nothing is lost: every reward is either settled to Bob or returned to the fund
+    auto active_sp_holders_reward = get_active_voters_reward(budget_service.get().per_block);
 
-    generate_blocks(start + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+    BOOST_CHECK_EQUAL(voter.active_sp_holders_pending_sp_reward + voters_reward_sp_service.get().balance - fund_before,
+                      active_sp_holders_reward * blocks);
 
-    const auto& bob_obj = account_service.get_account(bob.name);
-    BOOST_REQUIRE_GT(bob_obj.voting_power_restoring_time.to_iso_string(), db.head_block_time().to_iso_string());
-    BOOST_REQUIRE_LT(bob_obj.voting_power, SCORUM_100_PERCENT);
+    validate_database();
+}
 
-    BOOST_CHECK_NE(bob_obj.active_sp_holders_cashout_time.to_iso_string(),
-                   fc::time_point_sec::maximum().to_iso_string());
+BOOST_AUTO_TEST_SUITE_END()
 
-    BOOST_CHECK_EQUAL(op_times(), 1);
+BOOST_AUTO_TEST_SUITE(active_sp_holders_reward_modes_tests)
 
-    generate_blocks(db.head_block_time() + SCORUM_ACTIVE_SP_HOLDERS_REWARD_PERIOD);
+BOOST_AUTO_TEST_CASE(accumulator_pays_the_same_as_per_block_distribution)
+{
+    try
+    {
+        active_sp_holders_reward_fixture::voting_history_rewards legacy;
+        {
+            active_sp_holders_reward_hardfork_0_7_fixture fixture;
+            BOOST_REQUIRE(!fixture.is_accumulator_enabled());
 
-    BOOST_CHECK_EQUAL(bob_obj.active_sp_holders_cashout_time.to_iso_string(),
-                      fc::time_point_sec::maximum().to_iso_string());
+            legacy = fixture.reward_voting_history();
+        }
 
-    BOOST_CHECK_EQUAL(op_times(), 2);
+        active_sp_holders_reward_hardfork_0_8_fixture fixture;
+        BOOST_REQUIRE(fixture.is_accumulator_enabled());
+
+        auto accumulated = fixture.reward_voting_history();
+
+        BOOST_REQUIRE_EQUAL(accumulated.blocks, legacy.blocks);
+
+        BOOST_CHECK_GT(accumulated.alice, asset(0, SP_SYMBOL));
+        BOOST_CHECK_GT(accumulated.bob, asset(0, SP_SYMBOL));
+
+        // per block distribution rounds every block for every holder, accumulator on every settlement
+        const auto tolerance = asset(legacy.blocks + 2, SP_SYMBOL);
+
+        BOOST_CHECK_LE(accumulated.alice, legacy.alice + tolerance);
+        BOOST_CHECK_GE(accumulated.alice + tolerance, legacy.alice);
+        BOOST_CHECK_LE(accumulated.bob, legacy.bob + tolerance);
+        BOOST_CHECK_GE(accumulated.bob + tolerance, legacy.bob);
+    }
+    FC_LOG_AND_RETHROW()
 }
 
 BOOST_AUTO_TEST_SUITE_END()
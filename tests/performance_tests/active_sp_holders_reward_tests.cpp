@@ -0,0 +1,86 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/schema/account_objects.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
+
+#include "database_integration.hpp"
+
+#include "performance_common.hpp"
+
+namespace active_sp_holders_reward_tests {
+
+using namespace database_fixture;
+
+using performance_common::cpu_profiler;
+
+struct active_sp_holders_reward_perf_fixture : public database_integration_fixture
+{
+    active_sp_holders_reward_perf_fixture()
+    {
+        open_database();
+    }
+
+    virtual void open_database_impl(const genesis_state_type& genesis) override
+    {
+        database_integration_fixture::open_database_impl(genesis);
+
+        generate_block();
+        // legacy per block distribution
+        db.set_hardfork(SCORUM_HARDFORK_0_7);
+        generate_block();
+    }
+
+    void create_active_sp_holders(uint32_t holders_count)
+    {
+        auto restoring_time = db.head_block_time() + fc::days(1);
+
+        for (uint32_t i = 0; i < holders_count; i++)
+        {
+            db.create<account_object>([&](account_object& a) {
+                a.name = "holder" + boost::lexical_cast<std::string>(i);
+                a.voting_power_restoring_time = restoring_time;
+                a.vote_reward_competitive_sp = ASSET_SP(1000 + i);
+            });
+        }
+    }
+
+    size_t measure_blocks(uint32_t blocks_count)
+    {
+        cpu_profiler prof;
+
+        generate_blocks(blocks_count);
+
+        return prof.elapsed();
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(active_sp_holders_reward_performance_tests, active_sp_holders_reward_perf_fixture)
+
+SCORUM_TEST_CASE(accumulator_mode_is_faster_than_per_block_distribution)
+{
+    const uint32_t holders_count = 50'000;
+    const uint32_t blocks_count = 100;
+
+    create_active_sp_holders(holders_count);
+
+    BOOST_REQUIRE(!db.obtain_service<dbs_dynamic_global_property>().get().active_sp_holders_reward.enabled);
+
+    auto legacy_ms = measure_blocks(blocks_count);
+    BOOST_TEST_MESSAGE(blocks_count << " blocks with " << holders_count
+                                    << " active SP holders (per block distribution): " << legacy_ms << "ms");
+
+    set_hardfork(SCORUM_NUM_HARDFORKS);
+
+    BOOST_REQUIRE(db.obtain_service<dbs_dynamic_global_property>().get().active_sp_holders_reward.enabled);
+
+    auto accumulator_ms = measure_blocks(blocks_count);
+    BOOST_TEST_MESSAGE(blocks_count << " blocks with " << holders_count
+                                    << " active SP holders (accumulator): " << accumulator_ms << "ms");
+
+    BOOST_CHECK_LT(accumulator_ms, legacy_ms);
+
+    validate_database();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
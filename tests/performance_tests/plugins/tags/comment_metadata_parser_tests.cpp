@@ -0,0 +1,61 @@
+#include <boost/test/unit_test.hpp>
+
+#include "defines.hpp"
+
+#include <scorum/tags/comment_metadata_parser.hpp>
+
+#include "performance_common.hpp"
+
+namespace comment_metadata_parser_tests {
+
+using performance_common::cpu_profiler;
+using namespace scorum::tags;
+
+BOOST_AUTO_TEST_SUITE(comment_metadata_parser_tests)
+
+SCORUM_TEST_CASE(diff_with_full_parser_check)
+{
+    const size_t cycles = 100'000;
+
+    const std::string json_metadata
+        = R"({"app":"scorum/0.1","format":"markdown","image":["https://scorum.com/images/1.png",)"
+          R"("https://scorum.com/images/2.png"],"links":[],"users":["alice","bob"],)"
+          R"("description":"Match preview with the line-ups and the odds","rating":4.5,"draft":false,)"
+          R"("domains":["com"],"categories":["football"],"locales":["en"],)"
+          R"("tags":["football","premier-league","preview","odds","arsenal"]})";
+
+    size_t case1 = 0u;
+    {
+        cpu_profiler prof;
+
+        size_t tags_count = 0;
+        for (size_t ci = 0; ci < cycles; ++ci)
+        {
+            tags_count += comment_metadata::parse(json_metadata).tags.size();
+        }
+
+        case1 = prof.elapsed();
+        BOOST_TEST_MESSAGE("comment_metadata::parse: " << case1 << "ms");
+        BOOST_REQUIRE_EQUAL(tags_count, cycles * 5);
+    }
+
+    size_t case2 = 0u;
+    {
+        cpu_profiler prof;
+
+        size_t tags_count = 0;
+        for (size_t ci = 0; ci < cycles; ++ci)
+        {
+            tags_count += parse_comment_metadata(json_metadata).tags.size();
+        }
+
+        case2 = prof.elapsed();
+        BOOST_TEST_MESSAGE("parse_comment_metadata: " << case2 << "ms");
+        BOOST_REQUIRE_EQUAL(tags_count, cycles * 5);
+    }
+
+    BOOST_REQUIRE_LT(case2, case1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
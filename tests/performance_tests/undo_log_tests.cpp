@@ -0,0 +1,143 @@
+#include <boost/test/unit_test.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <fc/shared_string.hpp>
+
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include "defines.hpp"
+
+#include "performance_common.hpp"
+
+namespace undo_log_tests {
+
+using namespace boost::multi_index;
+
+struct undo_bench_object : public chainbase::object<0, undo_bench_object>
+{
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(undo_bench_object, (data))
+
+    id_type id;
+    int64_t value = 0;
+    fc::shared_string data;
+};
+
+struct by_value;
+
+typedef fc::shared_multi_index_container<
+    undo_bench_object,
+    indexed_by<ordered_unique<member<undo_bench_object, undo_bench_object::id_type, &undo_bench_object::id>>,
+               ordered_non_unique<tag<by_value>, member<undo_bench_object, int64_t, &undo_bench_object::value>>>>
+    undo_bench_index;
+}
+
+CHAINBASE_SET_INDEX_TYPE(undo_log_tests::undo_bench_object, undo_log_tests::undo_bench_index)
+
+namespace undo_log_tests {
+
+using performance_common::cpu_profiler;
+
+struct undo_log_fixture
+{
+    undo_log_fixture()
+        : dir(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+    {
+        db.open(dir, chainbase::database::read_write, 1024 * 1024 * 256);
+        db.add_index<undo_bench_index>();
+
+        for (int64_t i = 0; i < objects_count; ++i)
+        {
+            db.create<undo_bench_object>([&](undo_bench_object& o) {
+                o.value = i;
+                fc::from_string(o.data, std::string(128, 'x'));
+            });
+        }
+    }
+
+    ~undo_log_fixture()
+    {
+        db.close();
+        boost::filesystem::remove_all(dir);
+    }
+
+    // block session squashing transaction sessions, every transaction modifies the same objects several times
+    void apply_block(int64_t block_num)
+    {
+        auto block_session = db.start_undo_session();
+
+        for (int64_t trx = 0; trx < transactions_per_block; ++trx)
+        {
+            auto trx_session = db.start_undo_session();
+
+            for (int64_t i = 0; i < modifications_per_transaction; ++i)
+            {
+                auto id = (block_num * 7919 + trx * 104729 + i) % objects_count;
+                const auto& obj = db.get(undo_bench_object::id_type(id));
+
+                db.modify(obj, [&](undo_bench_object& o) { o.value += objects_count; });
+                db.modify(obj, [&](undo_bench_object& o) { o.value += objects_count; });
+            }
+
+            trx_session->push();
+            db.for_each_index([](chainbase::abstract_generic_index_i& index) { index.squash(); });
+        }
+
+        block_session->push();
+    }
+
+    int64_t revision()
+    {
+        int64_t result = 0;
+        db.for_each_index([&](chainbase::abstract_generic_index_i& index) { result = index.revision(); });
+        return result;
+    }
+
+    const int64_t objects_count = 50000;
+    const int64_t transactions_per_block = 100;
+    const int64_t modifications_per_transaction = 50;
+
+    boost::filesystem::path dir;
+    chainbase::database db;
+};
+
+BOOST_FIXTURE_TEST_SUITE(undo_log_tests, undo_log_fixture)
+
+SCORUM_TEST_CASE(modify_squash_and_commit_blocks)
+{
+    const int64_t blocks = 200;
+    const int64_t irreversible_distance = 20;
+
+    const size_t free_memory = db.get_free_memory();
+
+    cpu_profiler prof;
+
+    for (int64_t block_num = 1; block_num <= blocks; ++block_num)
+    {
+        apply_block(block_num);
+
+        auto irreversible = revision() - irreversible_distance;
+        db.for_each_index([&](chainbase::abstract_generic_index_i& index) { index.commit(irreversible); });
+    }
+
+    size_t applied = prof.elapsed();
+    size_t undo_memory = free_memory - db.get_free_memory();
+
+    BOOST_TEST_MESSAGE("apply " << blocks << " blocks: " << applied << "ms, undo log holds " << undo_memory
+                                << " bytes of shared memory for " << irreversible_distance << " blocks");
+
+    cpu_profiler undo_prof;
+    db.for_each_index([](chainbase::abstract_generic_index_i& index) { index.undo_all(); });
+    BOOST_TEST_MESSAGE("undo " << irreversible_distance << " blocks: " << undo_prof.elapsed() << "ms");
+
+    // memory taken by the undo log is returned (except the deques bookkeeping)
+    size_t retained = free_memory - std::min(free_memory, db.get_free_memory());
+    BOOST_CHECK_LT(retained, 64u * 1024u);
+
+    for (int64_t i = 0; i < objects_count; i += objects_count / 100)
+        BOOST_REQUIRE_EQUAL(db.get(undo_bench_object::id_type(i)).value % objects_count, i);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
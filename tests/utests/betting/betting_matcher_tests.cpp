@@ -424,4 +424,62 @@ SCORUM_TEST_CASE(by_game_uuid_wincase_asc_sorting_test)
     BOOST_CHECK(bets[1].data.uuid == boost::uuids::uuid({ { 2 } }));
     BOOST_CHECK(bets[2].data.uuid == boost::uuids::uuid({ { 3 } }));
 }
+
+SCORUM_TEST_CASE(by_game_uuid_wincase_odds_price_level_test)
+{
+    db_mock db;
+    db.add_index<pending_bet_index>();
+
+    dba::db_accessor<pending_bet_object> pending_dba(db);
+
+    boost::uuids::uuid game_uuid = { { 7 } };
+
+    auto wincase = total::over({ 1000 });
+
+    pending_dba.create([&](pending_bet_object& bet) { //
+        bet.data.uuid = { { 1 } };
+        bet.game_uuid = game_uuid;
+        bet.data.wincase = wincase;
+        bet.data.odds = odds(3, 2);
+        bet.data.created = fc::time_point_sec::from_iso_string("2018-11-25T12:00:00");
+    });
+
+    pending_dba.create([&](pending_bet_object& bet) { //
+        bet.data.uuid = { { 2 } };
+        bet.game_uuid = game_uuid;
+        bet.data.wincase = wincase;
+        bet.data.odds = odds(5, 2);
+        bet.data.created = fc::time_point_sec::from_iso_string("2018-11-25T12:01:00");
+    });
+
+    pending_dba.create([&](pending_bet_object& bet) { //
+        bet.data.uuid = { { 4 } };
+        bet.game_uuid = game_uuid;
+        bet.data.wincase = wincase;
+        bet.data.odds = odds(6, 4);
+        bet.data.created = fc::time_point_sec::from_iso_string("2018-11-25T12:03:00");
+    });
+
+    pending_dba.create([&](pending_bet_object& bet) { //
+        bet.data.uuid = { { 3 } };
+        bet.game_uuid = game_uuid;
+        bet.data.wincase = wincase;
+        bet.data.odds = odds(3, 2);
+        bet.data.created = fc::time_point_sec::from_iso_string("2018-11-25T12:02:00");
+    });
+
+    odds counter_odds = odds(3, 2).inverted();
+
+    auto key = std::make_tuple(game_uuid, wincase, counter_odds.simplified_key());
+
+    auto pending_bets = pending_dba.get_range_by<by_game_uuid_wincase_odds>(key);
+
+    std::vector<pending_bet_object> bets(pending_bets.begin(), pending_bets.end());
+
+    BOOST_REQUIRE_EQUAL(3u, bets.size());
+
+    BOOST_CHECK(bets[0].data.uuid == boost::uuids::uuid({ { 1 } }));
+    BOOST_CHECK(bets[1].data.uuid == boost::uuids::uuid({ { 3 } }));
+    BOOST_CHECK(bets[2].data.uuid == boost::uuids::uuid({ { 4 } }));
+}
 }
@@ -0,0 +1,91 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/tags/comment_metadata_parser.hpp>
+
+namespace comment_metadata_parser_tests {
+using namespace scorum::tags;
+
+struct comment_metadata_parser_fixture
+{
+    void check_same_as_full_parser(const std::string& json)
+    {
+        const comment_metadata expected = comment_metadata::parse(json);
+        const comment_metadata meta = parse_comment_metadata(json);
+
+        BOOST_CHECK_MESSAGE(meta.domains == expected.domains, json);
+        BOOST_CHECK_MESSAGE(meta.categories == expected.categories, json);
+        BOOST_CHECK_MESSAGE(meta.locales == expected.locales, json);
+        BOOST_CHECK_MESSAGE(meta.tags == expected.tags, json);
+    }
+
+    // clang-format off
+    const std::vector<std::string> corpus = {
+        R"()",
+        R"({})",
+        R"({"tags":[]})",
+        R"({"tags":["football","sport","Football"]})",
+        R"({"domains":["com"],"categories":["sport"],"locales":["en"],"tags":["football","sport"]})",
+        R"( { "tags" : [ "a" , "b" , "a" ] , "app" : "scorum/0.1" } )",
+        R"({"app":"scorum/0.1","format":"markdown","image":["https://x.io/1.png"],"tags":["x"],"version":1})",
+        R"({"links":[],"users":[],"meta":{"rating":4.5,"draft":false,"parent":null,"list":[1,-2,[3]]},"tags":["y"]})",
+        R"({"description":"line\nnext \"quoted\" \\ A","tags":["escaped","around"]})",
+        R"({"tags":["new\nline"]})",
+        R"({"tags":["unicode ф"]})",
+        R"({"tags":["футбол"]})",
+        R"({"tags":["футбол","спорт"],"locales":["ru"]})",
+        R"({"tags":[1,2]})",
+        R"({"tags":[true]})",
+        R"({"tags":[null]})",
+        R"({"tags":[["nested"]]})",
+        R"({"tags":"football"})",
+        R"({"tags":null})",
+        R"({"tags":{"a":"b"}})",
+        R"({"tags":["a"],"tags":["b"]})",
+        R"({"ta\gs":["a"]})",
+        R"({"rating":1e5,"tags":["exp"]})",
+        R"({"rating":-0.5,"tags":["neg"]})",
+        R"(["tags"])",
+        R"("tags")",
+        R"(42)",
+        R"(null)",
+        R"({"tags":["a"]} trailing)",
+        R"({"tags":["a"],})",
+        R"({"tags":["a",]})",
+        R"({"tags":["a"])",
+        R"({"tags":["a)",
+        R"({tags:["a"]})",
+        R"({"Tags":["case"]})",
+    };
+    // clang-format on
+};
+
+BOOST_FIXTURE_TEST_SUITE(comment_metadata_parser_tests, comment_metadata_parser_fixture)
+
+BOOST_AUTO_TEST_CASE(result_is_the_same_as_of_full_parser)
+{
+    for (const auto& json : corpus)
+        check_same_as_full_parser(json);
+}
+
+BOOST_AUTO_TEST_CASE(fields_are_extracted_skipping_the_rest)
+{
+    comment_metadata meta = parse_comment_metadata(
+        R"({"app":{"name":"x","v":[1,2]},"domains":["com"],"categories":["sport"],"tags":["b","a","b"]})");
+
+    BOOST_CHECK(meta.domains == std::set<std::string>({ "com" }));
+    BOOST_CHECK(meta.categories == std::set<std::string>({ "sport" }));
+    BOOST_CHECK(meta.locales.empty());
+    BOOST_CHECK(meta.tags == std::set<std::string>({ "a", "b" }));
+}
+
+BOOST_AUTO_TEST_CASE(too_long_metadata_is_ignored)
+{
+    std::string json = R"({"tags":["a"],"description":")";
+    json += std::string(TAG_JSON_METADATA_SIZE_MAX, 'x');
+    json += R"("})";
+
+    BOOST_CHECK(parse_comment_metadata(json).tags.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
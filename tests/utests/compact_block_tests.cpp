@@ -0,0 +1,119 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/compact_block.hpp>
+
+#include <map>
+
+namespace compact_block_tests {
+using namespace graphene::net;
+using scorum::protocol::transaction_id_type;
+
+struct compact_block_fixture
+{
+    compact_block_fixture()
+    {
+        for (uint16_t i = 1; i <= 4; ++i)
+        {
+            signed_transaction trx;
+            trx.ref_block_num = i;
+            trx.expiration = fc::time_point_sec(1000);
+            block.transactions.push_back(trx);
+        }
+        block.timestamp = fc::time_point_sec(900);
+        block.transaction_merkle_root = block.calculate_merkle_root();
+        block_id = block.id();
+    }
+
+    compact_block_reconstructor::transaction_lookup_type cache_of(const std::vector<size_t>& positions)
+    {
+        for (size_t pos : positions)
+            cache[get_short_transaction_id(block.transactions[pos].id())] = block.transactions[pos];
+
+        return [this](short_transaction_id_type short_id) {
+            fc::optional<signed_transaction> result;
+            auto it = cache.find(short_id);
+            if (it != cache.end())
+                result = it->second;
+            return result;
+        };
+    }
+
+    signed_block block;
+    block_id_type block_id;
+    std::map<short_transaction_id_type, signed_transaction> cache;
+};
+
+BOOST_FIXTURE_TEST_SUITE(compact_block_tests, compact_block_fixture)
+
+BOOST_AUTO_TEST_CASE(short_id_is_prefix_of_transaction_id)
+{
+    const transaction_id_type id = block.transactions[0].id();
+    const transaction_id_type lower_bound = get_transaction_id_lower_bound(get_short_transaction_id(id));
+
+    BOOST_CHECK_EQUAL(get_short_transaction_id(lower_bound), get_short_transaction_id(id));
+    BOOST_CHECK(!(id < lower_bound));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_keeps_header_and_order_of_transactions)
+{
+    compact_block_message compact = make_compact_block_message(block, block_id);
+
+    BOOST_CHECK(compact.block_id == block_id);
+    BOOST_CHECK(compact.header.id() == block_id);
+    BOOST_REQUIRE_EQUAL(compact.short_ids.size(), block.transactions.size());
+    for (size_t i = 0; i < block.transactions.size(); ++i)
+        BOOST_CHECK_EQUAL(compact.short_ids[i], get_short_transaction_id(block.transactions[i].id()));
+}
+
+BOOST_AUTO_TEST_CASE(block_is_restored_from_cache)
+{
+    compact_block_reconstructor reconstructor(make_compact_block_message(block, block_id));
+    reconstructor.fill(cache_of({ 0, 1, 2, 3 }));
+
+    BOOST_REQUIRE(reconstructor.is_complete());
+    BOOST_CHECK_EQUAL(reconstructor.get_cached_transactions_count(), 4u);
+
+    immutable_block_ptr restored = reconstructor.make_block();
+    BOOST_REQUIRE(restored);
+    BOOST_CHECK(restored->id() == block_id);
+    BOOST_CHECK(fc::raw::pack(static_cast<const signed_block&>(*restored)) == fc::raw::pack(block));
+}
+
+BOOST_AUTO_TEST_CASE(missing_transactions_are_added_in_order_of_indices)
+{
+    compact_block_reconstructor reconstructor(make_compact_block_message(block, block_id));
+    reconstructor.fill(cache_of({ 0, 2 }));
+
+    BOOST_CHECK(!reconstructor.is_complete());
+    BOOST_CHECK(reconstructor.get_missing_indices() == std::vector<uint32_t>({ 1, 3 }));
+    BOOST_CHECK_THROW(reconstructor.make_block(), fc::assert_exception);
+
+    BOOST_CHECK_THROW(reconstructor.add_missing_transactions({ block.transactions[1] }), fc::assert_exception);
+
+    reconstructor.add_missing_transactions({ block.transactions[1], block.transactions[3] });
+
+    BOOST_REQUIRE(reconstructor.is_complete());
+    immutable_block_ptr restored = reconstructor.make_block();
+    BOOST_REQUIRE(restored);
+    BOOST_CHECK(restored->id() == block_id);
+}
+
+BOOST_AUTO_TEST_CASE(wrong_transaction_is_detected_by_merkle_root)
+{
+    compact_block_reconstructor reconstructor(make_compact_block_message(block, block_id));
+    reconstructor.fill(cache_of({ 0, 1, 2 }));
+
+    signed_transaction other;
+    other.ref_block_num = 100;
+    reconstructor.add_missing_transactions({ other });
+
+    BOOST_CHECK(!reconstructor.make_block());
+
+    reconstructor.clear_transactions();
+
+    BOOST_CHECK_EQUAL(reconstructor.get_cached_transactions_count(), 0u);
+    BOOST_CHECK(reconstructor.get_missing_indices() == std::vector<uint32_t>({ 0, 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
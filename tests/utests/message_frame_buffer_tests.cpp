@@ -0,0 +1,114 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/message_frame_buffer.hpp>
+#include <graphene/net/config.hpp>
+
+#include <cstring>
+
+namespace message_frame_buffer_tests {
+using namespace graphene::net;
+
+struct message_frame_buffer_fixture
+{
+    message make_message(uint32_t msg_type, size_t size)
+    {
+        message m;
+        m.msg_type = msg_type;
+        m.data.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            m.data[i] = static_cast<char>(msg_type + i);
+        m.size = static_cast<uint32_t>(size);
+        return m;
+    }
+
+    void receive(message_frame_buffer& buffer, const char* data, size_t size)
+    {
+        memcpy(buffer.prepare(size), data, size);
+        buffer.commit(size);
+    }
+
+    void check_equal(const message& lhs, const message& rhs)
+    {
+        BOOST_CHECK_EQUAL(lhs.msg_type, rhs.msg_type);
+        BOOST_CHECK_EQUAL(lhs.size, rhs.size);
+        BOOST_CHECK(lhs.data == rhs.data);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(message_frame_buffer_tests, message_frame_buffer_fixture)
+
+BOOST_AUTO_TEST_CASE(frames_are_padded_to_multiple_of_16_bytes)
+{
+    BOOST_CHECK_EQUAL(get_message_frame_size(0), 16u);
+    BOOST_CHECK_EQUAL(get_message_frame_size(8), 16u);
+    BOOST_CHECK_EQUAL(get_message_frame_size(9), 32u);
+    BOOST_CHECK_EQUAL(get_message_frame_size(24), 32u);
+
+    std::vector<char> frames;
+    append_message_frame(frames, make_message(1, 3));
+    append_message_frame(frames, make_message(2, 20));
+
+    BOOST_CHECK_EQUAL(frames.size(), 48u);
+}
+
+BOOST_AUTO_TEST_CASE(all_messages_are_taken_from_one_read)
+{
+    const std::vector<message> messages = { make_message(1, 0), make_message(2, 8), make_message(3, 100) };
+
+    std::vector<char> frames;
+    for (const auto& m : messages)
+        append_message_frame(frames, m);
+
+    message_frame_buffer buffer(64);
+    receive(buffer, frames.data(), frames.size());
+
+    message m;
+    for (const auto& expected : messages)
+    {
+        BOOST_REQUIRE(buffer.pop_message(m));
+        check_equal(m, expected);
+    }
+    BOOST_CHECK(!buffer.pop_message(m));
+    BOOST_CHECK_EQUAL(buffer.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(message_is_taken_when_frame_is_received_completely)
+{
+    const message expected = make_message(5, 1000);
+
+    std::vector<char> frames;
+    append_message_frame(frames, expected);
+
+    message_frame_buffer buffer(64);
+    message m;
+
+    size_t offset = 0;
+    for (; offset + 48 < frames.size(); offset += 48)
+    {
+        receive(buffer, frames.data() + offset, 48);
+        BOOST_CHECK(!buffer.pop_message(m));
+    }
+    receive(buffer, frames.data() + offset, frames.size() - offset);
+
+    BOOST_REQUIRE(buffer.pop_message(m));
+    check_equal(m, expected);
+}
+
+BOOST_AUTO_TEST_CASE(too_large_message_is_rejected_by_header)
+{
+    message_header header;
+    header.size = MAX_MESSAGE_SIZE + 1;
+    header.msg_type = 1;
+
+    char frame[16] = {};
+    memcpy(frame, (const char*)&header, sizeof(header));
+
+    message_frame_buffer buffer(64);
+    receive(buffer, frame, sizeof(frame));
+
+    message m;
+    BOOST_CHECK_THROW(buffer.pop_message(m), fc::assert_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,113 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/database/pending_transactions_pool.hpp>
+
+namespace pending_transactions_pool_tests {
+using namespace scorum::chain;
+
+struct pending_transactions_pool_fixture
+{
+    const fc::time_point_sec now = fc::time_point_sec(1000);
+
+    signed_transaction make_trx(uint32_t expiration_sec, uint16_t ref_block_num)
+    {
+        signed_transaction trx;
+        trx.expiration = now + expiration_sec;
+        trx.ref_block_num = ref_block_num;
+        return trx;
+    }
+
+    std::vector<uint16_t> ref_block_nums(const std::vector<signed_transaction>& transactions)
+    {
+        std::vector<uint16_t> result;
+        for (const auto& trx : transactions)
+            result.push_back(trx.ref_block_num);
+        return result;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(pending_transactions_pool_tests, pending_transactions_pool_fixture)
+
+BOOST_AUTO_TEST_CASE(release_keeps_order_of_arrival_by_default)
+{
+    pending_transactions_pool pool;
+
+    pool.push(make_trx(30, 1), 300);
+    pool.push(make_trx(10, 2), 100);
+    pool.push(make_trx(20, 3), 200);
+
+    BOOST_CHECK(ref_block_nums(pool.release()) == std::vector<uint16_t>({ 1, 2, 3 }));
+    BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(release_orders_by_expiration)
+{
+    pending_transactions_pool pool(pending_transactions_pool::by_expiration);
+
+    pool.push(make_trx(30, 1), 100);
+    pool.push(make_trx(10, 2), 100);
+    pool.push(make_trx(30, 3), 100);
+    pool.push(make_trx(20, 4), 100);
+
+    BOOST_CHECK(ref_block_nums(pool.release()) == std::vector<uint16_t>({ 2, 4, 1, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(release_orders_by_size)
+{
+    pending_transactions_pool pool;
+    pool.set_priority(pending_transactions_pool::by_size);
+
+    pool.push(make_trx(10, 1), 300);
+    pool.push(make_trx(10, 2), 100);
+    pool.push(make_trx(10, 3), 200);
+    pool.push(make_trx(10, 4), 100);
+
+    BOOST_CHECK(ref_block_nums(pool.release()) == std::vector<uint16_t>({ 2, 4, 3, 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(prefix_stops_at_first_transaction_that_does_not_fit)
+{
+    pending_transactions_pool pool;
+
+    pool.push(make_trx(10, 1), 100);
+    pool.push(make_trx(10, 2), 100);
+    pool.push(make_trx(10, 3), 500);
+    pool.push(make_trx(10, 4), 10);
+
+    BOOST_CHECK_EQUAL(pool.get_prefix_size(50, 1000), 4u);
+    BOOST_CHECK_EQUAL(pool.get_prefix_size(50, 700), 2u);
+    BOOST_CHECK_EQUAL(pool.get_prefix_size(50, 150), 0u);
+    BOOST_CHECK_EQUAL(pool.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(remove_expired_keeps_order_of_rest)
+{
+    pending_transactions_pool pool;
+
+    pool.push(make_trx(10, 1), 100);
+    pool.push(make_trx(30, 2), 100);
+    pool.push(make_trx(5, 3), 100);
+    pool.push(make_trx(20, 4), 100);
+
+    BOOST_CHECK_EQUAL(pool.remove_expired(now + 15), 2u);
+
+    BOOST_REQUIRE_EQUAL(pool.size(), 2u);
+    BOOST_CHECK_EQUAL(pool.entries()[0].trx.ref_block_num, 2u);
+    BOOST_CHECK_EQUAL(pool.entries()[1].trx.ref_block_num, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_expiring_at_block_time_is_removed)
+{
+    pending_transactions_pool pool;
+
+    pool.push(make_trx(15, 1), 100);
+    pool.push(make_trx(16, 2), 100);
+
+    BOOST_CHECK_EQUAL(pool.remove_expired(now + 15), 1u);
+
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+    BOOST_CHECK_EQUAL(pool.entries()[0].trx.ref_block_num, 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -27,6 +27,7 @@
 #include <scorum/protocol/version.hpp>
 
 #include <scorum/protocol/transaction.hpp>
+#include <scorum/protocol/block.hpp>
 
 #include <boost/uuid/uuid_generators.hpp>
 #include <fc/io/json.hpp>
@@ -227,4 +228,30 @@ SCORUM_TEST_CASE(hardfork_version_test)
     SCORUM_REQUIRE_THROW(fc::from_variant(ver_str, ver), fc::exception);
 }
 
+SCORUM_TEST_CASE(immutable_block_is_serialized_as_signed_block)
+{
+    using scorum::protocol::immutable_block_ptr;
+    using scorum::protocol::signed_block;
+
+    signed_block b;
+    b.timestamp = fc::time_point_sec(1000);
+    b.witness = "alice";
+    b.transactions.resize(2);
+    b.transactions[1].ref_block_num = 10;
+
+    immutable_block_ptr ib = scorum::protocol::make_immutable_block(b);
+
+    BOOST_CHECK(ib->id() == b.id());
+    BOOST_CHECK_EQUAL(ib->packed_size(), fc::raw::pack_size(b));
+    BOOST_CHECK(fc::raw::pack(ib) == fc::raw::pack(b));
+
+    immutable_block_ptr unpacked;
+    fc::raw::unpack(fc::raw::pack(b), unpacked);
+
+    BOOST_REQUIRE(unpacked);
+    BOOST_CHECK(unpacked->id() == b.id());
+    BOOST_CHECK_EQUAL(unpacked->transactions.size(), 2u);
+    BOOST_CHECK_EQUAL(unpacked->transactions[1].ref_block_num, 10u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/protocol/signature_keys_cache.hpp>
+#include <scorum/protocol/transaction.hpp>
+#include <scorum/protocol/scorum_operations.hpp>
+
+#include "defines.hpp"
+
+namespace signature_keys_cache_tests {
+using namespace scorum::protocol;
+
+struct signature_keys_cache_fixture
+{
+    fc::ecc::private_key alice_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string("alice")));
+    fc::ecc::private_key bob_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string("bob")));
+    chain_id_type chain_id = fc::sha256::hash(std::string("chain"));
+};
+
+BOOST_FIXTURE_TEST_SUITE(signature_keys_cache_tests, signature_keys_cache_fixture)
+
+BOOST_AUTO_TEST_CASE(get_key_recovers_signer_key)
+{
+    signature_keys_cache cache;
+
+    const auto digest = fc::sha256::hash(std::string("message"));
+    const auto sig = alice_key.sign_compact(digest);
+
+    BOOST_CHECK(!cache.contains(sig, digest));
+    BOOST_CHECK(cache.get_key(sig, digest) == public_key_type(alice_key.get_public_key()));
+    BOOST_CHECK(cache.contains(sig, digest));
+    BOOST_CHECK(cache.get_key(sig, digest) == public_key_type(alice_key.get_public_key()));
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(oldest_keys_are_evicted)
+{
+    signature_keys_cache cache(2);
+
+    const auto digest1 = fc::sha256::hash(std::string("1"));
+    const auto digest2 = fc::sha256::hash(std::string("2"));
+    const auto digest3 = fc::sha256::hash(std::string("3"));
+
+    cache.get_key(alice_key.sign_compact(digest1), digest1);
+    cache.get_key(alice_key.sign_compact(digest2), digest2);
+    cache.get_key(alice_key.sign_compact(digest3), digest3);
+
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+    BOOST_CHECK(!cache.contains(alice_key.sign_compact(digest1), digest1));
+    BOOST_CHECK(cache.contains(alice_key.sign_compact(digest3), digest3));
+}
+
+BOOST_AUTO_TEST_CASE(cached_transaction_keys_are_same_as_recovered)
+{
+    signed_transaction trx;
+    transfer_operation op;
+    op.from = "alice";
+    op.to = "bob";
+    op.amount = ASSET_SCR(1);
+    trx.operations.push_back(op);
+    trx.sign(alice_key, chain_id);
+    trx.sign(bob_key, chain_id);
+
+    signature_keys_cache cache;
+
+    BOOST_CHECK(trx.get_signature_keys(chain_id, cache) == trx.get_signature_keys(chain_id));
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+    BOOST_CHECK(trx.get_signature_keys(chain_id, cache) == trx.get_signature_keys(chain_id));
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_signature_is_detected_with_cache)
+{
+    signed_transaction trx;
+    trx.operations.push_back(transfer_operation());
+    trx.sign(alice_key, chain_id);
+    trx.signatures.push_back(trx.signatures.front());
+
+    signature_keys_cache cache;
+
+    BOOST_CHECK_THROW(trx.get_signature_keys(chain_id, cache), fc::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,117 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/sync_stripes.hpp>
+
+#include <set>
+
+namespace sync_stripes_tests {
+using namespace graphene::net;
+
+using item_ids_type = boost::container::deque<item_hash_t>;
+
+item_hash_t make_item(uint32_t num)
+{
+    item_hash_t item;
+    item._hash[0] = num;
+    return item;
+}
+
+item_ids_type make_items(uint32_t first, uint32_t count)
+{
+    item_ids_type items;
+    for (uint32_t num = first; num < first + count; ++num)
+        items.push_back(make_item(num));
+    return items;
+}
+
+std::vector<item_hash_t> items_range(uint32_t first, uint32_t count)
+{
+    auto items = make_items(first, count);
+    return std::vector<item_hash_t>(items.begin(), items.end());
+}
+
+bool all_needed(const item_hash_t&)
+{
+    return true;
+}
+
+BOOST_AUTO_TEST_SUITE(sync_stripes_tests)
+
+BOOST_AUTO_TEST_CASE(stripes_are_assigned_to_peers_round_robin)
+{
+    const auto ids = make_items(0, 60);
+
+    auto requests = assign_sync_stripes({ { ids, ids.size(), 100 }, { ids, ids.size(), 100 } }, 20, all_needed);
+
+    BOOST_REQUIRE_EQUAL(requests.size(), 2u);
+
+    std::vector<item_hash_t> first_peer_items = items_range(0, 20);
+    const auto third_stripe = items_range(40, 20);
+    first_peer_items.insert(first_peer_items.end(), third_stripe.begin(), third_stripe.end());
+
+    BOOST_CHECK(requests[0] == first_peer_items);
+    BOOST_CHECK(requests[1] == items_range(20, 20));
+}
+
+BOOST_AUTO_TEST_CASE(item_is_assigned_to_one_peer_only)
+{
+    const auto first_ids = make_items(0, 30);
+    const auto second_ids = make_items(10, 30);
+
+    auto requests
+        = assign_sync_stripes({ { first_ids, first_ids.size(), 100 }, { second_ids, second_ids.size(), 100 } }, 10,
+                              all_needed);
+
+    BOOST_REQUIRE_EQUAL(requests.size(), 2u);
+
+    std::set<item_hash_t> assigned;
+    for (const auto& peer_requests : requests)
+    {
+        for (const auto& item : peer_requests)
+            BOOST_CHECK(assigned.insert(item).second);
+    }
+    BOOST_CHECK_EQUAL(assigned.size(), 40u);
+}
+
+BOOST_AUTO_TEST_CASE(capacity_of_peer_is_not_exceeded)
+{
+    const auto ids = make_items(0, 50);
+
+    auto requests = assign_sync_stripes({ { ids, ids.size(), 5 }, { ids, ids.size(), 100 } }, 20, all_needed);
+
+    BOOST_REQUIRE_EQUAL(requests.size(), 2u);
+    BOOST_CHECK(requests[0] == items_range(0, 5));
+    BOOST_CHECK(requests[1] == items_range(5, 45));
+}
+
+BOOST_AUTO_TEST_CASE(items_after_end_index_are_not_assigned)
+{
+    const auto ids = make_items(0, 50);
+
+    auto requests = assign_sync_stripes({ { ids, 15, 100 } }, 20, all_needed);
+
+    BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+    BOOST_CHECK(requests[0] == items_range(0, 15));
+}
+
+BOOST_AUTO_TEST_CASE(not_needed_items_are_skipped_without_taking_stripe)
+{
+    const auto ids = make_items(0, 10);
+    const std::set<item_hash_t> received{ make_item(1), make_item(2) };
+
+    auto requests = assign_sync_stripes({ { ids, ids.size(), 100 }, { ids, ids.size(), 100 } }, 3,
+                                        [&](const item_hash_t& item) { return received.count(item) == 0; });
+
+    BOOST_REQUIRE_EQUAL(requests.size(), 2u);
+    BOOST_CHECK(requests[0] == std::vector<item_hash_t>({ make_item(0), make_item(3), make_item(4), make_item(8),
+                                                          make_item(9) }));
+    BOOST_CHECK(requests[1] == items_range(5, 3));
+}
+
+BOOST_AUTO_TEST_CASE(nothing_is_assigned_without_peers)
+{
+    BOOST_CHECK(assign_sync_stripes({}, 20, all_needed).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,71 @@
+#include <boost/test/unit_test.hpp>
+#include <scorum/utils/bounded_queue.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace scorum;
+
+BOOST_AUTO_TEST_SUITE(bounded_queue_tests)
+
+BOOST_AUTO_TEST_CASE(pop_returns_items_in_push_order)
+{
+    utils::bounded_queue<int> queue(3);
+
+    BOOST_REQUIRE(queue.push(1));
+    BOOST_REQUIRE(queue.push(2));
+    BOOST_REQUIRE(queue.push(3));
+    BOOST_CHECK_EQUAL(queue.size(), 3u);
+
+    int item = 0;
+    BOOST_REQUIRE(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, 1);
+    BOOST_REQUIRE(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, 2);
+    BOOST_REQUIRE(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, 3);
+}
+
+BOOST_AUTO_TEST_CASE(closed_queue_returns_remaining_items_and_rejects_new_ones)
+{
+    utils::bounded_queue<int> queue(2);
+
+    queue.push(1);
+    queue.close();
+
+    BOOST_CHECK(!queue.push(2));
+
+    int item = 0;
+    BOOST_REQUIRE(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, 1);
+    BOOST_CHECK(!queue.pop(item));
+}
+
+BOOST_AUTO_TEST_CASE(producer_waits_for_consumer_when_queue_is_full)
+{
+    utils::bounded_queue<int> queue(1);
+
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i)
+            queue.push(i);
+        queue.close();
+    });
+
+    std::vector<int> items;
+    int item = 0;
+    while (queue.pop(item))
+    {
+        BOOST_CHECK_LE(queue.size(), queue.capacity());
+        items.push_back(item);
+    }
+
+    producer.join();
+
+    BOOST_REQUIRE_EQUAL(items.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        BOOST_CHECK_EQUAL(items[i], i);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
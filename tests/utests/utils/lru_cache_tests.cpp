@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+#include <scorum/utils/lru_cache.hpp>
+
+#include <string>
+
+namespace {
+using namespace scorum;
+
+BOOST_AUTO_TEST_SUITE(lru_cache_tests)
+
+BOOST_AUTO_TEST_CASE(least_recently_used_item_is_evicted)
+{
+    utils::lru_cache<int, std::string> cache(2);
+
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+
+    BOOST_REQUIRE(cache.find(1));
+
+    cache.insert(3, "three");
+
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+    BOOST_CHECK(!cache.find(2));
+    BOOST_REQUIRE(cache.find(1));
+    BOOST_CHECK_EQUAL(*cache.find(1), "one");
+    BOOST_REQUIRE(cache.find(3));
+    BOOST_CHECK_EQUAL(*cache.find(3), "three");
+}
+
+BOOST_AUTO_TEST_CASE(insert_of_cached_key_replaces_value)
+{
+    utils::lru_cache<int, std::string> cache(2);
+
+    cache.insert(1, "one");
+    cache.insert(1, "uno");
+
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE(cache.find(1));
+    BOOST_CHECK_EQUAL(*cache.find(1), "uno");
+}
+
+BOOST_AUTO_TEST_CASE(capacity_reduction_evicts_oldest_items)
+{
+    utils::lru_cache<int, int> cache(3);
+
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+
+    cache.set_capacity(1);
+
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    BOOST_CHECK(cache.find(3));
+
+    cache.set_capacity(0);
+    cache.insert(4, 4);
+
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}